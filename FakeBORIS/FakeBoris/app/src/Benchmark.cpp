@@ -0,0 +1,183 @@
+#include <inc\LoopBenchmark.h>
+#include <inc\BorisEmulator.h>
+#include <inc\SerialTransport.h>
+#include <inc\PtyTransport.h>
+#include <inc\LoopbackTransport.h>
+#include <inc\LoopbackPeerTransport.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <boost\lexical_cast.hpp>
+
+/**
+ * @brief Megjelenti a program hasznlatt bemutat zenetet.
+ *
+ * @param program_name A program neve, ahogy az a parancssorban szerepelt.
+ */
+void printUsage(const char* program_name) {
+	std::cout << "Hasznlat: " << program_name << " [opcik]" << std::endl;
+	std::cout << "Opcik:" << std::endl;
+	std::cout << "  --transport=<loopback|pty|all> A mrt tvitel: folyamaton belli hurok, pszeudoterminl vagy mindkett" << std::endl;
+	std::cout << "                                 (alaprtelmezs: all)." << std::endl;
+	std::cout << "  --baud=<lista>                 A szimullt vonal adattviteli sebessgei, 0 esetn nincs szimulci" << std::endl;
+	std::cout << "                                 (alaprtelmezs: 9600,115200,0)." << std::endl;
+	std::cout << "  --period=<lista>               A lekrdezs peridusai mikroszekundumban, 0 esetn a lekrdezsek a vlaszokat" << std::endl;
+	std::cout << "                                 azonnal kvetik (alaprtelmezs: 0,1000)." << std::endl;
+	std::cout << "  --pipeline=<lista>             Az egyszerre vlaszra vr lekrdezsek legnagyobb szmai (alaprtelmezs: 1,4)." << std::endl;
+	std::cout << "  --duration=<ms>                Egy mrs hossza (alaprtelmezs: 2000)." << std::endl;
+	std::cout << "  --timeout=<ms>                 A vlaszra vr lekrdezsek lejrati ideje (alaprtelmezs: 100)." << std::endl;
+	std::cout << "  --latency=<us>                 Az emullt eszkz vlaszainak ksleltetse (alaprtelmezs: 0)." << std::endl;
+	std::cout << "A listk vesszvel elvlasztott rtkek, a mrs minden kombincijukra lefut." << std::endl;
+}
+
+/**
+ * @brief Felbontja a vesszvel elvlasztott szmok listjt.
+ *
+ * @param list A lista.
+ * @return A lista elemei.
+ */
+std::vector<unsigned int> parseList(const std::string& list) {
+	std::vector<unsigned int> values;
+	std::istringstream items(list);
+	std::string item;
+	while(std::getline(items, item, ','))
+		values.push_back(boost::lexical_cast<unsigned int>(item));
+	return values;
+}
+
+/**
+ * @brief Mikroszekundumban, egy tizedesjegyre kerektve megjelent egy idtartamot.
+ *
+ * @param duration Az idtartam.
+ * @return A megjelenthet szveg.
+ */
+std::string formatMicroseconds(std::chrono::nanoseconds duration) {
+	std::ostringstream text;
+	text << std::fixed << std::setprecision(1) << duration.count() / 1000.0;
+	return text.str();
+}
+
+/**
+ * @brief A program belpsi pontja.
+ *
+ * @param argc A parancssori argumentumok szma.
+ * @param argv A parancssori argumentumok tmbje.
+ * @return Megfelel lefuts esetn nulla.
+ */
+int main(int argc, char** argv) {
+#ifdef _WIN32
+	/* A konzol karakterkdolsnak megvltoztatsa az kezetes magyar karakterek megfelel kijelzse rdekben. */
+	SetConsoleOutputCP(1252);
+	std::cout << "A mrs pszeudoterminlt s folyamaton belli hurkot hasznl, ezrt csak POSIX rendszereken rhet el." << std::endl;
+	return 0;
+#else
+	/* A parancssori argumentumok beolvassa s rtelmezse. */
+	std::vector<std::string> transports;
+	std::vector<unsigned int> baudRates = parseList("9600,115200,0"), periods = parseList("0,1000"), depths = parseList("1,4");
+	unsigned int duration = 2000, requestTimeout = 100, latency = 0;
+	std::string transportName = "all";
+	for(int i = 1; i < argc; i++) {
+		std::string arg(argv[i]);
+		if(arg == "--transport=loopback" || arg == "--transport=pty" || arg == "--transport=all") {
+			transportName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--baud=") != std::string::npos) {
+			baudRates = parseList(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--period=") != std::string::npos) {
+			periods = parseList(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--pipeline=") != std::string::npos) {
+			depths = parseList(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--duration=") != std::string::npos) {
+			duration = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--timeout=") != std::string::npos) {
+			requestTimeout = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--latency=") != std::string::npos) {
+			latency = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else {
+			printUsage(argv[0]);
+			return 0;
+		}
+	}
+	if(transportName != "pty")
+		transports.push_back("loopback");
+	if(transportName != "loopback")
+		transports.push_back("pty");
+
+	/* A tblzat fejlcnek megjelentse. */
+	std::cout << std::left << std::setw(10) << "tvitel" << std::right << std::setw(9) << "baud" << std::setw(10) << "peridus";
+	std::cout << std::setw(6) << "mly." << std::setw(11) << "tranz./s" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us";
+	std::cout << std::setw(10) << "p999 us" << std::setw(11) << "CPU/tr us" << std::setw(8) << "lejrt" << std::endl;
+
+	/* A mrs lefuttatsa a paramterek minden kombincijra. Minden mrshez j kapcsolat s j emultor tartozik, hogy a mrsek
+	ne befolysoljk egymst. */
+	for(const std::string& name : transports) {
+		for(unsigned int baudRate : baudRates) {
+			for(unsigned int period : periods) {
+				for(unsigned int depth : depths) {
+					LoopBenchmark::Result result;
+					try {
+						/* Hurok esetn a mrs nyitja meg a hurkot s az emultor csatlakozik a msik vgre. Pszeudoterminl esetn
+						az emultor hozza ltre a pszeudoterminlt, a mrs pedig soros portknt nyitja meg a szolga oldalt. Ekkor a
+						port adattviteli sebessge nvleges, a vonalat az emultor szimullja. Zrt hurk mrs esetn a peridus csak
+						a lejrt lekrdezsek ptlst idzti. */
+						std::unique_ptr<BorisEmulator> emulator;
+						std::unique_ptr<LoopBenchmark> benchmark;
+						auto openBenchmark = [&](AbstractTransport* transport) {
+							benchmark.reset(new LoopBenchmark(std::unique_ptr<AbstractTransport>(transport)));
+							benchmark->setClosedLoop(period == 0);
+							benchmark->setPollPeriod(period > 0 ? std::chrono::nanoseconds(std::chrono::microseconds(period)) :
+								std::chrono::nanoseconds(std::chrono::milliseconds(requestTimeout)));
+							benchmark->setPipelineDepth(depth);
+							benchmark->setRequestTimeout(std::chrono::milliseconds(requestTimeout));
+							return benchmark->open();
+						};
+						if(name == "loopback") {
+							LoopbackTransport* loopback = new LoopbackTransport();
+							if(!openBenchmark(loopback))
+								continue;
+							emulator.reset(new BorisEmulator(std::unique_ptr<AbstractTransport>(new LoopbackPeerTransport(*loopback))));
+						}
+						else
+							emulator.reset(new BorisEmulator(std::unique_ptr<AbstractTransport>(new PtyTransport())));
+						emulator->setLineRate(baudRate);
+						emulator->setLatency(std::chrono::microseconds(latency), std::chrono::nanoseconds::zero());
+						emulator->start();
+						if(name == "pty" && !openBenchmark(new SerialTransport(emulator->describe(), 115200)))
+							continue;
+
+						result = benchmark->run(std::chrono::milliseconds(duration));
+						emulator->stop();
+					}
+					catch(boost::system::system_error& e) {
+						std::cout << "A mrs kzben hiba lpett fel: " << e.what() << std::endl;
+						continue;
+					}
+
+					/* Az eredmny megjelentse egy tblzatsorban. */
+					std::cout << std::left << std::setw(10) << name << std::right << std::setw(9);
+					std::cout << (baudRate > 0 ? boost::lexical_cast<std::string>(baudRate) : "-") << std::setw(10);
+					std::cout << (period > 0 ? boost::lexical_cast<std::string>(period) + " us" : "-") << std::setw(6) << depth;
+					std::cout << std::setw(11) << static_cast<unsigned long long int>(result.throughput);
+					std::cout << std::setw(10) << formatMicroseconds(result.p50) << std::setw(10) << formatMicroseconds(result.p99);
+					std::cout << std::setw(10) << formatMicroseconds(result.p999) << std::setw(11);
+					std::cout << formatMicroseconds(result.cpuPerTransaction) << std::setw(8) << result.timeouts << std::endl;
+				}
+			}
+		}
+	}
+	return 0;
+#endif
+}
@@ -0,0 +1,210 @@
+#include <inc\BorisEmulator.h>
+#include <inc\SerialTransport.h>
+#include <inc\PtyTransport.h>
+#include <inc\ConsoleRenderer.h>
+#include <inc\AnsiConsole.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <boost\lexical_cast.hpp>
+
+/**
+ * @brief Megjelenti a program hasznlatt bemutat zenetet.
+ *
+ * @param program_name A program neve, ahogy az a parancssorban szerepelt.
+ */
+void printUsage(const char* program_name) {
+	std::cout << "Hasznlat: " << program_name << " [opcik]" << std::endl;
+	std::cout << "Opcik:" << std::endl;
+	std::cout << "  --transport=<pty|serial>     Az eszkz elrse pszeudoterminlon vagy soros porton (alaprtelmezs: pty POSIX" << std::endl;
+	std::cout << "                               rendszereken, klnben serial)." << std::endl;
+	std::cout << "  --port=<port neve>           A soros port neve soros port hasznlatakor." << std::endl;
+	std::cout << "  --baud=<sebessg>            A soros port adattviteli sebessge (alaprtelmezs: 9600)." << std::endl;
+	std::cout << "  --latency=<us>               A lekrdezsek megvlaszolsnak ksleltetse (alaprtelmezs: 0)." << std::endl;
+	std::cout << "  --jitter=<us>                A ksleltetshez adott vletlen tbblet legnagyobb rtke (alaprtelmezs: 0)." << std::endl;
+	std::cout << "  --fragment=<bjt>            A vlaszok darabolsa a megadott mret darabokra (alaprtelmezs: 0, nincs)." << std::endl;
+	std::cout << "  --fragment-gap=<us>          A vlaszdarabok kztti sznet (alaprtelmezs: 0)." << std::endl;
+	std::cout << "  --input=<hex>                Az lland 16-bites bemeneti llapot (alaprtelmezs: 0000)." << std::endl;
+	std::cout << "  --script=<fjl>              Ismtld bemeneti jelalak. Minden sora egy <ms> <hex> pr, amely a bemenetek" << std::endl;
+	std::cout << "                               llapott s annak idtartamt adja meg; a # utni rsz megjegyzs." << std::endl;
+	std::cout << "  --display                    A kimenetek llapotnak folyamatos kijelzse ANSI terminlon, soronknti kirs" << std::endl;
+	std::cout << "                               helyett." << std::endl;
+}
+
+/**
+ * @brief Beolvassa a bemeneti jelalakot a megadott fjlbl. Hibs sor esetn boost::bad_lexical_cast kivtelt dob.
+ *
+ * @param file_name A jelalakot tartalmaz fjl neve.
+ * @return A jelalak szakaszai, vagy res vektor, ha a fjl nem nyithat meg.
+ */
+std::vector<BorisEmulator::InputStep> readInputScript(const std::string& file_name) {
+	std::vector<BorisEmulator::InputStep> script;
+	std::ifstream file(file_name);
+	std::string line;
+	while(std::getline(file, line)) {
+		/* A megjegyzsek s az res sorok kihagysa. */
+		line = line.substr(0, line.find('#'));
+		std::istringstream fields(line);
+		std::string duration, value;
+		if(!(fields >> duration >> value))
+			continue;
+
+		BorisEmulator::InputStep step;
+		step.duration = std::chrono::milliseconds(boost::lexical_cast<unsigned int>(duration));
+		step.value = static_cast<std::uint16_t>(std::stoul(value, nullptr, 16));
+		script.push_back(step);
+	}
+	return script;
+}
+
+/**
+ * @brief A program belpsi pontja.
+ *
+ * @param argc A parancssori argumentumok szma.
+ * @param argv A parancssori argumentumok tmbje.
+ * @return Megfelel lefuts esetn nulla.
+ */
+int main(int argc, char** argv) {
+#ifdef _WIN32
+	/* A konzol karakterkdolsnak megvltoztatsa az kezetes magyar karakterek megfelel kijelzse rdekben. */
+	SetConsoleOutputCP(1252);
+	std::string transportName = "serial";
+#else
+	std::string transportName = "pty";
+#endif
+
+	/* A parancssori argumentumok beolvassa s rtelmezse. */
+	std::string device, scriptName;
+	bool display = false;
+	unsigned int baudRate = 9600, latency = 0, jitter = 0, fragmentSize = 0, fragmentGap = 0;
+	std::uint16_t input = 0;
+	for(int i = 1; i < argc; i++) {
+		std::string arg(argv[i]);
+		if(arg == "--transport=pty" || arg == "--transport=serial") {
+			transportName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--port=") != std::string::npos) {
+			device = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--baud=") != std::string::npos) {
+			baudRate = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--latency=") != std::string::npos) {
+			latency = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--jitter=") != std::string::npos) {
+			jitter = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--fragment=") != std::string::npos) {
+			fragmentSize = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--fragment-gap=") != std::string::npos) {
+			fragmentGap = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--input=") != std::string::npos) {
+			input = static_cast<std::uint16_t>(std::stoul(arg.substr(arg.find('=') + 1), nullptr, 16));
+		}
+		else if(arg.find("--script=") != std::string::npos) {
+			scriptName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg == "--display") {
+			display = true;
+		}
+		else {
+			printUsage(argv[0]);
+			exit(0);
+		}
+	}
+
+	/* Az eszkzoldali kapcsolatot ltrehoz tvitel kivlasztsa. */
+	std::unique_ptr<AbstractTransport> transport;
+	if(transportName == "serial") {
+		if(device.empty()) {
+			printUsage(argv[0]);
+			exit(0);
+		}
+		transport.reset(new SerialTransport(device, baudRate));
+	}
+#ifdef _WIN32
+	else {
+		std::cout << "Ez az tvitel csak POSIX rendszereken rhet el." << std::endl;
+		exit(0);
+	}
+#else
+	else
+		transport.reset(new PtyTransport());
+#endif
+
+	/* Az emultor ltrehozsa s belltsa. */
+	BorisEmulator emulator(std::move(transport));
+	emulator.setLatency(std::chrono::microseconds(latency), std::chrono::microseconds(jitter));
+	emulator.setFragmentation(fragmentSize, std::chrono::microseconds(fragmentGap));
+	emulator.setInput(input);
+	if(!scriptName.empty()) {
+		std::vector<BorisEmulator::InputStep> script = readInputScript(scriptName);
+		if(script.empty()) {
+			std::cout << "A bemeneti jelalak nem olvashat be: " << scriptName << std::endl;
+			exit(0);
+		}
+		emulator.setInputScript(script);
+	}
+
+	/* A kimenetek kijelzse. Folyamatos kijelzs esetn a kperny trlse utn a kimenetek llapotsora a kperny rgztett sorban
+	ll, s a megjelents csak a megvltozott bitjeit rja ki, korltozott kpkockasebessggel. Klnben minden vltozs egy j sor. */
+	std::recursive_mutex printLocker;
+	std::unique_ptr<ConsoleRenderer> renderer;
+	if(display) {
+		AnsiConsole* console = new AnsiConsole();
+		console->clear();
+		renderer.reset(new ConsoleRenderer(std::unique_ptr<AbstractConsole>(console), printLocker));
+		emulator.setOutputHandler([&renderer](std::uint16_t value) {
+			for(int i = 0; i < 16; i++)
+				renderer->setCell((15 - i) * 4 + ((i < 8) ? 2 : 1), 0, (value >> i) & 1 ? '1' : '0');
+		});
+	}
+	else {
+		emulator.setOutputHandler([](std::uint16_t value) {
+			std::cout << "Kimenetek: " << std::hex << std::setw(4) << std::setfill('0') << value << std::dec << std::endl;
+		});
+	}
+
+	/* Az eszkz elindtsa s futtatsa a megllt karakterig. */
+	if(display) {
+		std::string signalRow;
+		for(int i = 0; i < 16; i++)
+			signalRow += std::string(i == 8 ? " " : "") + "(0)" + (i < 15 ? " " : "");
+		std::cout << signalRow << std::endl << "Q15 Q14 Q13 Q12 Q11 Q10 Q09 Q08  Q07 Q06 Q05 Q04 Q03 Q02 Q01 Q00" << std::endl;
+		renderer->setRegion(0, 0, static_cast<int>(signalRow.size()), 1);
+		renderer->assume(0, 0, signalRow);
+		renderer->start();
+	}
+	std::cout << "BORIS I/O interfsz emultor" << std::endl << std::endl;
+	try {
+		emulator.start();
+	}
+	catch(boost::system::system_error& e) {
+		std::cout << "Az eszkzoldali kapcsolat ltrehozsa kzben hiba lpett fel: " << e.what() << std::endl;
+		return 1;
+	}
+	std::cout << "Kapcsolat: " << emulator.describe() << std::endl;
+	std::cout << "Kilps: [q|Q]" << std::endl;
+	std::string command;
+	while(std::cin >> command && command != "q" && command != "Q");
+	emulator.stop();
+	if(renderer)
+		renderer->stop();
+
+	/* A forgalmi statisztika megjelentse. */
+	std::cout << "Lekrdezsek: " << emulator.getReadCount() << ", kimenetbelltsok: " << emulator.getWriteCount();
+	std::cout << ", ismeretlen bjtok: " << emulator.getUnknownCount() << std::endl;
+	return 0;
+}
@@ -1,10 +1,190 @@
-#include <inc\FakeBoris.h>
+#include <inc\PollEngine.h>
+#include <inc\DaemonControl.h>
+#include <inc\ControlServer.h>
+#include <inc\SerialTransport.h>
+#include <inc\PtyTransport.h>
+#include <inc\TcpTransport.h>
 
+#ifdef _WIN32
+#include <inc\FakeBoris.h>
 #include <Windows.h>
+#else
+#include <inc\TerminalBoris.h>
+#include <unistd.h>
+#endif
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <memory>
+#include <mutex>
+#include <chrono>
 #include <boost\lexical_cast.hpp>
 
+/**
+ * @brief Megjelenti a program hasznlatt bemutat zenetet.
+ *
+ * @param program_name A program neve, ahogy az a parancssorban szerepelt.
+ */
+void printUsage(const char* program_name) {
+	std::cout << "Hasznlat: " << program_name << " --port=<port neve> --baud=<adattviteli sebessg> [opcik]" << std::endl;
+	std::cout << "Opcik:" << std::endl;
+	std::cout << "  --transport=<serial|pty|tcp> Az I/O interfsz elrse soros porton, pszeudoterminlon (a port megadsa nlkl)" << std::endl;
+	std::cout << "                               vagy TCP kapcsolaton, ekkor a port <gp>:<port> alak (alaprtelmezs: serial)." << std::endl;
+	std::cout << "  --rt                         Vals idej temezs az idkritikus szlakon." << std::endl;
+	std::cout << "  --rt-priority=<1-99>         A vals idej temezs prioritsa (alaprtelmezs: ";
+	std::cout << RealTimeProfile::DEFAULT_PRIORITY << "). Windows rendszeren szlprioritsi szintre kpezdik, a folyamat" << std::endl;
+	std::cout << "                               pedig csak 99 esetn kerl vals idej prioritsi osztlyba." << std::endl;
+	std::cout << "  --rt-cpu=<processzormag>     Az idkritikus szlak hozzktse a megadott processzormaghoz." << std::endl;
+	std::cout << "  --period=<ms|<n>us|auto>     Az I/O interfsz lekrdezsnek peridusa (alaprtelmezs: 250 ms). Automatikus" << std::endl;
+	std::cout << "                               mdban az adattviteli sebessghez s a krlfordulsi idkhz igazodik." << std::endl;
+	std::cout << "  --write=<periodic|change>    A kimenetek rsa minden lekrdezskor, vagy csak vltozskor, de azonnal" << std::endl;
+	std::cout << "                               (alaprtelmezs: periodic)." << std::endl;
+	std::cout << "  --pipeline=<1-16>            Az egyszerre vlaszra vr lekrdezsek legnagyobb szma (alaprtelmezs: 1)." << std::endl;
+	std::cout << "  --timeout=<ms>               A vlaszra vr lekrdezsek lejrati ideje (alaprtelmezs: 100)." << std::endl;
+	std::cout << "  --write-queue=<bjt>         A soros port kimeneti sornak korltja, 0 esetn korltlan (alaprtelmezs: 64)." << std::endl;
+	std::cout << "  --rx-ring=<bjt>             A fogadott bjtok gyrjnek mrete, a feldolgozs gy az adatcsere szln" << std::endl;
+	std::cout << "                               trtnik (alaprtelmezs: 0, kzvetlen feldolgozs)." << std::endl;
+	std::cout << "  --low-latency=<on|off>       Az USB-soros talaktk ksleltetsi idztjnek kikapcsolsa (alaprtelmezs: on)." << std::endl;
+	std::cout << "  --vmin=<0-255>               A blokkol olvass ltal megvrt bjtok szma (alaprtelmezs: 1)." << std::endl;
+	std::cout << "  --vtime=<tized s>            A blokkol olvasst lezr sznet a bjtok kztt (alaprtelmezs: 0)." << std::endl;
+	std::cout << "  --probe=<n>                  A krlfordulsi id mrse indtskor n lekrdezssel, rgztett peridus esetn" << std::endl;
+	std::cout << "                               is (alaprtelmezs: 8 automatikus peridusnl, klnben nincs mrs)." << std::endl;
+	std::cout << "  --scheduler=<sleep|hybrid>   Az ismtld adatcsere idztsnek mdja (alaprtelmezs: sleep)." << std::endl;
+	std::cout << "  --spin=<us>                  Hibrid idztsnl a hatrid eltti aktv vrakozs hossza (alaprtelmezs: 1000)." << std::endl;
+	std::cout << "  --cpu-budget=<%>             Hibrid idztsnl a peridus aktv vrakozssal tlthet hnyada (alaprtelmezs: 50)." << std::endl;
+	std::cout << "  --fps=<n>                    Az I/O llapotok kijelzsnek legnagyobb frisstsi gyakorisga (alaprtelmezs: 30)." << std::endl;
+	std::cout << "  --headless                   Futs konzolkp nlkl, a szabvnyos bemenetrl vagy a vezrl portrl rkez" << std::endl;
+	std::cout << "                               parancsokkal (POSIX rendszereken akkor is, ha a szabvnyos" << std::endl;
+	std::cout << "                               bemenet vagy kimenet nem terminl)." << std::endl;
+	std::cout << "  --control=<port>             Konzolkp nlkli futsnl a parancsok fogadsa a 127.0.0.1 cm megadott TCP portjn" << std::endl;
+	std::cout << "                               a szabvnyos bemenet helyett." << std::endl;
+	std::cout << "  --debounce=<ms>              A bemenetek pergsmentestsi ideje az lek felismershez (alaprtelmezs: 0)." << std::endl;
+	std::cout << "  --events                     Konzolkp nlkli futsnl a bemenetek leinek kirsa soronknt, a vlasz" << std::endl;
+	std::cout << "                               berkezsnek az indts ta eltelt idejvel." << std::endl;
+	std::cout << "  --rules=<fjl>               Reflexszablyok, amelyek a kimeneteket a vlaszok berkezsekor azonnal lltjk," << std::endl;
+	std::cout << "                               pldul Q05 = I03 AND NOT I07. Soronknt egy szably, a # utni rsz megjegyzs." << std::endl;
+	std::cout << "  --diagram=<fjl>             Kapukbl, trolkbl, idztkbl s szmllkbl ll blokkdiagram, amely minden" << std::endl;
+	std::cout << "                               peridusban lefut, pldul t1 = TON I03 50ms s Q05 = t1. Soronknt egy blokk." << std::endl;
+	std::cout << "  --record=<fjl>              A kikldtt s a fogadott bjtok rgztse idblyegekkel egy memriba lekpezett" << std::endl;
+	std::cout << "                               gyrfjlba, amely a BorisReplay programmal visszajtszhat." << std::endl;
+	std::cout << "  --record-size=<rekord>       A rgzts gyrjnek mrete 32 bjtos rekordokban (alaprtelmezs: 65536)." << std::endl;
+}
+
+/**
+ * @brief Beolvassa a reflexszablyokat a megadott fjlbl s hozzadja ket az adatcserhez. Hiba esetn megjelenti a hibs sort.
+ *
+ * @param engine Az adatcsere.
+ * @param file_name A szablyokat tartalmaz fjl neve.
+ * @return Igaz, ha a fjl megnyithat volt s minden szablya helyes.
+ */
+bool readReflexRules(PollEngine& engine, const std::string& file_name) {
+	std::ifstream file(file_name);
+	if(!file) {
+		std::cout << "A reflexszablyok fjlja nem nyithat meg: " << file_name << std::endl;
+		return false;
+	}
+
+	std::string line;
+	for(unsigned int number = 1; std::getline(file, line); number++) {
+		/* A megjegyzsek s az res sorok kihagysa. */
+		line = line.substr(0, line.find('#'));
+		if(line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+		try {
+			engine.addReflexRule(line);
+		}
+		catch(std::invalid_argument& e) {
+			std::cout << file_name << ", " << number << ". sor: " << e.what() << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Beolvassa a blokkdiagramot a megadott fjlbl s betlti az adatcserhez. Hiba esetn megjelenti a hibs sort.
+ *
+ * @param engine Az adatcsere.
+ * @param file_name A blokklistt tartalmaz fjl neve.
+ * @return Igaz, ha a fjl megnyithat volt s a blokklista helyes.
+ */
+bool readBlockDiagram(PollEngine& engine, const std::string& file_name) {
+	std::ifstream file(file_name);
+	if(!file) {
+		std::cout << "A blokkdiagram fjlja nem nyithat meg: " << file_name << std::endl;
+		return false;
+	}
+
+	try {
+		std::size_t instructions = engine.loadBlockDiagram(file);
+		std::cout << "Blokkdiagram: " << file_name << ", " << instructions << " utasts." << std::endl;
+	}
+	catch(std::invalid_argument& e) {
+		std::cout << file_name << ", " << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Konzolkp nlkl futtatja az adatcsert, s a szabvnyos bemenetrl vagy a helyi vezrl portrl rkez parancsokat hajtja
+ * vgre a lelltst kr parancsig. A szabvnyos bemenet vge is lelltst jelent.
+ *
+ * @param engine Az adatcsere.
+ * @param control_port A vezrl TCP port, vagy nulla, ha a parancsok a szabvnyos bemenetrl rkeznek.
+ * @param print_events Igaz esetn a bemenetek lei soronknt kirsra kerlnek.
+ * @return Megfelel lefuts esetn nulla, ha a kapcsolat nem jtt ltre vagy a vezrl port nem nyithat meg, egy.
+ */
+int runHeadless(PollEngine& engine, unsigned short control_port, bool print_events) {
+	DaemonControl control(engine);
+
+	/* Feliratkozs a bemenetek sszes lre. Az lek a berkezett bjtokat feldolgoz szlon rkeznek, ezrt a kirsuk s a parancsokra
+	adott vlaszok kirsa klcsnsen kizrja egymst. */
+	std::mutex printLocker;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	if(print_events) {
+		engine.subscribeEdges(0xffff, InputEdgeDetector::Edge::BOTH,
+			[&printLocker, startTime](unsigned int pin, InputEdgeDetector::Edge edge, std::chrono::steady_clock::time_point time) {
+				std::lock_guard<std::mutex> guard(printLocker);
+				std::cout << "edge I" << (pin < 10 ? "0" : "") << pin;
+				std::cout << (edge == InputEdgeDetector::Edge::RISING ? " rising " : " falling ");
+				std::cout << std::chrono::duration_cast<std::chrono::microseconds>(time - startTime).count() << " us" << std::endl;
+			});
+	}
+	if(!engine.start())
+		return 1;
+	std::cout << "Parancsok: set <kimenetek, pl. Q00-07=0xA5>, get, stats, quit" << std::endl;
+
+	if(control_port > 0) {
+		/* A vezrl kiszolgl elindtsa s vrakozs a lelltst kr parancsra. */
+		try {
+			ControlServer server(control_port, boost::bind(&DaemonControl::execute, &control, _1));
+			server.start();
+			std::cout << "Vezrls: 127.0.0.1:" << server.getPort() << std::endl;
+			control.waitForQuit();
+			server.stop();
+		}
+		catch(boost::system::system_error& e) {
+			std::cout << "A vezrl port nem nyithat meg: " << e.what() << std::endl;
+			engine.stop();
+			return 1;
+		}
+	}
+	else {
+		/* A parancsok soronknti beolvassa s vgrehajtsa a szabvnyos bemenetrl. */
+		std::string line;
+		while(!control.isQuitRequested() && std::getline(std::cin, line)) {
+			std::string reply = control.execute(line);
+			std::lock_guard<std::mutex> guard(printLocker);
+			std::cout << reply << std::flush;
+		}
+	}
+
+	engine.stop();
+	return 0;
+}
+
 /**
  * @brief A program belpsi pontja.
  *
@@ -13,13 +193,33 @@
  * @return Megfelel lefuts esetn nulla.
  */
 int main(int argc, char** argv) {
+#ifdef _WIN32
 	/* A konzol karakterkdolsnak megvltoztatsa az kezetes magyar karakterek megfelel kijelzse rdekben. */
 	SetConsoleOutputCP(1252);
+	bool headless = false;
+#else
+	/* A konzolkp a terminl visszhangjra tmaszkodik, ezrt csak akkor rhet el, ha a szabvnyos bemenet s kimenet is terminl. */
+	bool headless = !isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO);
+#endif
 
 	/* A parancssori argumentumok beolvassa s rtelmezse. */
-	std::string device, baud;
-	if(argc != 3) {
-		std::cout << "Hasznlat: " << argv[0] << " --port=<port neve> --baud=<adattviteli sebessg>" << std::endl;
+	std::string device, baud, transportName = "serial";
+	unsigned short controlPort = 0;
+	std::string rulesName;
+	std::string diagramName;
+	std::string recordName;
+	unsigned int recordSize = 65536;
+	unsigned int debounce = 0;
+	bool realTime = false, printEvents = false;
+	int realTimePriority = RealTimeProfile::DEFAULT_PRIORITY, realTimeCpu = -1;
+	PollEngine::SchedulingMode schedulingMode = PollEngine::SchedulingMode::SLEEP;
+	unsigned int spinWindow = 1000, cpuBudget = 50, frameRate = 30;
+	std::chrono::nanoseconds pollPeriod = std::chrono::milliseconds(250);
+	PollEngine::WriteMode writeMode = PollEngine::WriteMode::PERIODIC;
+	unsigned int pipelineDepth = 1, requestTimeout = 100, writeQueueLimit = 64, receiveRingSize = 0, probeSamples = 0;
+	AsyncSerial::LatencyOptions latencyOptions;
+	if(argc < 3) {
+		printUsage(argv[0]);
 		exit(0);
 	}
 	else {
@@ -31,6 +231,100 @@ int main(int argc, char** argv) {
 			else if(arg.find("--baud=") != std::string::npos) {
 				baud = arg.substr(arg.find('=') + 1);
 			}
+			else if(arg == "--transport=serial" || arg == "--transport=pty" || arg == "--transport=tcp") {
+				transportName = arg.substr(arg.find('=') + 1);
+			}
+			else if(arg == "--rt") {
+				realTime = true;
+			}
+			else if(arg.find("--rt-priority=") != std::string::npos) {
+				realTime = true;
+				realTimePriority = boost::lexical_cast<int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--rt-cpu=") != std::string::npos) {
+				realTime = true;
+				realTimeCpu = boost::lexical_cast<int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--period=") != std::string::npos) {
+				std::string value = arg.substr(arg.find('=') + 1);
+				if(value == "auto")
+					pollPeriod = std::chrono::nanoseconds::zero();
+				else if(value.size() > 2 && value.substr(value.size() - 2) == "us")
+					pollPeriod = std::chrono::microseconds(boost::lexical_cast<unsigned int>(value.substr(0, value.size() - 2)));
+				else if(value.size() > 2 && value.substr(value.size() - 2) == "ms")
+					pollPeriod = std::chrono::milliseconds(boost::lexical_cast<unsigned int>(value.substr(0, value.size() - 2)));
+				else
+					pollPeriod = std::chrono::milliseconds(boost::lexical_cast<unsigned int>(value));
+
+				/* A nulla peridus belsleg az automatikus mdot jelli, ezrt az csak az auto rtkkel kapcsolhat be. */
+				if(value != "auto" && pollPeriod == std::chrono::nanoseconds::zero()) {
+					std::cout << "A peridus nem lehet nulla, az automatikus peridushoz hasznld a --period=auto opcit." << std::endl;
+					exit(0);
+				}
+			}
+			else if(arg == "--write=periodic" || arg == "--write=change") {
+				writeMode = (arg == "--write=change") ? PollEngine::WriteMode::ON_CHANGE : PollEngine::WriteMode::PERIODIC;
+			}
+			else if(arg.find("--pipeline=") != std::string::npos) {
+				pipelineDepth = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--timeout=") != std::string::npos) {
+				requestTimeout = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--write-queue=") != std::string::npos) {
+				writeQueueLimit = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--rx-ring=") != std::string::npos) {
+				receiveRingSize = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg == "--low-latency=on" || arg == "--low-latency=off") {
+				latencyOptions.lowLatency = (arg == "--low-latency=on");
+			}
+			else if(arg.find("--vmin=") != std::string::npos) {
+				latencyOptions.minBytes = static_cast<unsigned char>(boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1)));
+			}
+			else if(arg.find("--vtime=") != std::string::npos) {
+				latencyOptions.interByteTimeout = static_cast<unsigned char>(boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1)));
+			}
+			else if(arg.find("--probe=") != std::string::npos) {
+				probeSamples = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg == "--scheduler=sleep" || arg == "--scheduler=hybrid") {
+				schedulingMode = (arg == "--scheduler=hybrid") ? PollEngine::SchedulingMode::HYBRID : PollEngine::SchedulingMode::SLEEP;
+			}
+			else if(arg.find("--spin=") != std::string::npos) {
+				spinWindow = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--cpu-budget=") != std::string::npos) {
+				cpuBudget = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--fps=") != std::string::npos) {
+				frameRate = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg == "--headless") {
+				headless = true;
+			}
+			else if(arg.find("--control=") != std::string::npos) {
+				controlPort = boost::lexical_cast<unsigned short>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg.find("--debounce=") != std::string::npos) {
+				debounce = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
+			else if(arg == "--events") {
+				printEvents = true;
+			}
+			else if(arg.find("--rules=") != std::string::npos) {
+				rulesName = arg.substr(arg.find('=') + 1);
+			}
+			else if(arg.find("--diagram=") != std::string::npos) {
+				diagramName = arg.substr(arg.find('=') + 1);
+			}
+			else if(arg.find("--record=") != std::string::npos) {
+				recordName = arg.substr(arg.find('=') + 1);
+			}
+			else if(arg.find("--record-size=") != std::string::npos) {
+				recordSize = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			}
 			else {
 				std::cout << "rvnytelen argumentum, prbld jra." << std::endl;
 				exit(0);
@@ -38,26 +332,114 @@ int main(int argc, char** argv) {
 		}
 	}
 
-	/* A hasznlatot bemutat zenet ismtelt megjelentse, ha a port neve vagy az adattviteli sebessg nem lett megadva. */
-	if(device.empty() || baud.empty()) {
-		std::cout << "Hasznlat: " << argv[0] << " --port=<port neve> --baud=<adattviteli sebessg>" << std::endl;
+	/* A hasznlatot bemutat zenet ismtelt megjelentse, ha a port neve vagy az adattviteli sebessg nem lett megadva. A
+	pszeudoterminl maga hozza ltre a portot. */
+	if((device.empty() && transportName != "pty") || baud.empty()) {
+		printUsage(argv[0]);
+		exit(0);
+	}
+	if(transportName == "tcp" && device.find(':') == std::string::npos) {
+		std::cout << "A TCP kapcsolat portja <gp>:<port> alak, prbld jra." << std::endl;
+		exit(0);
+	}
+
+	/* Az I/O interfsszel val kapcsolatot ltrehoz tvitel kivlasztsa. */
+	unsigned int baudRate = boost::lexical_cast<unsigned int>(baud);
+	std::unique_ptr<AbstractTransport> transport(new SerialTransport(device, baudRate));
+#ifdef _WIN32
+	if(transportName != "serial") {
+		std::cout << "Ez az tvitel csak POSIX rendszereken rhet el." << std::endl;
 		exit(0);
 	}
+#else
+	if(transportName == "pty")
+		transport.reset(new PtyTransport());
+	else if(transportName == "tcp")
+		transport.reset(new TcpTransport(device.substr(0, device.rfind(':')), device.substr(device.rfind(':') + 1)));
+#endif
 
 	/* A szoftver verziszmnak s a kszt nevnek megjelentse. */
 	std::cout << "Fake BORIS [Verzi 1.0]" << std::endl;
 	std::cout << "Mikls rpd (c) 2016" << std::endl << std::endl;
 
-	/* A WinFACT szoftvercsomag Block-oriented Simulation (BORIS) szoftvernek viselkedst utnz objektum ltrehozsa s a soros
-	porton keresztli kommunikci inicializlsa. */
-	FakeBoris fakeBoris(device,	boost::lexical_cast<unsigned int>(baud));
-	fakeBoris.start();
+	/* A WinFACT szoftvercsomag Block-oriented Simulation (BORIS) szoftvernek viselkedst utnz objektum ltrehozsa. Konzolkp
+	nlkli futsnl csak az adatcsere jn ltre, a konzolkpet Windows konzolon a FakeBoris, POSIX terminlon a TerminalBoris
+	rajzolja. */
+	std::unique_ptr<PollEngine> engine;
+#ifdef _WIN32
+	FakeBoris* fakeBoris = nullptr;
+	if(!headless) {
+		fakeBoris = new FakeBoris(std::move(transport), baudRate);
+		fakeBoris->setFrameRate(frameRate);
+		engine.reset(fakeBoris);
+	}
+#else
+	TerminalBoris* fakeBoris = nullptr;
+	if(!headless) {
+		fakeBoris = new TerminalBoris(std::move(transport), baudRate);
+		fakeBoris->setFrameRate(frameRate);
+		engine.reset(fakeBoris);
+	}
+#endif
+	else
+		engine.reset(new PollEngine(std::move(transport), baudRate));
+
+	/* A soros porton keresztli kommunikci belltsa. */
+	if(realTime) {
+		try {
+			engine->setRealTimeProfile(RealTimeProfile(realTimePriority, realTimeCpu));
+		}
+		catch(std::invalid_argument& e) {
+			std::cout << "A vals idej profil nem llthat be: " << e.what() << std::endl;
+			exit(0);
+		}
+	}
+	engine->setPollPeriod(pollPeriod);
+	engine->setWriteMode(writeMode);
+	engine->setPipelineDepth(pipelineDepth);
+	engine->setRequestTimeout(std::chrono::milliseconds(requestTimeout));
+	engine->setWriteQueueLimit(writeQueueLimit);
+	engine->setReceiveRing(receiveRingSize);
+	engine->setLatencyOptions(latencyOptions);
+	engine->setProbeSamples(probeSamples);
+	engine->setSchedulingMode(schedulingMode, std::chrono::microseconds(spinWindow), cpuBudget / 100.0);
+	engine->setDebounce(0xffff, std::chrono::milliseconds(debounce));
+	if(!rulesName.empty() && !readReflexRules(*engine, rulesName))
+		exit(0);
+	if(!diagramName.empty() && !readBlockDiagram(*engine, diagramName))
+		exit(0);
+	if(!recordName.empty()) {
+		try {
+			std::unique_ptr<TrafficRecorder> recorder(new TrafficRecorder(recordName, recordSize));
+			std::cout << "Rgzts: " << recorder->describe() << std::endl;
+			engine->setTrafficRecorder(std::move(recorder));
+		}
+		catch(std::exception& e) {
+			std::cout << "A rgzts nem indthat el: " << e.what() << std::endl;
+			exit(0);
+		}
+	}
+	if(headless)
+		return runHeadless(*engine, controlPort, printEvents);
 
-	/* A sg megjelentse s az llapotok megvltoztatst kivlt paramterek ismtelt bekrse a megllt karakterig. */
+#ifdef _WIN32
+	/* A konzolkp kirajzolsa, a kommunikci elindtsa, majd a sg megjelentse s az llapotok megvltoztatst kivlt
+	paramterek ismtelt bekrse a megllt karakterig. */
+	if(!fakeBoris->start())
+		return 1;
 	std::cout << "j llapot belltsa: Q[00-15] = [0|1] # A \"Q\" s az egyenlsgjel automatikusan megjelennek." << std::endl;
-	std::cout << "Kilps: [q|Q]" << std::endl;
-	std::cout << "Trls: [Backspace] # Minden bevitelt egyszerre trl." << std::endl;
-	fakeBoris.readUntil('q');
+	std::cout << "Tbb kimenet egyszerre: Q00-07=0xA5, Q*=0xBEEF, Q03=1,Q05=0 # Egy lpsben kerlnek kikldsre." << std::endl;
+	std::cout << "Bevitel: [Szkz|Enter]" << std::endl;
+	std::cout << "Kilps: [q|Q] # res sorban." << std::endl;
+	std::cout << "Trls: [Backspace] # Egy karaktert trl, [Esc] az egsz sort." << std::endl;
+	fakeBoris->readUntil('q');
+#else
+	/* A kperny trlse utn a karakterkp s a sg kirajzolsa, a kommunikci elindtsa, majd az llapotok megvltoztatst
+	kivlt parancsok soronknti bekrse a megllt karakterig. */
+	if(!fakeBoris->start())
+		return 1;
+	fakeBoris->readUntil('q');
+#endif
 
 	/* A szoftver futsnak befejezse. */
 	return 0;
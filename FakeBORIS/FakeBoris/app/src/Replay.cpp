@@ -0,0 +1,198 @@
+#include <inc\TrafficReplayer.h>
+#include <inc\SerialTransport.h>
+#include <inc\PtyTransport.h>
+#include <inc\TcpTransport.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cstddef>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <boost\lexical_cast.hpp>
+
+/**
+ * @brief Megjelenti a program hasznlatt bemutat zenetet.
+ *
+ * @param program_name A program neve, ahogy az a parancssorban szerepelt.
+ */
+void printUsage(const char* program_name) {
+	std::cout << "Hasznlat: " << program_name << " <rgzts> [opcik]" << std::endl;
+	std::cout << "Opcik:" << std::endl;
+	std::cout << "  --dump                       A rgztett bjtsorozatok kirsa idblyeggel s irnnyal (alaprtelmezs, ha" << std::endl;
+	std::cout << "                               nincs megadva port)." << std::endl;
+	std::cout << "  --direction=<sent|received>  A visszajtszott irny: a kikldtt bjtok egy I/O interfsznek, a fogadottak egy" << std::endl;
+	std::cout << "                               vezrlprogramnak jtszhatk vissza (alaprtelmezs: sent)." << std::endl;
+	std::cout << "  --speed=<szorz>             A visszajtszs gyorstsa, 0 esetn vrakozs nlkl (alaprtelmezs: 1)." << std::endl;
+	std::cout << "  --transport=<serial|pty|tcp> A visszajtszs soros porton, pszeudoterminlon (a port megadsa nlkl) vagy TCP" << std::endl;
+	std::cout << "                               kapcsolaton, ekkor a port <gp>:<port> alak (alaprtelmezs: serial)." << std::endl;
+	std::cout << "  --port=<port neve>           A port, amelyen a visszajtszs trtnik." << std::endl;
+	std::cout << "  --baud=<sebessg>            A soros port adattviteli sebessge (alaprtelmezs: 9600)." << std::endl;
+}
+
+/**
+ * @brief Kirja egy bjtsorozat bjtjait hexadecimlisan, szkzzel elvlasztva.
+ *
+ * @param data A bjtok.
+ * @param size A bjtok szma.
+ */
+void printHex(const char* data, std::size_t size) {
+	std::cout << std::hex << std::setfill('0');
+	for(std::size_t i = 0; i < size; i++)
+		std::cout << (i > 0 ? " " : "") << std::setw(2) << (static_cast<unsigned int>(data[i]) & 0xff);
+	std::cout << std::dec << std::setfill(' ');
+}
+
+/**
+ * @brief A program belpsi pontja.
+ *
+ * @param argc A parancssori argumentumok szma.
+ * @param argv A parancssori argumentumok tmbje.
+ * @return Megfelel lefuts esetn nulla.
+ */
+int main(int argc, char** argv) {
+#ifdef _WIN32
+	/* A konzol karakterkdolsnak megvltoztatsa az kezetes magyar karakterek megfelel kijelzse rdekben. */
+	SetConsoleOutputCP(1252);
+#endif
+
+	/* A parancssori argumentumok beolvassa s rtelmezse. */
+	if(argc < 2 || std::string(argv[1]).find("--") == 0) {
+		printUsage(argv[0]);
+		return 0;
+	}
+	std::string captureName(argv[1]), device, transportName = "serial";
+	TrafficRecorder::Direction direction = TrafficRecorder::Direction::SENT;
+	unsigned int baudRate = 9600;
+	double speed = 1.0;
+	bool dump = false;
+	for(int i = 2; i < argc; i++) {
+		std::string arg(argv[i]);
+		if(arg == "--dump") {
+			dump = true;
+		}
+		else if(arg == "--direction=sent" || arg == "--direction=received") {
+			direction = (arg == "--direction=sent") ? TrafficRecorder::Direction::SENT : TrafficRecorder::Direction::RECEIVED;
+		}
+		else if(arg.find("--speed=") != std::string::npos) {
+			speed = boost::lexical_cast<double>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg == "--transport=serial" || arg == "--transport=pty" || arg == "--transport=tcp") {
+			transportName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--port=") != std::string::npos) {
+			device = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--baud=") != std::string::npos) {
+			baudRate = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else {
+			printUsage(argv[0]);
+			return 0;
+		}
+	}
+	if(speed < 0.0) {
+		std::cout << "A visszajtszs sebessge nem lehet negatv." << std::endl;
+		return 0;
+	}
+	if(transportName == "tcp" && device.find(':') == std::string::npos) {
+		std::cout << "A TCP kapcsolat portja <gp>:<port> alak, prbld jra." << std::endl;
+		return 0;
+	}
+
+	/* A rgzts beolvassa. */
+	std::unique_ptr<TrafficReplayer> replayer;
+	try {
+		replayer.reset(new TrafficReplayer(captureName));
+	}
+	catch(std::runtime_error& e) {
+		std::cout << "A rgzts nem olvashat be: " << e.what() << std::endl;
+		return 0;
+	}
+	const std::vector<TrafficReplayer::Entry>& entries = replayer->getEntries();
+	std::time_t startTime = std::chrono::system_clock::to_time_t(replayer->getStartTime());
+	std::cout << "Rgzts: " << captureName << ", " << entries.size() << " bjtsorozat, kezdete: " << std::ctime(&startTime);
+
+	/* A rgztett bjtsorozatok kirsa. Az idblyeg a rgzts kezdete ta eltelt id, a nyl irnya a program fell nzve a
+	kikldtt (>) vagy a fogadott (<) bjtokat jelli. */
+	bool replay = !device.empty() || transportName == "pty";
+	if(dump || !replay) {
+		std::cout << std::fixed << std::setprecision(3);
+		for(const TrafficReplayer::Entry& entry : entries) {
+			std::cout << std::setw(12) << entry.time.count() / 1e6 << " ms ";
+			std::cout << (entry.direction == TrafficRecorder::Direction::SENT ? "> " : "< ");
+			printHex(entry.data.data(), entry.data.size());
+			std::cout << std::endl;
+		}
+	}
+	if(!replay)
+		return 0;
+
+	/* A visszajtszs tvitelnek kivlasztsa. */
+	std::unique_ptr<AbstractTransport> transport(new SerialTransport(device, baudRate));
+#ifdef _WIN32
+	if(transportName != "serial") {
+		std::cout << "Ez az tvitel csak POSIX rendszereken rhet el." << std::endl;
+		return 0;
+	}
+#else
+	if(transportName == "pty")
+		transport.reset(new PtyTransport());
+	else if(transportName == "tcp")
+		transport.reset(new TcpTransport(device.substr(0, device.rfind(':')), device.substr(device.rfind(':') + 1)));
+#endif
+
+	/* A bjtsorozatok visszajtszsa, a kzben fogadott bjtok kirsval. A pszeudoterminl megnyitsa utn a msik flnek id kell a
+	csatlakozshoz, ezrt a visszajtszs egy Enter lenyomsra indul. */
+	CallbackAsyncSerial port;
+	std::mutex printLocker;
+	std::size_t receivedBytes = 0;
+	try {
+		transport->open(port);
+	}
+	catch(boost::system::system_error& e) {
+		std::cout << "A kapcsolat ltrehozsa kzben hiba lpett fel: " << e.what() << std::endl;
+		return 1;
+	}
+	std::chrono::steady_clock::time_point replayStart = std::chrono::steady_clock::now();
+	port.setCallback([&](const char* data, std::size_t size) {
+		std::lock_guard<std::mutex> guard(printLocker);
+		receivedBytes += size;
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - replayStart;
+		std::cout << std::fixed << std::setprecision(3) << std::setw(12) << elapsed.count() / 1e6 << " ms < ";
+		printHex(data, size);
+		std::cout << std::endl;
+	});
+	std::cout << "Kapcsolat: " << transport->describe() << std::endl;
+	if(transportName == "pty") {
+		std::cout << "Indts: [Enter]" << std::endl;
+		std::string line;
+		std::getline(std::cin, line);
+	}
+	{
+		std::lock_guard<std::mutex> guard(printLocker);
+		replayStart = std::chrono::steady_clock::now();
+	}
+	std::size_t count = replayer->replay(port, direction, speed);
+	std::chrono::nanoseconds elapsed;
+	{
+		std::lock_guard<std::mutex> guard(printLocker);
+		elapsed = std::chrono::steady_clock::now() - replayStart;
+	}
+
+	/* A ksve rkez vlaszok megvrsa, majd a kapcsolat lezrsa. */
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	port.clearCallback();
+	port.close();
+	std::lock_guard<std::mutex> guard(printLocker);
+	std::cout << "Visszajtszott bjtsorozatok: " << count << ", id: " << std::fixed << std::setprecision(1);
+	std::cout << elapsed.count() / 1e6 << " ms, fogadott bjtok: " << receivedBytes << std::endl;
+	return 0;
+}
@@ -0,0 +1,244 @@
+#include <inc\BlockDiagram.h>
+#include <inc\BatchSimulator.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost\lexical_cast.hpp>
+
+/**
+ * @brief Megjelenti a program hasznlatt bemutat zenetet.
+ *
+ * @param program_name A program neve, ahogy az a parancssorban szerepelt.
+ */
+void printUsage(const char* program_name) {
+	std::cout << "Hasznlat: " << program_name << " <blokkdiagram> [opcik]" << std::endl;
+	std::cout << "Opcik:" << std::endl;
+	std::cout << "  --sweep                      Mind a 65536 bemeneti llapot kirtkelse, mindegyik alaphelyzetbl egy lpssel" << std::endl;
+	std::cout << "                               (alaprtelmezs)." << std::endl;
+	std::cout << "  --random=<n>                 n vletlen bemeneti sorozat kirtkelse, 64-gyel oszthat szmra kerektve. Minden" << std::endl;
+	std::cout << "                               lpsben minden bemenet 1/8 valsznsggel vlt." << std::endl;
+	std::cout << "  --steps=<n>                  A vletlen sorozatok hossza lpsekben (alaprtelmezs: 100)." << std::endl;
+	std::cout << "  --step=<ms>                  Egy lps idtartama az idztkhz (alaprtelmezs: 10)." << std::endl;
+	std::cout << "  --seed=<n>                   A vletlen sorozatok kezdrtke (alaprtelmezs: 1)." << std::endl;
+	std::cout << "  --write=<fjl>               Az eredmnytblzat kirsa <bemenet> <kimenet> hexadecimlis prokknt." << std::endl;
+	std::cout << "  --expect=<fjl>              Az eredmnytblzat sszevetse egy korbban kirt tblzattal. Eltrs esetn a" << std::endl;
+	std::cout << "                               program visszatrsi rtke 1." << std::endl;
+	std::cout << "  --verify                     Az eredmnyek sszevetse a blokkdiagram egyenknti kirtkelsvel." << std::endl;
+}
+
+/**
+ * @brief Beolvas egy eredmnytblzatot. A # utni rsz megjegyzs.
+ *
+ * @param file_name A tblzat fjljnak neve.
+ * @param inputs A beolvasott bemeneti llapotok.
+ * @param outputs A beolvasott kimeneti llapotok.
+ * @return Igaz, ha a fjl megnyithat s helyes volt.
+ */
+bool readTable(const std::string& file_name, std::vector<std::uint16_t>& inputs, std::vector<std::uint16_t>& outputs) {
+	std::ifstream file(file_name);
+	if(!file) {
+		std::cout << "A tblzat nem nyithat meg: " << file_name << std::endl;
+		return false;
+	}
+
+	std::string line;
+	for(unsigned int number = 1; std::getline(file, line); number++) {
+		std::istringstream stream(line.substr(0, line.find('#')));
+		unsigned int input, output;
+		if(!(stream >> std::hex >> input))
+			continue;
+		if(!(stream >> output) || input > 0xffff || output > 0xffff) {
+			std::cout << file_name << ", " << number << ". sor: rvnytelen sor: " << line << std::endl;
+			return false;
+		}
+		inputs.push_back(static_cast<std::uint16_t>(input));
+		outputs.push_back(static_cast<std::uint16_t>(output));
+	}
+	return true;
+}
+
+/**
+ * @brief A program belpsi pontja.
+ *
+ * @param argc A parancssori argumentumok szma.
+ * @param argv A parancssori argumentumok tmbje.
+ * @return Megfelel lefuts s egyezs esetn nulla, hiba vagy eltrs esetn 1.
+ */
+int main(int argc, char** argv) {
+#ifdef _WIN32
+	/* A konzol karakterkdolsnak megvltoztatsa az kezetes magyar karakterek megfelel kijelzse rdekben. */
+	SetConsoleOutputCP(1252);
+#endif
+
+	/* A parancssori argumentumok beolvassa s rtelmezse. */
+	if(argc < 2 || std::string(argv[1]).find("--") == 0) {
+		printUsage(argv[0]);
+		return 1;
+	}
+	std::string diagramName(argv[1]), writeName, expectName;
+	unsigned int sequences = 0, steps = 100, stepTime = 10, seed = 1;
+	bool verify = false;
+	for(int i = 2; i < argc; i++) {
+		std::string arg(argv[i]);
+		if(arg == "--sweep") {
+			sequences = 0;
+		}
+		else if(arg.find("--random=") != std::string::npos) {
+			sequences = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+			sequences = (sequences + BatchSimulator::LANES - 1) / BatchSimulator::LANES * BatchSimulator::LANES;
+		}
+		else if(arg.find("--steps=") != std::string::npos) {
+			steps = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--step=") != std::string::npos) {
+			stepTime = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--seed=") != std::string::npos) {
+			seed = boost::lexical_cast<unsigned int>(arg.substr(arg.find('=') + 1));
+		}
+		else if(arg.find("--write=") != std::string::npos) {
+			writeName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg.find("--expect=") != std::string::npos) {
+			expectName = arg.substr(arg.find('=') + 1);
+		}
+		else if(arg == "--verify") {
+			verify = true;
+		}
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if(stepTime == 0 || (sequences > 0 && steps == 0)) {
+		std::cout << "A lps idtartamnak s a sorozatok hossznak pozitvnak kell lennie." << std::endl;
+		return 1;
+	}
+
+	/* A blokkdiagram betltse. */
+	BlockDiagram diagram;
+	std::ifstream file(diagramName);
+	if(!file) {
+		std::cout << "A blokkdiagram fjlja nem nyithat meg: " << diagramName << std::endl;
+		return 1;
+	}
+	try {
+		diagram.load(file);
+	}
+	catch(std::invalid_argument& e) {
+		std::cout << diagramName << ", " << e.what() << std::endl;
+		return 1;
+	}
+	std::cout << "Blokkdiagram: " << diagramName << ", " << diagram.getInstructionCount() << " utasts, ";
+	std::cout << diagram.getFeedbackCount() << " visszacsatols." << std::endl;
+
+	/* A forgatknyvek kirtkelse 64 svos ktegekben. Kimert bejrsnl minden bemeneti llapot egy egylpses forgatknyv,
+	vletlen sorozatoknl a ktegek svjai egymstl fggetlen sorozatok, amelyek bemenetei bitenknt vletlenszeren vltanak. */
+	std::chrono::nanoseconds stepDuration = std::chrono::milliseconds(stepTime);
+	std::size_t rowsPerScenario = sequences > 0 ? steps : 1;
+	std::vector<std::uint16_t> inputs, outputs;
+	BatchSimulator simulator(diagram, stepDuration);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	if(sequences == 0) {
+		outputs = simulator.sweep();
+		inputs.resize(outputs.size());
+		for(std::size_t i = 0; i < inputs.size(); i++)
+			inputs[i] = static_cast<std::uint16_t>(i);
+	}
+	else {
+		std::mt19937_64 generator(seed);
+		inputs.resize(static_cast<std::size_t>(sequences) * steps);
+		outputs.resize(inputs.size());
+		std::uint16_t laneInputs[64], laneOutputs[64];
+		for(unsigned int batch = 0; batch < sequences / BatchSimulator::LANES; batch++) {
+			std::uint64_t inputLanes[16] = { 0 }, outputLanes[16];
+			simulator.reset();
+			for(unsigned int step = 0; step < steps; step++) {
+				for(unsigned int bit = 0; bit < 16; bit++)
+					inputLanes[bit] ^= generator() & generator() & generator();
+				simulator.step(inputLanes, outputLanes);
+				BatchSimulator::fromLanes(inputLanes, laneInputs);
+				BatchSimulator::fromLanes(outputLanes, laneOutputs);
+				for(unsigned int lane = 0; lane < BatchSimulator::LANES; lane++) {
+					std::size_t row = (static_cast<std::size_t>(batch) * BatchSimulator::LANES + lane) * steps + step;
+					inputs[row] = laneInputs[lane];
+					outputs[row] = laneOutputs[lane];
+				}
+			}
+		}
+	}
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - startTime;
+	std::cout << "Kirtkelt lpsek: " << inputs.size() << ", id: " << std::fixed << std::setprecision(1);
+	std::cout << elapsed.count() / 1e6 << " ms, " << std::setprecision(0) << inputs.size() / (elapsed.count() / 1e9 + 1e-12);
+	std::cout << " lps/s." << std::endl;
+
+	/* Az eredmnyek sszevetse a blokkdiagram egyenknti, idblyegekkel vezrelt kirtkelsvel. */
+	int result = 0;
+	if(verify) {
+		std::size_t differences = 0;
+		for(std::size_t row = 0; row < inputs.size(); row++) {
+			std::size_t step = row % rowsPerScenario;
+			if(step == 0)
+				diagram.reset();
+			std::uint16_t output = diagram.run(inputs[row], std::chrono::steady_clock::time_point() + stepDuration * step);
+			if(output != outputs[row] && differences++ < 10) {
+				std::cout << "Eltrs, " << row / rowsPerScenario << ". forgatknyv " << step << ". lpse: bemenet " << std::hex;
+				std::cout << std::setfill('0') << std::setw(4) << inputs[row] << ", ktegelt " << std::setw(4) << outputs[row];
+				std::cout << ", egyenknti " << std::setw(4) << output << std::dec << std::setfill(' ') << std::endl;
+			}
+		}
+		std::cout << "Ellenrzs: " << differences << " eltrs." << std::endl;
+		result = differences > 0 ? 1 : result;
+	}
+
+	/* Az eredmnytblzat kirsa. */
+	if(!writeName.empty()) {
+		std::ofstream table(writeName);
+		if(!table) {
+			std::cout << "A tblzat nem rhat: " << writeName << std::endl;
+			return 1;
+		}
+		table << "# " << diagramName << (sequences == 0 ? ", kimert bejrs" : ", vletlen sorozatok");
+		if(sequences > 0)
+			table << ": " << sequences << " x " << steps << " lps, lpskz " << stepTime << " ms, kezdrtk " << seed;
+		table << std::endl << std::hex << std::setfill('0');
+		for(std::size_t row = 0; row < inputs.size(); row++) {
+			if(sequences > 0 && row % rowsPerScenario == 0)
+				table << "# " << std::dec << row / rowsPerScenario << ". sorozat" << std::hex << std::endl;
+			table << std::setw(4) << inputs[row] << " " << std::setw(4) << outputs[row] << std::endl;
+		}
+	}
+
+	/* Az eredmnytblzat sszevetse a vrt tblzattal. */
+	if(!expectName.empty()) {
+		std::vector<std::uint16_t> expectedInputs, expectedOutputs;
+		if(!readTable(expectName, expectedInputs, expectedOutputs))
+			return 1;
+		if(expectedInputs != inputs) {
+			std::cout << "A vrt tblzat ms bemenetekkel kszlt, prbld jra ugyanazokkal a paramterekkel." << std::endl;
+			return 1;
+		}
+		std::size_t differences = 0;
+		for(std::size_t row = 0; row < outputs.size(); row++) {
+			if(outputs[row] != expectedOutputs[row] && differences++ < 10) {
+				std::cout << "Eltrs, " << row / rowsPerScenario << ". forgatknyv " << row % rowsPerScenario << ". lpse: bemenet ";
+				std::cout << std::hex << std::setfill('0') << std::setw(4) << inputs[row] << ", vrt " << std::setw(4);
+				std::cout << expectedOutputs[row] << ", kapott " << std::setw(4) << outputs[row] << std::dec << std::setfill(' ') << std::endl;
+			}
+		}
+		std::cout << "Regresszi: " << differences << " eltrs." << std::endl;
+		result = differences > 0 ? 1 : result;
+	}
+	return result;
+}
@@ -0,0 +1,70 @@
+#ifndef INC_ABSTRACTCONSOLE_H_
+#define INC_ABSTRACTCONSOLE_H_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Absztrakt sosztly a konzolkperny karaktereinek adott pozcira rsra. A leszrmazott osztlyok hatrozzk meg, hogy az
+ * rs a Windows konzol programozi felletn vagy ANSI vezrlszekvencikkal trtnik, gy ugyanaz a megjelents futhat Windows
+ * konzolon s POSIX terminlon is.
+ */
+class AbstractConsole {
+public:
+	/**
+	 * @brief Egy sorban egyms utn kvetkez, egyszerre kirand karakterek sorozata.
+	 */
+	struct Run {
+		/**
+		 * Az els karakter X irny helyzete a konzol koordintarendszerben.
+		 */
+		int x;
+
+		/**
+		 * A sor Y irny helyzete a konzol koordintarendszerben.
+		 */
+		int y;
+
+		/**
+		 * A kirand karakterek els elemre mutat pointer.
+		 */
+		const char* text;
+
+		/**
+		 * A kirand karakterek szma.
+		 */
+		std::size_t length;
+	};
+
+protected:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora.
+	 */
+	AbstractConsole();
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	AbstractConsole(AbstractConsole&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	AbstractConsole& operator=(const AbstractConsole&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly virtulis destruktora.
+	 */
+	virtual ~AbstractConsole();
+
+	/**
+	 * @brief Kirja a megadott karaktersorozatokat a konzolkpernyre a kurzor helyzetnek s a karakterek sznnek megvltoztatsa
+	 * nlkl. A leszrmazott osztlyok a lehet legkevesebb rendszerhvssal rnak.
+	 *
+	 * @param runs A kirand karaktersorozatok.
+	 */
+	virtual void write(const std::vector<Run>& runs) = 0;
+};
+
+#endif /* INC_ABSTRACTCONSOLE_H_ */
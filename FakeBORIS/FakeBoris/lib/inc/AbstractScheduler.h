@@ -2,16 +2,37 @@
 #define INC_ABSTRACTSCHEDULER_H_
 
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <thread>
+#include <chrono>
 
 /**
  * @brief Absztrakt sosztly az ismtld mveletek folytonos vgrehajtsra. Segtsgvel minden osztly, amelyik ebbl az sbl is
  * szrmazik, egyszeren s biztonsgosan tud kln szlon ismtld feladatokat elltni.
  */
 class AbstractScheduler {
+public:
 	/**
-	 * A tagfggvnyek tbb szlrl val elrst klcsnsen kizr adattag.
+	 * @brief Az ismtld mvelet idztsnek mdjai.
+	 */
+	enum class SchedulingMode {
+		/**
+		 * A szl a teljes peridus idejre feltteles vltozn vrakozik. Takarkos, de a peridus pontossga az opercis rendszer
+		 * idztjnek felbontstl fgg, ezrt 1 ms alatti peridusokra nem alkalmas.
+		 */
+		SLEEP,
+
+		/**
+		 * A szl a hatrid eltti prgsi ablak kezdetig vrakozik, majd a monoton rt figyelve aktvan vr a hatridig. A
+		 * hatridk abszolt idpontok, gy a kssek nem halmozdnak.
+		 */
+		HYBRID
+	};
+
+private:
+	/**
+	 * A tagfggvnyek tbb szlrl val elrst klcsnsen kizr adattag. Az ismtld mvelet vgrehajtsa alatt nincs zrolva.
 	 */
 	std::recursive_mutex threadMutex;
 
@@ -28,12 +49,33 @@ class AbstractScheduler {
 	/**
 	 * Az ismtld mvelet jbli vgrehajtsa eltti vrakozsi id.
 	 */
-	unsigned long long int period;
+	std::chrono::nanoseconds period;
 
 	/**
-	 * Az ismtld mvelet szlnak futst jelz bit.
+	 * Az ismtld mvelet idztsnek mdja.
 	 */
-	bool isStarted;
+	SchedulingMode mode;
+
+	/**
+	 * Hibrid idzts esetn a hatrid eltti, aktv vrakozssal tlttt id legnagyobb hossza.
+	 */
+	std::chrono::nanoseconds spinWindow;
+
+	/**
+	 * Hibrid idzts esetn a peridusnak az a legnagyobb hnyada (0 s 1 kztt), amelyet a szl aktv vrakozssal tlthet.
+	 */
+	double cpuBudget;
+
+	/**
+	 * Az ismtld mvelet szlnak futst jelz bit. Atomi, mert a hibrid idzts aktv vrakozsa zrols nlkl figyeli.
+	 */
+	std::atomic<bool> isStarted;
+
+	/**
+	 * Az ismtld mvelet soron kvli, azonnali vgrehajtsnak krst jelz bit. Atomi, mert a hibrid idzts aktv vrakozsa
+	 * zrols nlkl figyeli.
+	 */
+	std::atomic<bool> isTriggered;
 
 	/**
 	 * Az ismtld mvelet szla.
@@ -46,6 +88,15 @@ class AbstractScheduler {
 	 */
 	void schedule();
 
+	/**
+	 * @brief Vgrehajtja az ismtld mveletet a zrols feloldsa mellett, gy a kzben rkez soron kvli vgrehajtsi krs, a
+	 * lellts s a belltsok mdostsa nem vrja meg a mvelet vgt. A krsek a jelzbitekben maradnak meg, ezeket a szl a
+	 * kvetkez vrakozs eltt, mr a zrols alatt ellenrzi.
+	 *
+	 * @param thread_lock Az ismtld mvelet szlnak zrolsa, amely a hvs eltt s utn is zrolt.
+	 */
+	void performUnlocked(std::unique_lock<std::recursive_mutex>& thread_lock);
+
 protected:
 	/**
 	 * @brief Az osztly alaprtelmezett konstruktora.
@@ -77,6 +128,18 @@ protected:
 	 */
 	void stop();
 
+	/**
+	 * @brief Megvrja a lelltott ismtld mvelet szlnak befejezdst, gy a hvs utn a mvelet mr biztosan nem fut.
+	 */
+	void join();
+
+	/**
+	 * @brief Felbreszti az ismtld mvelet szlt s soron kvl, azonnal vgrehajtatja vele a mveletet. A kvetkez
+	 * vgrehajtsig rkez tovbbi krsek egyetlen vgrehajtsba olvadnak ssze. Hibrid idzts esetn a rendes temezs hatridit
+	 * nem mdostja.
+	 */
+	void trigger();
+
 	/**
 	 * @brief Belltja a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt.
 	 *
@@ -84,10 +147,39 @@ protected:
 	 */
 	void setPeriod(unsigned long long int _duration);
 
+	/**
+	 * @brief Belltja a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt, milliszekundumnl finomabb felbontssal.
+	 *
+	 * @param _period A vrakozsi id hossza.
+	 */
+	void setPeriod(std::chrono::nanoseconds _period);
+
+	/**
+	 * @brief Lekrdezi a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt.
+	 *
+	 * @return A vrakozsi id hossza.
+	 */
+	std::chrono::nanoseconds getPeriod();
+
+	/**
+	 * @brief Belltja az ismtld mvelet idztsnek mdjt.
+	 *
+	 * @param scheduling_mode Az idzts mdja.
+	 * @param spin_window Hibrid idzts esetn a hatrid eltti aktv vrakozs legnagyobb hossza.
+	 * @param cpu_budget Hibrid idzts esetn a peridusnak az aktv vrakozssal tlthet legnagyobb hnyada (0 s 1 kztt).
+	 */
+	void setSchedulingMode(SchedulingMode scheduling_mode, std::chrono::nanoseconds spin_window, double cpu_budget);
+
 	/**
 	 * @brief Definilja az ismtld mveletet.
 	 */
 	virtual void performScheduledAction() = 0;
+
+	/**
+	 * @brief Az ismtld mvelet szln, az els vgrehajts eltt egyszer hvdik meg. A leszrmazott osztlyok ebben llthatjk be
+	 * a szl temezsi tulajdonsgait. Az alaprtelmezett megvalsts nem csinl semmit.
+	 */
+	virtual void prepareThread();
 };
 
 #endif /* INC_ABSTRACTSCHEDULER_H_ */
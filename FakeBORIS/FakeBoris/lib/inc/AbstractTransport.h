@@ -0,0 +1,50 @@
+#ifndef INC_ABSTRACTTRANSPORT_H_
+#define INC_ABSTRACTTRANSPORT_H_
+
+#include <AsyncSerial\AsyncSerial.h>
+
+#include <string>
+
+/**
+ * @brief Absztrakt sosztly az I/O interfsszel val kapcsolat ltrehozsra. Az tvitel hatrozza meg, hogy a soros kommunikcit
+ * megvalst objektum milyen eszkzn keresztl ri el a msik felet, gy ugyanaz a protokoll vltozatlanul futhat fizikai soros
+ * porton, pszeudoterminlon, a folyamaton belli hurkon vagy helyi TCP kapcsolaton keresztl.
+ */
+class AbstractTransport {
+protected:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora.
+	 */
+	AbstractTransport();
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	AbstractTransport(AbstractTransport&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	AbstractTransport& operator=(const AbstractTransport&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly virtulis destruktora.
+	 */
+	virtual ~AbstractTransport();
+
+	/**
+	 * @brief Ltrehozza a kapcsolatot s hozzrendeli a soros kommunikcit megvalst objektumhoz. A kapcsolatot az objektum
+	 * lezrsa bontja. Sikertelen kapcsolds esetn boost::system::system_error kivtelt dob.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port) = 0;
+
+	/**
+	 * @return Az tvitel rvid lersa, amelybl kiderl, hogy a msik fl hol csatlakozhat.
+	 */
+	virtual std::string describe() const = 0;
+};
+
+#endif /* INC_ABSTRACTTRANSPORT_H_ */
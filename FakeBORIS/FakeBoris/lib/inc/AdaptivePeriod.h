@@ -0,0 +1,91 @@
+#ifndef INC_ADAPTIVEPERIOD_H_
+#define INC_ADAPTIVEPERIOD_H_
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * @brief Az I/O interfsz lekrdezsnek peridust az adattviteli sebessgbl s a mrt krlfordulsi idkbl meghatroz osztly.
+ * A peridus soha nem lehet rvidebb egy teljes utasts s vlasz tviteli idejnl, s kveti a krlfordulsi id simtott
+ * rtkt s ingadozst.
+ */
+class AdaptivePeriod {
+	/**
+	 * A peridus als korltja, egy teljes utasts s vlasz tviteli ideje.
+	 */
+	const std::chrono::nanoseconds minimum;
+
+	/**
+	 * A krlfordulsi id simtott rtke.
+	 */
+	std::chrono::nanoseconds smoothedRoundTrip;
+
+	/**
+	 * A krlfordulsi id ingadozsnak simtott rtke.
+	 */
+	std::chrono::nanoseconds roundTripVariation;
+
+	/**
+	 * Az eddig mrt krlfordulsi idk ltezst jelz bit.
+	 */
+	bool hasSamples;
+
+	/**
+	 * A mrsek s a lekrdezsek tbb szlrl val elrst klcsnsen kizr adattag.
+	 */
+	mutable std::mutex sampleMutex;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	AdaptivePeriod() = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param baud_rate A soros port adattviteli sebessge.
+	 */
+	explicit AdaptivePeriod(unsigned int baud_rate);
+
+	/**
+	 * @brief Kiszmtja egy teljes utasts s az arra rkez vlasz tviteli idejt a megadott adattviteli sebessgen.
+	 *
+	 * @param baud_rate A soros port adattviteli sebessge.
+	 * @return A legrvidebb biztonsgos lekrdezsi peridus.
+	 */
+	static std::chrono::nanoseconds minimumPeriod(unsigned int baud_rate);
+
+	/**
+	 * @brief Figyelembe vesz egy jabb mrt krlfordulsi idt.
+	 *
+	 * @param round_trip Az utasts elkldse s a vlasz berkezse kztt eltelt id.
+	 */
+	void addRoundTrip(std::chrono::nanoseconds round_trip);
+
+	/**
+	 * @brief Kiszmtja az aktulis lekrdezsi peridust. Ha egyszerre tbb lekrdezs is vlaszra vrhat, a krlfordulsi id
+	 * ennyi lekrdezs kztt oszlik meg.
+	 *
+	 * @param pipeline_depth Az egyszerre vlaszra vr lekrdezsek legnagyobb szma.
+	 * @return A lekrdezsi peridus, amely legalbb akkora, mint a legrvidebb biztonsgos peridus.
+	 */
+	std::chrono::nanoseconds period(unsigned int pipeline_depth) const;
+
+	/**
+	 * Egy utastskeret hossza bjtokban (kimenet rsa kt adatbjttal s a bemenet lekrdezse).
+	 */
+	static const unsigned int COMMAND_FRAME_SIZE;
+
+	/**
+	 * Egy vlaszkeret hossza bjtokban.
+	 */
+	static const unsigned int REPLY_FRAME_SIZE;
+
+	/**
+	 * Egy bjt tvitelhez szksges bitek szma a start- s a stopbittel egytt.
+	 */
+	static const unsigned int BITS_PER_BYTE;
+};
+
+#endif /* INC_ADAPTIVEPERIOD_H_ */
@@ -0,0 +1,44 @@
+#ifndef INC_ANSICONSOLE_H_
+#define INC_ANSICONSOLE_H_
+
+#include <inc\AbstractConsole.h>
+
+#include <string>
+
+/**
+ * @brief ANSI vezrlszekvencikkal r konzol, amely POSIX terminlokon s a virtulis terminl mdot ismer Windows konzolon is
+ * hasznlhat. Egy rskor az sszes karaktersorozatot egyetlen pufferbe gyjti, amelyet a kurzor helyzetnek mentse s
+ * visszalltsa fog kzre, s egyetlen kirssal kld a terminlnak. A koordintk a terminl lthat terletnek bal fels sarkhoz
+ * viszonytottak, ezrt a megjelentst a kperny trlse utn, a bal fels saroktl rdemes felpteni.
+ */
+class AnsiConsole: public AbstractConsole {
+	/**
+	 * A vezrlszekvencikat s a kirand karaktereket sszegyjt puffer, amely az rsok kztt megtartja a lefoglalt terlett.
+	 */
+	std::string buffer;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora. Windows rendszereken bekapcsolja a konzol virtulis terminl mdjt.
+	 */
+	AnsiConsole();
+
+	/**
+	 * @brief Az osztly virtulis destruktora.
+	 */
+	virtual ~AnsiConsole();
+
+	/**
+	 * @brief Trli a terminl kpernyjt s a kurzort a bal fels sarokba mozgatja.
+	 */
+	void clear();
+
+	/**
+	 * @brief Kirja a megadott karaktersorozatokat a terminlra egyetlen kirssal.
+	 *
+	 * @param runs A kirand karaktersorozatok.
+	 */
+	virtual void write(const std::vector<Run>& runs);
+};
+
+#endif /* INC_ANSICONSOLE_H_ */
@@ -0,0 +1,139 @@
+#ifndef INC_BATCHSIMULATOR_H_
+#define INC_BATCHSIMULATOR_H_
+
+#include <inc\BlockDiagram.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Egy lefordtott blokkdiagramot egyszerre 64 egymstl fggetlen bemeneti forgatknyvre kirtkel osztly. Minden rtk
+ * egy 64-bites sz, amelynek minden bitje egy-egy forgatknyvhz (svhoz) tartozik, gy a kapuk s a trolk egyetlen bitmvelettel
+ * mind a 64 svra kirtkeldnek. Az idztk s a szmllk svonknti lpsszmllval mkdnek, de csak azokon a svokon, ahol a
+ * bemenetk ezt szksgess teszi. A szimulci idben egyenletes lpsekben halad, egy lps a lekrdezs egy peridusnak felel
+ * meg, gy az eredmnye megegyezik a BlockDiagram ugyanilyen idkznknt lefuttatott ciklusaival.
+ */
+class BatchSimulator {
+public:
+	/**
+	 * Az egyszerre kirtkelt forgatknyvek (svok) szma.
+	 */
+	static const unsigned int LANES;
+
+	/**
+	 * A kimert bejrs sorn kirtkelt bemeneti llapotok szma.
+	 */
+	static const std::size_t INPUT_COMBINATIONS;
+
+private:
+	/**
+	 * A lefordtott kapcsols utastsai.
+	 */
+	std::vector<BlockDiagram::Instruction> program;
+
+	/**
+	 * Az utastsok operandusainak indexei az rtktmbben.
+	 */
+	std::vector<std::uint32_t> operands;
+
+	/**
+	 * A kimenetenknt meghajt rtk indexe, vagy nulla.
+	 */
+	std::uint32_t outputSources[16];
+
+	/**
+	 * Az idztk ideje lpsekben, felfel kerektve.
+	 */
+	std::vector<std::uint32_t> durationSteps;
+
+	/**
+	 * Az rtktmb svonknt egy bittel.
+	 */
+	std::vector<std::uint64_t> values;
+
+	/**
+	 * Az utastsok bemenetnek vagy rajelnek elz rtke svonknt.
+	 */
+	std::vector<std::uint64_t> previous;
+
+	/**
+	 * A trolk s az idztk llapota svonknt.
+	 */
+	std::vector<std::uint64_t> q;
+
+	/**
+	 * Az idztk utols indtsnak lpse, illetve a szmllk rtke, utastsonknt LANES elemmel.
+	 */
+	std::vector<std::uint32_t> laneData;
+
+	/**
+	 * Az eddig lefuttatott lpsek szma.
+	 */
+	std::uint32_t stepCount;
+
+	/**
+	 * @brief Megkeresi a legalacsonyabb helyirtk egyes bitet.
+	 *
+	 * @param word A nem nulla sz.
+	 * @return A legalacsonyabb helyirtk egyes bit sorszma.
+	 */
+	static unsigned int countTrailingZeros(std::uint64_t word);
+
+public:
+	/**
+	 * @brief Az osztly konstruktora. A kapcsols a konstruktorban lemsolsra kerl. Nulla lpskz esetn std::invalid_argument
+	 * kivtelt dob.
+	 *
+	 * @param diagram A lefordtott blokkdiagram.
+	 * @param step_time Egy lps idtartama, az idztk lpsszmnak meghatrozshoz.
+	 */
+	BatchSimulator(const BlockDiagram& diagram, std::chrono::nanoseconds step_time);
+
+	/**
+	 * @brief Minden svon alaphelyzetbe lltja a trolkat, az idztket s a szmllkat.
+	 */
+	void reset();
+
+	/**
+	 * @brief Lefuttat egy lpst mind a 64 svon.
+	 *
+	 * @param inputs A bemenetek rtkei bemenetenknt egy szban, amelynek i. bitje az i. sv bemenete.
+	 * @param outputs A kimenetek rtkei ugyanilyen elrendezsben. A kapcsols ltal nem meghajtott kimenetek nullk.
+	 */
+	void step(const std::uint64_t inputs[16], std::uint64_t outputs[16]);
+
+	/**
+	 * @brief Lefuttat egy lpst mind a 64 svon, svonknt egy 16-bites szval megadott bemenetekkel.
+	 *
+	 * @param inputs A svok 16-bites bemeneti llapotai, LANES elem.
+	 * @param outputs A svok 16-bites kimeneti llapotai, LANES elem.
+	 */
+	void step(const std::uint16_t inputs[], std::uint16_t outputs[]);
+
+	/**
+	 * @brief Kirtkeli a kapcsolst mind a 65536 bemeneti llapotra, mindegyikre alaphelyzetbl indtott egyetlen lpssel.
+	 *
+	 * @return A kimeneti llapotok a bemeneti llapotok sorrendjben.
+	 */
+	std::vector<std::uint16_t> sweep();
+
+	/**
+	 * @brief trendezi a svonknti 16-bites szavakat bitenknti 64-bites szavakk.
+	 *
+	 * @param words A svok 16-bites szavai, LANES elem.
+	 * @param lanes A bitek svonknti rtkei bitenknt egy szban.
+	 */
+	static void toLanes(const std::uint16_t words[], std::uint64_t lanes[16]);
+
+	/**
+	 * @brief trendezi a bitenknti 64-bites szavakat svonknti 16-bites szavakk.
+	 *
+	 * @param lanes A bitek svonknti rtkei bitenknt egy szban.
+	 * @param words A svok 16-bites szavai, LANES elem.
+	 */
+	static void fromLanes(const std::uint64_t lanes[16], std::uint16_t words[]);
+};
+
+#endif /* INC_BATCHSIMULATOR_H_ */
@@ -0,0 +1,217 @@
+#ifndef INC_BLOCKDIAGRAM_H_
+#define INC_BLOCKDIAGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A BORIS logikai blokkdiagramjainak megfelel kapcsolsokat az I/O interfsz bemenetein futtat osztly. A kapcsols szveges
+ * blokklistbl tltdik be, soronknt egy blokkal vagy kimenettel, a # utni rsz megjegyzs:
+ *
+ *   a   = AND I03 b          Kapuk: AND, OR, XOR, NAND, NOR tetszleges szm bemenettel, NOT egy bemenettel.
+ *   b   = NOT I07
+ *   ff  = RS I00 I01         Trolk: RS (trls elsbbsggel), SR (bers elsbbsggel), D <adat> <rajel>, T <rajel>.
+ *   t1  = TON a 50ms         Idztk: TON (bekapcsolsi ksleltets), TOF (kikapcsolsi ksleltets), TP (impulzus).
+ *   c   = CTU I02 I04 5      Szmll: CTU <szmll bemenet> <trls> <elrt rtk>, a kimenete az elrt rtk elrsekor 1.
+ *   Q05 = t1                 Kimenet: egy blokk, bemenet vagy konstans (0, 1) rtke, vagy kzvetlenl egy blokk.
+ *
+ * A blokkok a bemenetekre (I00-I15), egymsra, a kimenetekre s a 0, 1 konstansokra hivatkozhatnak, a sorrendjktl fggetlenl.
+ * Betltskor a blokkok a fggsgeik szerint topologikusan rendezett, lapos utaststmbb fordulnak, amelynek minden eleme az
+ * rtktmb indexeire hivatkozik, gy egy ciklus egyetlen lineris bejrs. A visszacsatolsokat (pldul ntart krt) a rendezs
+ * az elz ciklus rtkvel bontja fel, ahogy a BORIS szimulcis lpsei is. Az idztk a ciklusok idblyegei alapjn mkdnek,
+ * gy a felbontsuk a lekrdezs peridusa.
+ */
+class BlockDiagram {
+public:
+	/**
+	 * @brief Az utastsok mveletei.
+	 */
+	enum class Opcode {
+		AND, OR, XOR, NAND, NOR, NOT, COPY, RS, SR, D, T, TON, TOF, TP, CTU
+	};
+
+	/**
+	 * @brief A lefordtott kapcsols egy utastsa.
+	 */
+	struct Instruction {
+		/**
+		 * Az utasts mvelete.
+		 */
+		Opcode opcode;
+
+		/**
+		 * Az eredmny indexe az rtktmbben.
+		 */
+		std::uint32_t result;
+
+		/**
+		 * Az els operandus indexe az operandusok tmbjben.
+		 */
+		std::uint32_t firstOperand;
+
+		/**
+		 * Az operandusok szma.
+		 */
+		std::uint32_t operandCount;
+
+		/**
+		 * Az idztk ideje.
+		 */
+		std::chrono::nanoseconds duration;
+
+		/**
+		 * A szmllk elrt rtke.
+		 */
+		std::uint32_t preset;
+	};
+
+	/**
+	 * Az rtktmbben a 0 konstans indexe. Az 1 konstans a kvetkez, utna az I00-I15 bemenetek kvetkeznek.
+	 */
+	static const std::uint32_t CONSTANT_ZERO;
+
+	/**
+	 * Az rtktmbben az I00 bemenet indexe.
+	 */
+	static const std::uint32_t FIRST_INPUT;
+
+	/**
+	 * Az rtktmbben az els blokk indexe.
+	 */
+	static const std::uint32_t FIRST_BLOCK;
+
+private:
+	/**
+	 * @brief Egy utasts llapota a ciklusok kztt.
+	 */
+	struct BlockState {
+		/**
+		 * Az rajel vagy az idzt bemenetnek elz rtke az lek felismershez.
+		 */
+		bool previous;
+
+		/**
+		 * A trolk s az impulzus llapota.
+		 */
+		bool q;
+
+		/**
+		 * Az idzt utols indtsnak idpontja.
+		 */
+		std::chrono::steady_clock::time_point since;
+
+		/**
+		 * A szmll rtke.
+		 */
+		std::uint32_t count;
+	};
+
+	/**
+	 * A topologikusan rendezett utastsok.
+	 */
+	std::vector<Instruction> program;
+
+	/**
+	 * Az utastsok operandusainak indexei az rtktmbben, utastsonknt sszefgg tartomnyban.
+	 */
+	std::vector<std::uint32_t> operands;
+
+	/**
+	 * Az utastsok llapotai, az utastsokkal azonos sorrendben.
+	 */
+	std::vector<BlockState> states;
+
+	/**
+	 * Az rtktmb: a konstansok, a bemenetek s a blokkok kimenetei. A ciklusok kztt megmarad, gy a visszacsatolsok az elz
+	 * ciklus rtkt olvassk.
+	 */
+	std::vector<std::uint8_t> values;
+
+	/**
+	 * A kimenetenknt meghajt rtk indexe, vagy nulla, ha a kapcsols nem hajtja meg a kimenetet.
+	 */
+	std::uint32_t outputSources[16];
+
+	/**
+	 * A kapcsols ltal meghajtott kimenetek maszkja.
+	 */
+	std::uint16_t outputMask;
+
+	/**
+	 * A rendezs sorn az elz ciklus rtkvel felbontott visszacsatolsok szma.
+	 */
+	std::size_t feedbackCount;
+
+	/**
+	 * @brief Beolvas egy idtartamot <n>ms, <n>us vagy <n>s alakban.
+	 *
+	 * @param token Az idtartam.
+	 * @return Az idtartam.
+	 */
+	static std::chrono::nanoseconds parseDuration(const std::string& token);
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora, res kapcsolssal.
+	 */
+	BlockDiagram();
+
+	/**
+	 * @brief Betlti s lefordtja a kapcsolst a blokklistbl. Hibs blokklista esetn std::invalid_argument kivtelt dob, amelynek
+	 * zenete a hibs sor szmval kezddik.
+	 *
+	 * @param input A blokklistt tartalmaz adatfolyam.
+	 */
+	void load(std::istream& input);
+
+	/**
+	 * @brief Alaphelyzetbe lltja a trolkat, az idztket s a szmllkat.
+	 */
+	void reset();
+
+	/**
+	 * @brief Lefuttat egy ciklust a megadott bemeneti llapottal.
+	 *
+	 * @param input A 16-bites bemeneti llapot.
+	 * @param now A ciklus idpontja az idztkhz.
+	 * @return A kimenetek j llapota; csak a getOutputMask() ltal kijellt bitek rvnyesek.
+	 */
+	std::uint16_t run(std::uint16_t input, std::chrono::steady_clock::time_point now);
+
+	/**
+	 * @return A kapcsols ltal meghajtott kimenetek maszkja.
+	 */
+	std::uint16_t getOutputMask() const;
+
+	/**
+	 * @return A lefordtott utastsok szma.
+	 */
+	std::size_t getInstructionCount() const;
+
+	/**
+	 * @return A rendezs sorn az elz ciklus rtkvel felbontott visszacsatolsok szma.
+	 */
+	std::size_t getFeedbackCount() const;
+
+	/**
+	 * @return A topologikusan rendezett utastsok, pldul egy msik kirtkel szmra.
+	 */
+	const std::vector<Instruction>& getProgram() const;
+
+	/**
+	 * @return Az utastsok operandusainak indexei az rtktmbben.
+	 */
+	const std::vector<std::uint32_t>& getOperands() const;
+
+	/**
+	 * @param output A kimenet sorszma.
+	 * @return A kimenetet meghajt rtk indexe az rtktmbben, vagy nulla, ha a kapcsols nem hajtja meg a kimenetet.
+	 */
+	std::uint32_t getOutputSource(unsigned int output) const;
+};
+
+#endif /* INC_BLOCKDIAGRAM_H_ */
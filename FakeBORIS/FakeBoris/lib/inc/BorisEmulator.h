@@ -0,0 +1,349 @@
+#ifndef INC_BORISEMULATOR_H_
+#define INC_BORISEMULATOR_H_
+
+#include <inc\AbstractTransport.h>
+#include <AsyncSerial\AsyncSerial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A CO3715-1H tpus, 16 bemenet s 16 kimenet I/O interfsz viselkedst utnz virtulis eszkz. Az tvitel eszkzoldali
+ * vgn fogadja a 0xBA kimenetbellt s a 0xB9 bemenet-lekrdez utastsokat, a lekrdezsekre pedig a belltott ksleltetssel,
+ * szrssal s darabolssal vlaszol, gy a FakeBoris lekrdezsi sebessge s ksleltetse fizikai eszkz nlkl is terhelhet.
+ */
+class BorisEmulator {
+public:
+	/**
+	 * @brief A bemeneti jelalak egy szakasza: a bemenetek llapota s az az idtartam, ameddig ez az llapot fennll.
+	 */
+	struct InputStep {
+		/**
+		 * A szakasz hossza.
+		 */
+		std::chrono::nanoseconds duration;
+
+		/**
+		 * A 16-bites bemeneti llapot a szakasz alatt.
+		 */
+		std::uint16_t value;
+	};
+
+	/**
+	 * @brief A kimenetek megvltozsakor meghvott fggvny tpusa. Paramtere az j 16-bites kimeneti llapot.
+	 */
+	typedef std::function<void (std::uint16_t)> OutputHandler;
+
+private:
+	/**
+	 * Egy idztetten kikldend vlasz vagy vlaszdarab.
+	 */
+	struct PendingReply {
+		/**
+		 * A kiklds idpontja.
+		 */
+		std::chrono::steady_clock::time_point deadline;
+
+		/**
+		 * A kikldend bjtok.
+		 */
+		char data[2];
+
+		/**
+		 * A kikldend bjtok szma.
+		 */
+		std::size_t size;
+	};
+
+	/**
+	 * Az I/O interfsz kimeneteit bellt utasts.
+	 */
+	static const unsigned char CMD_WRITE_OUTPUT;
+
+	/**
+	 * Az I/O interfsz bemeneteit beolvas utasts.
+	 */
+	static const unsigned char CMD_READ_INPUT;
+
+	/**
+	 * Az eszkzoldali kapcsolatot ltrehoz tvitel.
+	 */
+	const std::unique_ptr<AbstractTransport> transport;
+
+	/**
+	 * Az eszkzoldali aszinkron kommunikcit megvalst objektum.
+	 */
+	CallbackAsyncSerial serialPort;
+
+	/**
+	 * A lekrdezsek s a vlaszok kztti legkisebb ksleltets.
+	 */
+	std::chrono::nanoseconds latency;
+
+	/**
+	 * A ksleltetshez adott, egyenletes eloszls vletlen tbblet legnagyobb rtke.
+	 */
+	std::chrono::nanoseconds jitter;
+
+	/**
+	 * A vlaszok darabjainak mrete bjtokban, vagy nulla, ha a vlaszok egyben kerlnek kikldsre.
+	 */
+	std::size_t fragmentSize;
+
+	/**
+	 * A vlaszdarabok kikldse kztti sznet.
+	 */
+	std::chrono::nanoseconds fragmentGap;
+
+	/**
+	 * Egy bjt tviteli ideje a szimullt vonalon (egy start-, nyolc adat- s egy stopbit), vagy nulla, ha a vonal nincs szimullva.
+	 */
+	std::chrono::nanoseconds byteTime;
+
+	/**
+	 * A legutbb fogadott bjt berkezsnek idpontja a szimullt vonalon. A bjtok legfeljebb a vonal sebessgvel rkezhetnek meg.
+	 */
+	std::chrono::steady_clock::time_point receiveClock;
+
+	/**
+	 * A bemeneti jelalak szakaszai, amelyek a vgk utn ellrl ismtldnek. res jelalak esetn a bemenet lland.
+	 */
+	std::vector<InputStep> inputScript;
+
+	/**
+	 * A bemeneti jelalak teljes hossza.
+	 */
+	std::chrono::nanoseconds scriptLength;
+
+	/**
+	 * Az lland bemeneti llapot, ha nincs jelalak belltva.
+	 */
+	std::uint16_t constantInput;
+
+	/**
+	 * Az eszkz indtsnak idpontja, a jelalak ehhez kpest jtszdik le.
+	 */
+	std::chrono::steady_clock::time_point startTime;
+
+	/**
+	 * A flig berkezett utasts bjtjai. Csak a berkezett bjtokat feldolgoz szl hasznlja.
+	 */
+	unsigned char command[3];
+
+	/**
+	 * A flig berkezett utasts eddig berkezett bjtjainak szma.
+	 */
+	std::size_t commandLength;
+
+	/**
+	 * A legutbb belltott 16-bites kimeneti llapot.
+	 */
+	std::atomic<std::uint16_t> output;
+
+	/**
+	 * A kimenetek megvltozsakor meghvott fggvny.
+	 */
+	OutputHandler outputHandler;
+
+	/**
+	 * A kikldsre vr vlaszok a kiklds sorrendjben.
+	 */
+	std::deque<PendingReply> replies;
+
+	/**
+	 * A legutbb temezett vlasz kikldsnek idpontja. A vlaszok a valdi eszkzhz hasonlan sorrendben indulnak.
+	 */
+	std::chrono::steady_clock::time_point lastDeadline;
+
+	/**
+	 * A vlaszok sornak tbb szlrl val elrst klcsnsen kizr adattag.
+	 */
+	std::mutex replyMutex;
+
+	/**
+	 * A vlaszokat kikld szl bresztst biztost adattag.
+	 */
+	std::condition_variable replyCondition;
+
+	/**
+	 * A vlaszokat kikld szl futst jelz bit.
+	 */
+	bool running;
+
+	/**
+	 * A vlaszokat idztetten kikld szl.
+	 */
+	std::thread replyThread;
+
+	/**
+	 * A ksleltets szrst elllt vletlenszm-genertor.
+	 */
+	std::mt19937 random;
+
+	/**
+	 * A fogadott kimenetbellt utastsok szma.
+	 */
+	std::atomic<unsigned long long int> writeCount;
+
+	/**
+	 * A fogadott bemenet-lekrdezsek szma.
+	 */
+	std::atomic<unsigned long long int> readCount;
+
+	/**
+	 * Az ismeretlen utastsknt eldobott bjtok szma.
+	 */
+	std::atomic<unsigned long long int> unknownCount;
+
+	/**
+	 * @brief Feldolgozza a berkezett bjtokat: sszelltja bellk az utastsokat s vgrehajtja azokat.
+	 *
+	 * @param data A berkezett bjtok els elemre mutat pointer.
+	 * @param size A berkezett bjtok szma.
+	 */
+	void receive(const char* data, std::size_t size);
+
+	/**
+	 * @brief sszelltja s temezi a bemenet-lekrdezsre adott vlaszt.
+	 *
+	 * @param now A lekrdezs berkezsnek idpontja.
+	 */
+	void reply(std::chrono::steady_clock::time_point now);
+
+	/**
+	 * @brief A vlaszokat kikld szl trzse, amelyik a kikldsi idpontjukban kikldi a sorban vrakoz vlaszokat.
+	 */
+	void sendReplies();
+
+	/**
+	 * @brief Meghatrozza a bemenetek llapott a megadott idpontban.
+	 *
+	 * @param now Az idpont.
+	 * @return A 16-bites bemeneti llapot.
+	 */
+	std::uint16_t inputAt(std::chrono::steady_clock::time_point now) const;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	BorisEmulator() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	BorisEmulator(BorisEmulator&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	BorisEmulator& operator=(const BorisEmulator&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param transport_layer Az eszkzoldali kapcsolatot ltrehoz tvitel.
+	 */
+	explicit BorisEmulator(std::unique_ptr<AbstractTransport> transport_layer);
+
+	/**
+	 * @brief Az osztly destruktora. Lelltja az eszkzt.
+	 */
+	~BorisEmulator();
+
+	/**
+	 * @brief Belltja a lekrdezsek megvlaszolsnak ksleltetst. Csak az eszkz elindtsa eltt hvhat.
+	 *
+	 * @param reply_latency A legkisebb ksleltets.
+	 * @param reply_jitter A ksleltetshez adott vletlen tbblet legnagyobb rtke.
+	 */
+	void setLatency(std::chrono::nanoseconds reply_latency, std::chrono::nanoseconds reply_jitter);
+
+	/**
+	 * @brief Belltja a vlaszok darabolst, amellyel a lass vagy pufferel talaktk viselkedse utnozhat. Csak az eszkz
+	 * elindtsa eltt hvhat.
+	 *
+	 * @param fragment_size A darabok mrete bjtokban, vagy nulla a darabols kikapcsolshoz.
+	 * @param fragment_gap A darabok kikldse kztti sznet.
+	 */
+	void setFragmentation(std::size_t fragment_size, std::chrono::nanoseconds fragment_gap);
+
+	/**
+	 * @brief Belltja a szimullt soros vonal adattviteli sebessgt. Az utastsok bjtjai s a vlaszok ekkor legfeljebb ezzel a
+	 * sebessggel haladnak, gy pszeudoterminlon vagy hurkon keresztl is a valdi vonalnak megfelel krlfordulsi idk mrhetk.
+	 * Csak az eszkz elindtsa eltt hvhat.
+	 *
+	 * @param baud_rate Az adattviteli sebessg, vagy nulla a szimulci kikapcsolshoz.
+	 */
+	void setLineRate(unsigned int baud_rate);
+
+	/**
+	 * @brief lland bemeneti llapotot llt be. Csak az eszkz elindtsa eltt hvhat.
+	 *
+	 * @param value A 16-bites bemeneti llapot.
+	 */
+	void setInput(std::uint16_t value);
+
+	/**
+	 * @brief Belltja a bemenetek ismtld jelalakjt, amely az eszkz indtsakor kezddik. Csak az eszkz elindtsa eltt hvhat.
+	 *
+	 * @param script A jelalak szakaszai, vagy res vektor az lland bemenethez.
+	 */
+	void setInputScript(const std::vector<InputStep>& script);
+
+	/**
+	 * @brief Belltja a kimenetek megvltozsakor meghvott fggvnyt. A fggvny a berkezett bjtokat feldolgoz szlon hvdik meg.
+	 *
+	 * @param handler A meghvand fggvny.
+	 */
+	void setOutputHandler(const OutputHandler& handler);
+
+	/**
+	 * @brief Ltrehozza az eszkzoldali kapcsolatot s elindtja az utastsok fogadst. Sikertelen kapcsolds esetn
+	 * boost::system::system_error kivtelt dob.
+	 */
+	void start();
+
+	/**
+	 * @brief Lelltja az utastsok fogadst s bontja a kapcsolatot.
+	 */
+	void stop();
+
+	/**
+	 * @return Az tvitel rvid lersa, amelybl kiderl, hogy a FakeBoris hol csatlakozhat.
+	 */
+	std::string describe() const;
+
+	/**
+	 * @return A legutbb belltott 16-bites kimeneti llapot.
+	 */
+	std::uint16_t getOutput() const;
+
+	/**
+	 * @return A fogadott kimenetbellt utastsok szma.
+	 */
+	unsigned long long int getWriteCount() const;
+
+	/**
+	 * @return A fogadott bemenet-lekrdezsek szma.
+	 */
+	unsigned long long int getReadCount() const;
+
+	/**
+	 * @return Az ismeretlen utastsknt eldobott bjtok szma.
+	 */
+	unsigned long long int getUnknownCount() const;
+};
+
+#endif /* INC_BORISEMULATOR_H_ */
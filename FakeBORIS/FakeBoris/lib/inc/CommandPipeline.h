@@ -0,0 +1,268 @@
+#ifndef INC_COMMANDPIPELINE_H_
+#define INC_COMMANDPIPELINE_H_
+
+#include <inc\ReplyDecoder.h>
+#include <inc\TrafficRecorder.h>
+#include <AsyncSerial\AsyncSerial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief A soros port fltti tranzakcis rteg, amelyik nyilvntartja a vlaszra vr bemenet-lekrdezseket. A vlaszokat a
+ * klds sorrendjben prostja a lekrdezsekhez, a tl rgta vlaszra vr lekrdezseket lejrtnak tekinti, a lejrt lekrdezsek
+ * ksve rkez vlaszait pedig nem prostja a ksbbi lekrdezsekhez. Egyszerre legfeljebb a belltott szm lekrdezst enged a
+ * vonalon, gy nagy adattviteli sebessgen is folyamatosan kihasznlhat a vonal.
+ */
+class CommandPipeline {
+public:
+	/**
+	 * @brief A dekdolt vlaszokat feldolgoz fggvny tpusa. Paramterei a 16-bites bemeneti llapot, a vlasz berkezsnek
+	 * idpontja s a lekrdezs krlfordulsi ideje (ksve rkezett vlasz esetn nulla).
+	 */
+	typedef std::function<void (std::uint16_t, std::chrono::steady_clock::time_point, std::chrono::nanoseconds)> ReplyHandler;
+
+private:
+	/**
+	 * A vlaszra vr lekrdezsek nyilvntartsnak mrete, egyben a bellthat legnagyobb mlysg.
+	 */
+	static const std::size_t MAX_DEPTH = 16;
+
+	/**
+	 * Az egy olvassbl egyszerre dekdolt vlaszok legnagyobb szma, mieltt a feldolgoz fggvny meghvsra kerl.
+	 */
+	static const std::size_t REPLY_BATCH_SIZE = 16;
+
+	/**
+	 * A lekrdezseket tovbbt soros port.
+	 */
+	CallbackAsyncSerial& serialPort;
+
+	/**
+	 * A vlaszokat tetszlegesen darabolt vagy sszevont olvassokbl jra sszellt dekdol.
+	 */
+	ReplyDecoder decoder;
+
+	/**
+	 * A vlaszra vr lekrdezsek elkldsi idpontjai a klds sorrendjben, gyrpufferben trolva.
+	 */
+	std::chrono::steady_clock::time_point outstanding[MAX_DEPTH];
+
+	/**
+	 * A legrgebbi vlaszra vr lekrdezs folyamatosan nvekv sorszma.
+	 */
+	std::size_t head;
+
+	/**
+	 * A kvetkez lekrdezs folyamatosan nvekv sorszma.
+	 */
+	std::size_t tail;
+
+	/**
+	 * A lejrt, de mg meg nem vlaszolt lekrdezsek szma. Ennyi dekdolt vlasz a lejrt lekrdezsek ksett vlasznak szmt, s
+	 * nem kerl prostsra a vlaszra vr lekrdezsekhez.
+	 */
+	std::size_t expiredPending;
+
+	/**
+	 * Az utols, lejrt lekrdezs ksett vlaszaknt kezelt vlasz berkezsnek idpontja.
+	 */
+	std::chrono::steady_clock::time_point lastLateReply;
+
+	/**
+	 * Az egyszerre vlaszra vr lekrdezsek legnagyobb szma.
+	 */
+	unsigned int depth;
+
+	/**
+	 * Az az idtartam, amelynl rgebben vlaszra vr lekrdezst a rteg lejrtnak tekint.
+	 */
+	std::chrono::nanoseconds timeout;
+
+	/**
+	 * A dekdolt vlaszokat feldolgoz fggvny.
+	 */
+	ReplyHandler replyHandler;
+
+	/**
+	 * A kikldtt s a berkezett bjtokat rgzt objektum, vagy nullpointer, ha nincs rgzts.
+	 */
+	TrafficRecorder* recorder;
+
+	/**
+	 * A nyilvntartst tbb szlrl val elrst klcsnsen kizr adattag.
+	 */
+	std::mutex pipelineMutex;
+
+	/**
+	 * Az elkldtt lekrdezsek szma.
+	 */
+	std::atomic<unsigned long long int> requestCount;
+
+	/**
+	 * A megvlaszolt lekrdezsek szma.
+	 */
+	std::atomic<unsigned long long int> completedCount;
+
+	/**
+	 * A lejrt lekrdezsek szma.
+	 */
+	std::atomic<unsigned long long int> timeoutCount;
+
+	/**
+	 * A lekrdezshez nem prosthat, ksve rkezett vlaszok szma.
+	 */
+	std::atomic<unsigned long long int> lateCount;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	CommandPipeline() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	CommandPipeline(CommandPipeline&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	CommandPipeline& operator=(const CommandPipeline&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param port A lekrdezseket tovbbt soros port.
+	 */
+	explicit CommandPipeline(CallbackAsyncSerial& port);
+
+	/**
+	 * @brief Belltja az egyszerre vlaszra vr lekrdezsek legnagyobb szmt.
+	 *
+	 * @param pipeline_depth A lekrdezsek legnagyobb szma 1 s 16 kztt.
+	 */
+	void setDepth(unsigned int pipeline_depth);
+
+	/**
+	 * @return Az egyszerre vlaszra vr lekrdezsek legnagyobb szma.
+	 */
+	unsigned int getDepth() const;
+
+	/**
+	 * @brief Belltja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a rteg lejrtnak tekint.
+	 *
+	 * @param request_timeout A lekrdezsek lejrati ideje.
+	 */
+	void setTimeout(std::chrono::nanoseconds request_timeout);
+
+	/**
+	 * @brief Visszaadja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a rteg lejrtnak tekint.
+	 *
+	 * @return A lekrdezsek lejrati ideje.
+	 */
+	std::chrono::nanoseconds getTimeout();
+
+	/**
+	 * @brief Belltja azt az idtartamot, amelynl rgebbi befejezetlen vlaszt a dekdol eldob.
+	 *
+	 * @param frame_gap Az eldobs idkszbe.
+	 */
+	void setFrameGap(std::chrono::nanoseconds frame_gap);
+
+	/**
+	 * @brief Belltja a dekdolt vlaszokat feldolgoz fggvnyt. A fggvny a soros port olvassnak szln hvdik meg.
+	 *
+	 * @param handler A vlaszokat feldolgoz fggvny.
+	 */
+	void setReplyHandler(const ReplyHandler& handler);
+
+	/**
+	 * @brief Belltja a kikldtt s a berkezett bjtokat rgzt objektumot. A kikldtt bjtok csak akkor kerlnek rgztsre, amikor
+	 * a soros port tadja ket az eszkznek, gy a kimeneti sorban eldobott vagy fellrt utastsok kimaradnak. Csak az adatcsere
+	 * elindtsa eltt hvhat.
+	 *
+	 * @param traffic_recorder A rgzt objektum, vagy nullpointer a rgzts kikapcsolshoz.
+	 */
+	void setRecorder(TrafficRecorder* traffic_recorder);
+
+	/**
+	 * @brief Elkld egy utastssorozatot a soros porton. Ha az utastssorozat egy bemenet-lekrdezssel vgzdik, akkor az csak akkor
+	 * kerl elkldsre, ha a vlaszra vr lekrdezsek szma mg nem rte el a belltott mlysget. Ha a soros port korltos kimeneti
+	 * sora eldobja az utastssorozatot, a lekrdezs nem kerl a vlaszra vr lekrdezsek kz.
+	 *
+	 * @param data Az utastssorozat els elemre mutat pointer.
+	 * @param size Az utastssorozat hossza.
+	 * @param expects_reply Igaz, ha az utastssorozat egy vlaszra vr bemenet-lekrdezssel vgzdik.
+	 * @return Igaz, ha az utastssorozat a kimeneti sorba kerlt.
+	 */
+	bool send(const char* data, std::size_t size, bool expects_reply);
+
+	/**
+	 * @brief Elkld egy llapotbellt utastst a soros porton, amelynek csak a legjabb rtke szmt. Ha egy korbbi, azonos
+	 * utastskd s hosszsg utasts mg a kimeneti sorban vrakozik, akkor az j utasts annak helyre kerl, gy lass vonalon
+	 * sem gylnek fel elavult llapotok.
+	 *
+	 * @param data Az utasts els elemre mutat pointer.
+	 * @param size Az utasts hossza.
+	 * @return Igaz, ha az utasts a kimeneti sorba kerlt, hamis, ha a korltos kimeneti sor eldobta.
+	 */
+	bool sendState(const char* data, std::size_t size);
+
+	/**
+	 * @brief Feldolgozza a soros porton berkezett bjtokat, a teljes vlaszokat prostja a vlaszra vr lekrdezsekhez s tadja
+	 * ket a feldolgoz fggvnynek.
+	 *
+	 * @param data A berkezett bjtok els elemre mutat pointer.
+	 * @param size A berkezett bjtok szma.
+	 */
+	void receive(const char* data, std::size_t size);
+
+	/**
+	 * @brief Lejrtnak tekinti s eltvoltja a nyilvntartsbl a tl rgta vlaszra vr lekrdezseket.
+	 *
+	 * @param now Az aktulis idpont.
+	 */
+	void expire(std::chrono::steady_clock::time_point now);
+
+	/**
+	 * @brief Trli a vlaszra vr lekrdezsek nyilvntartst.
+	 */
+	void reset();
+
+	/**
+	 * @return A vlaszra vr lekrdezsek szma.
+	 */
+	unsigned int getOutstanding();
+
+	/**
+	 * @return Az elkldtt lekrdezsek szma.
+	 */
+	unsigned long long int getRequestCount() const;
+
+	/**
+	 * @return A megvlaszolt lekrdezsek szma.
+	 */
+	unsigned long long int getCompletedCount() const;
+
+	/**
+	 * @return A lejrt lekrdezsek szma.
+	 */
+	unsigned long long int getTimeoutCount() const;
+
+	/**
+	 * @return A lekrdezshez nem prosthat, ksve rkezett vlaszok szma.
+	 */
+	unsigned long long int getLateCount() const;
+
+	/**
+	 * @return A vlaszok dekdolja a dekdolsi statisztikk lekrdezshez.
+	 */
+	const ReplyDecoder& getDecoder() const;
+};
+
+#endif /* INC_COMMANDPIPELINE_H_ */
@@ -0,0 +1,189 @@
+#ifndef INC_CONSOLERENDERER_H_
+#define INC_CONSOLERENDERER_H_
+
+#include <inc\AbstractScheduler.h>
+#include <inc\AbstractConsole.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A konzolkperny egy tglalap alak terlett kpkocknknt frisst osztly. A megjelentend karaktereket egy
+ * rnykpufferben gyjti, amelynek rsa csak egy rvid zrolssal jr, s a konzolt nem ri el. Sajt szln, korltozott
+ * kpkockasebessggel sszeveti a puffert a kpernyn lv tartalommal, s csak a megvltozott karaktereket rja ki, soronknt
+ * sszefgg karaktersorozatokba gyjtve, egyetlen konzolrssal. Ha kt megvltozott karakter kztt csak nhny ismert, vltozatlan
+ * karakter ll, azokat is jrarja, hogy egy sor egyetlen karaktersorozatba frjen.
+ */
+class ConsoleRenderer: public AbstractScheduler {
+	/**
+	 * Kt megvltozott karakter kztt legfeljebb ennyi vltozatlan karakter llhat, hogy egy karaktersorozatba kerljenek.
+	 */
+	static const int MAX_RUN_GAP;
+
+	/**
+	 * Az alaprtelmezett kpkockasebessg msodpercenknt.
+	 */
+	static const unsigned int DEFAULT_FRAME_RATE;
+
+	/**
+	 * A karaktereket kir konzol.
+	 */
+	const std::unique_ptr<AbstractConsole> console;
+
+	/**
+	 * A konzolkpernyre tbb szlrl trtn rsi mveleteket klcsnsen kizr adattag, amelyet a konzolkperny tbbi rja is
+	 * hasznl.
+	 */
+	std::recursive_mutex& printLocker;
+
+	/**
+	 * Az rnykpuffer rsait klcsnsen kizr adattag.
+	 */
+	std::mutex frameMutex;
+
+	/**
+	 * A kpkockk kirajzolst klcsnsen kizr adattag.
+	 */
+	std::mutex renderMutex;
+
+	/**
+	 * A terlet bal fels sarknak X irny helyzete a konzol koordintarendszerben.
+	 */
+	int originX;
+
+	/**
+	 * A terlet bal fels sarknak Y irny helyzete a konzol koordintarendszerben.
+	 */
+	int originY;
+
+	/**
+	 * A terlet szlessge karakterekben.
+	 */
+	int width;
+
+	/**
+	 * A terlet magassga karakterekben.
+	 */
+	int height;
+
+	/**
+	 * A megjelentend karakterek soronknt, nulla rtkkel a mg ismeretlen pozcikon.
+	 */
+	std::vector<char> desired;
+
+	/**
+	 * A kpernyn lv karakterek soronknt, nulla rtkkel a mg ismeretlen pozcikon. Csak a kirajzols hasznlja.
+	 */
+	std::vector<char> shown;
+
+	/**
+	 * A kirajzols alatt ll kpkocka, amelyre a kirt karaktersorozatok mutatnak. Csak a kirajzols hasznlja.
+	 */
+	std::vector<char> frame;
+
+	/**
+	 * A kirajzols alatt ll kpkocka karaktersorozatai. Csak a kirajzols hasznlja.
+	 */
+	std::vector<AbstractConsole::Run> runs;
+
+	/**
+	 * Igaz, ha az rnykpuffer a legutbbi kirajzols ta megvltozott.
+	 */
+	bool dirty;
+
+	/**
+	 * A kpkockk kztti id.
+	 */
+	std::chrono::nanoseconds framePeriod;
+
+	/**
+	 * @brief Kirajzolja a kpkockt, ha az rnykpuffer megvltozott.
+	 */
+	virtual void performScheduledAction();
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	ConsoleRenderer() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	ConsoleRenderer(ConsoleRenderer&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	ConsoleRenderer& operator=(const ConsoleRenderer&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param console_output A karaktereket kir konzol.
+	 * @param print_locker A konzolkperny rsait klcsnsen kizr adattag, amelyet a kirajzols a konzolrs idejre zrol.
+	 */
+	ConsoleRenderer(std::unique_ptr<AbstractConsole> console_output, std::recursive_mutex& print_locker);
+
+	/**
+	 * @brief Az osztly virtulis destruktora. Lelltja a kirajzols szlt.
+	 */
+	virtual ~ConsoleRenderer();
+
+	/**
+	 * @brief Belltja a frisstett terletet s trli az rnykpuffert. Csak a kirajzols elindtsa eltt hvhat.
+	 *
+	 * @param x A terlet bal fels sarknak X irny helyzete a konzol koordintarendszerben.
+	 * @param y A terlet bal fels sarknak Y irny helyzete a konzol koordintarendszerben.
+	 * @param region_width A terlet szlessge karakterekben.
+	 * @param region_height A terlet magassga karakterekben.
+	 */
+	void setRegion(int x, int y, int region_width, int region_height);
+
+	/**
+	 * @brief Belltja a kpkockasebessget. Csak a kirajzols elindtsa eltt van hatsa.
+	 *
+	 * @param frames_per_second A kpkockk legnagyobb szma msodpercenknt.
+	 */
+	void setFrameRate(unsigned int frames_per_second);
+
+	/**
+	 * @brief Rgzti, hogy a megadott szveg mr a kpernyn van, pldul mert a terlet kerett a hv rajzolta ki. Az ismert
+	 * karakterek kz es vltozsok egyetlen karaktersorozatba olvaszthatk.
+	 *
+	 * @param x A szveg els karakternek X irny helyzete a konzol koordintarendszerben.
+	 * @param y A szveg Y irny helyzete a konzol koordintarendszerben.
+	 * @param text A kpernyn lv szveg.
+	 */
+	void assume(int x, int y, const std::string& text);
+
+	/**
+	 * @brief Belltja egy karakter megjelentend rtkt. A karakter a kvetkez kpkockban jelenik meg. A terleten kvli pozcik
+	 * rsa nem csinl semmit.
+	 *
+	 * @param x A karakter X irny helyzete a konzol koordintarendszerben.
+	 * @param y A karakter Y irny helyzete a konzol koordintarendszerben.
+	 * @param character A megjelentend karakter.
+	 */
+	void setCell(int x, int y, char character);
+
+	/**
+	 * @brief Kirajzolja a kpkockt, ha az rnykpuffer megvltozott. Brmelyik szlrl hvhat.
+	 */
+	void render();
+
+	/**
+	 * @brief Elindtja a kpkockk kirajzolst a belltott kpkockasebessggel.
+	 */
+	void start();
+
+	/**
+	 * @brief Lelltja a kpkockk kirajzolst, majd kirajzolja az utols kpkockt, hogy a kperny a legfrissebb llapotot mutassa.
+	 */
+	void stop();
+};
+
+#endif /* INC_CONSOLERENDERER_H_ */
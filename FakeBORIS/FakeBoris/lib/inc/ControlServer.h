@@ -0,0 +1,105 @@
+#ifndef INC_CONTROLSERVER_H_
+#define INC_CONTROLSERVER_H_
+
+#include <string>
+#include <thread>
+#include <boost\asio.hpp>
+#include <boost\function.hpp>
+
+/**
+ * @brief Helyi TCP porton soronknti szveges parancsokat fogad vezrl kiszolgl. Csak a visszacsatolsi cmen figyel, gy
+ * kizrlag ugyanarrl a gprl rhet el. Tetszleges szm kapcsolatot fogad egyszerre; a parancsokat a sajt szln, a berkezs
+ * sorrendjben adja t a parancskezel fggvnynek, s a visszaadott vlaszt a parancsot kld kapcsolaton kldi vissza.
+ */
+class ControlServer {
+public:
+	/**
+	 * @brief A parancskezel fggvny tpusa. A parancs sort kapja a sortrs nlkl, s a sortrssel lezrt vlaszt adja vissza.
+	 */
+	typedef boost::function<std::string(const std::string&)> CommandHandler;
+
+private:
+	/**
+	 * @brief Egy vezrl kapcsolat llapota.
+	 */
+	struct Session;
+
+	/**
+	 * Az aszinkron mveleteket futtat objektum.
+	 */
+	boost::asio::io_service io;
+
+	/**
+	 * A kapcsolatokat fogad objektum.
+	 */
+	boost::asio::ip::tcp::acceptor acceptor;
+
+	/**
+	 * A parancskezel fggvny.
+	 */
+	CommandHandler handler;
+
+	/**
+	 * Az aszinkron mveleteket futtat szl.
+	 */
+	std::thread serviceThread;
+
+	/**
+	 * @brief Elindtja a kvetkez kapcsolat fogadst.
+	 */
+	void accept();
+
+	/**
+	 * @brief Elindtja a kvetkez parancssor olvasst a kapcsolatrl.
+	 *
+	 * @param session A kapcsolat llapota.
+	 */
+	void read(boost::shared_ptr<Session> session);
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	ControlServer() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	ControlServer(ControlServer&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	ControlServer& operator=(const ControlServer&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora. Lefoglalja a portot a visszacsatolsi cmen. Foglalt port esetn boost::system::system_error
+	 * kivtelt dob.
+	 *
+	 * @param port_number A figyelt TCP port, vagy nulla, ha a portot az opercis rendszer vlassza ki.
+	 * @param command_handler A parancskezel fggvny.
+	 */
+	ControlServer(unsigned short port_number, const CommandHandler& command_handler);
+
+	/**
+	 * @brief Az osztly destruktora. Lelltja a kiszolglt s bontja a kapcsolatokat.
+	 */
+	~ControlServer();
+
+	/**
+	 * @return A figyelt TCP port.
+	 */
+	unsigned short getPort() const;
+
+	/**
+	 * @brief Elindtja a kapcsolatok fogadst a kiszolgl sajt szln.
+	 */
+	void start();
+
+	/**
+	 * @brief Lelltja a kiszolglt s bontja a kapcsolatokat.
+	 */
+	void stop();
+};
+
+#endif /* INC_CONTROLSERVER_H_ */
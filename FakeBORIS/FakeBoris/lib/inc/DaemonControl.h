@@ -0,0 +1,88 @@
+#ifndef INC_DAEMONCONTROL_H_
+#define INC_DAEMONCONTROL_H_
+
+#include <inc\PollEngine.h>
+
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @brief A konzol nlkl fut adatcsere soronknti szveges vezrlparancsait vgrehajt osztly. Ugyanazok a parancsok rkezhetnek
+ * a szabvnyos bemenetrl s a helyi vezrl kapcsolatokrl, minden parancsra egy vlaszsor rkezik, amely "ok" vagy "error" szval
+ * kezddik. A parancsok:
+ *
+ *   set <parancs>  A kimenetek mdostsa az OutputCommand formtumban, pldul set Q00-07=0xA5.
+ *   get            A bemenetek s a kimenetek llapota tizenhatos szmrendszerben.
+ *   stats          A lekrdezsek statisztikja.
+ *   quit           Az adatcsere lelltsa.
+ */
+class DaemonControl {
+	/**
+	 * A vezrelt adatcsere.
+	 */
+	PollEngine& engine;
+
+	/**
+	 * A lellts krsnek jelzst klcsnsen kizr adattag.
+	 */
+	std::mutex quitMutex;
+
+	/**
+	 * A lellts krsre vrakoztatst biztost adattag.
+	 */
+	std::condition_variable quitCondition;
+
+	/**
+	 * Igaz, ha valamelyik vezrl lelltst krt.
+	 */
+	bool quitRequested;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	DaemonControl() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	DaemonControl(DaemonControl&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	DaemonControl& operator=(const DaemonControl&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param poll_engine A vezrelt adatcsere.
+	 */
+	explicit DaemonControl(PollEngine& poll_engine);
+
+	/**
+	 * @brief Vgrehajt egy vezrlparancsot. Brmelyik szlrl hvhat.
+	 *
+	 * @param line A parancs sora, a sortrs nlkl.
+	 * @return A vlasz sortrssel lezrva, vagy res sztring res parancssor esetn.
+	 */
+	std::string execute(const std::string& line);
+
+	/**
+	 * @return Igaz, ha valamelyik vezrl lelltst krt.
+	 */
+	bool isQuitRequested();
+
+	/**
+	 * @brief Megvrja, hogy valamelyik vezrl lelltst krjen.
+	 */
+	void waitForQuit();
+
+	/**
+	 * @brief Lelltst kr, pldul mert a szabvnyos bemenet vget rt.
+	 */
+	void requestQuit();
+};
+
+#endif /* INC_DAEMONCONTROL_H_ */
@@ -1,8 +1,10 @@
 #ifndef INC_FAKEBORIS_H_
 #define INC_FAKEBORIS_H_
 
-#include <inc\AbstractScheduler.h>
-#include <AsyncSerial\AsyncSerial.h>
+#include <inc\PollEngine.h>
+#include <inc\OutputCommand.h>
+#include <inc\ConsoleRenderer.h>
+#include <inc\Win32Console.h>
 
 #include <string>
 #include <map>
@@ -10,15 +12,19 @@
 #include <Windows.h>
 #include <conio.h>
 #include <cctype>
-#include <bitset>
+#include <memory>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <boost\lexical_cast.hpp>
 
 /**
  * @brief A WinFACT szoftvercsomag Block-oriented Simulation (BORIS) szoftvernek soros porton keresztli kommunikcis jeleit utnoz
- * osztly. Kpes elhitetni a CO3715-1H tpus I/O interfsszel, hogy az emltett szoftverrel kommunikl.
+ * osztly. Kpes elhitetni a CO3715-1H tpus I/O interfsszel, hogy az emltett szoftverrel kommunikl. Az adatcsert a PollEngine
+ * vgzi, ez az osztly a Windows konzolon megjelenti az I/O interfsz llapott s bekri a kimenetek mdostsait.
  */
-class FakeBoris: public AbstractScheduler {
+class FakeBoris: public PollEngine {
+private:
 	/**
 	 * A fogadott jelek kijelzsnek sora a konzol koordintarendszerben.
 	 */
@@ -30,34 +36,9 @@ class FakeBoris: public AbstractScheduler {
 	SHORT outputLine;
 
 	/**
-	 * A soros port neve a Windows rendszerben.
-	 */
-	const std::string serialPortName;
-
-	/**
-	 * A soros port adattviteli sebessge.
-	 */
-	const unsigned int serialPortBaudRate;
-
-	/**
-	 * A soros ponton keresztli aszinkron kommunikcit megvalst objektum.
-	 */
-	CallbackAsyncSerial serialPort;
-
-	/**
-	 * A 16-bites kimenetet trol bitmez.
-	 */
-	std::bitset<16> output;
-	
-	/**
-	 * A kimenet rst s olvasst klcsnsen kizr adattag.
-	 */
-	std::recursive_mutex rwLocker;
-
-	/**
-	 * A konzolkpernyre tbb szlrl trtn rsi mveleteket klcsnsen kizr adattag.
+	 * A bemenetek s a kimenetek llapotait korltozott kpkockasebessggel, csak a vltozsokat kirva megjelent objektum.
 	 */
-	std::recursive_mutex printLocker;
+	ConsoleRenderer renderer;
 
 	/**
 	 * @brief Kirajzolja a konzolkpernyre az I/O interfszt brzol karakterkpet.
@@ -65,35 +46,36 @@ class FakeBoris: public AbstractScheduler {
 	inline void drawIODisplay();
 
 	/**
-	 * @brief Beolvassa a kimenet sorszmt s a belltani kvnt rtket a felhasznltl.
+	 * @brief Beolvas egy, a kimenetek llapotait mdost parancsot a felhasznltl. A kimenetek Q betjele s egyetlen kimenet utn az
+	 * egyenlsgjel automatikusan jelenik meg, gy a korbbi hromkarakteres bevitel (pldul 031) tovbbra is hasznlhat.
 	 *
-	 * @param stop_char A beolvasst megszakt, azonnal kilptet karakter.
-	 * @return A meghatrozott kimenet sorszma s a belltani kvnt rtk karakteresen tmrtve egy sztringben.
+	 * @param stop_char A beolvasst megszakt, res sorban azonnal kilptet karakter.
+	 * @return A bevitt parancs az OutputCommand formtumban, res sztring trls esetn, vagy "exit" a megszakt karakter esetn.
 	 */
 	std::string getNewSetting(char stop_char);
 
 	/**
-	 * @brief Kir egy karaktert a megadott pozcival a konzolkpernyre.
+	 * @brief Belltja a megjelentsben egy 16-bites llapot sszes bitjt. A bitek a kvetkez kpkockban jelennek meg.
 	 *
-	 * @param x A kirats X irny helyzete a konzol koordintarendszerben.
-	 * @param y A kirats Y irny helyzete a konzol koordintarendszerben.
-	 * @param character A kiratni kvnt karakter.
+	 * @param y Az llapot kijelzsnek sora a konzol koordintarendszerben.
+	 * @param value A megjelentend llapot.
+	 * @param mask A megjelentend bitek maszkja.
 	 */
-	void printCharAt(SHORT x, SHORT y, wchar_t character);
+	void showBits(SHORT y, std::uint16_t value, std::uint16_t mask);
 
 	/**
-	 * @brief Ismtld idkznknt elkldi az I/O interfsznek a belltott kimenetet s lekrdezi a bemenet llapott.
+	 * @brief Megjelenti a megvltozott bemeneti llapotot.
+	 *
+	 * @param value Az j 16-bites bemeneti llapot.
 	 */
-	virtual void performScheduledAction();
+	virtual void inputChanged(std::uint16_t value);
 
 	/**
-	 * @brief Fogadja a soros kommunikcis porton rkez zenetet az I/O interfsztl s a feldolgozst kveten mdostja a
-	 * konzolkpernyn a bemenetek llapotait.
+	 * @brief Megjelenti a reflexszablyok ltal megvltoztatott kimeneti llapotot.
 	 *
-	 * @param read_data A soros kommunikcis portra rkezett zenet els elemre mutat pointer.
-	 * @param data_size A soros kommunikcis portra rkezett zenet hossza.
+	 * @param value Az j 16-bites kimeneti llapot.
 	 */
-	void readIODevice(const char* input, size_t data_size);
+	virtual void outputChanged(std::uint16_t value);
 
 	/**
 	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
@@ -112,28 +94,47 @@ class FakeBoris: public AbstractScheduler {
 
 public:
 	/**
-	 * @brief Az osztly konstruktora.
+	 * @brief Az osztly konstruktora, amelyik fizikai soros porton keresztl kommunikl az I/O interfsszel.
 	 *
 	 * @param device A soros port neve a Windows rendszerben.
 	 * @param baud_rate A soros port adattviteli sebessge.
 	 */
 	FakeBoris(const std::string& device, unsigned int baud_rate);
 
+	/**
+	 * @brief Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+	 *
+	 * @param transport_layer Az I/O interfsszel val kapcsolatot ltrehoz tvitel.
+	 * @param baud_rate A vonal adattviteli sebessge, amelyhez az automatikus peridus igazodik.
+	 */
+	FakeBoris(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate);
+
 	/**
 	 * @brief Az osztly virtulis destruktora.
 	 */
 	virtual ~FakeBoris();
 
+	/**
+	 * @brief Belltja a bemenetek s a kimenetek megjelentsnek legnagyobb kpkockasebessgt. Gyors lekrdezs esetn a
+	 * konzolkperny ennl gyakrabban nem frissl, gy a megjelents processzorignye a lekrdezs peridustl fggetlen. Csak az
+	 * adatcsere elindtsa eltt van hatsa.
+	 *
+	 * @param frames_per_second A kpkockk legnagyobb szma msodpercenknt.
+	 */
+	void setFrameRate(unsigned int frames_per_second);
+
 	/**
 	 * @brief Kirajzolja a konzolkpernyre az I/O interfszt brzol karakterkpet, inicializlja a soros kommunikcis portot s
 	 * elindtja az I/O interfsszel trtn ismtld adatcsert.
+	 *
+	 * @return Igaz, ha a kapcsolat ltrejtt.
 	 */
-	void start();
+	virtual bool start();
 
 	/**
-	 * @brief Lelltja a soros ponton keresztli ismtld adatcsert s lezrja a soros kommunikcis portot.
+	 * @brief Lelltja a soros ponton keresztli ismtld adatcsert, lezrja a soros kommunikcis portot s a megjelentst.
 	 */
-	void stop();
+	virtual void stop();
 
 	/**
 	 * @brief Ismtlden bekri a felhasznltl a kimenetek llapotainak megvltoztatst elidz paramtereket a megadott megllt
@@ -142,16 +143,6 @@ public:
 	void readUntil(char stop_char);
 
 private:
-	/**
-	 * Az I/O interfsz kimeneteit bellt utasts.
-	 */
-	static const unsigned char CMD_WRITE_OUTPUT;
-
-	/**
-	 * Az I/O interfsz bemeneteit beolvas utasts.
-	 */
-	static const unsigned char CMD_READ_INPUT;
-
 	/**
 	 * Az I/O interfsz testt brzol karakterkp szne.
 	 */
@@ -0,0 +1,108 @@
+#ifndef INC_IOIMAGE_H_
+#define INC_IOIMAGE_H_
+
+#include <cstdint>
+#include <atomic>
+
+/**
+ * @brief Az I/O interfsz 16-bites bemeneti s kimeneti llapott zrols nlkl trol osztly. Az llapotok atomi vltozkban
+ * vannak, a bitenknti mdostsok atomi VAGY s S mveletekkel trtnnek, gy az ismtld adatcsere szla s tetszleges szm
+ * r szl soha nem vrakoztatja egymst. Mindkt llapothoz verziszm tartozik, amely minden tnyleges vltozskor nvekszik, gy
+ * a vltozs egy olcs sszehasonltssal felismerhet.
+ */
+class IOImage {
+	/**
+	 * A 16-bites kimeneti llapot.
+	 */
+	std::atomic<std::uint16_t> output;
+
+	/**
+	 * A kimeneti llapot verziszma.
+	 */
+	std::atomic<std::uint32_t> outputVersion;
+
+	/**
+	 * A legutbb beolvasott 16-bites bemeneti llapot.
+	 */
+	std::atomic<std::uint16_t> input;
+
+	/**
+	 * A bemeneti llapot verziszma.
+	 */
+	std::atomic<std::uint32_t> inputVersion;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	IOImage(IOImage&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	IOImage& operator=(const IOImage&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora, amelyik csupa nulla bemeneti s kimeneti llapottal indul.
+	 */
+	IOImage();
+
+	/**
+	 * @brief Atomi mvelettel belltja vagy trli a kimenet egy bitjt.
+	 *
+	 * @param index A bit sorszma 0 s 15 kztt.
+	 * @param value A bit j rtke.
+	 * @return Igaz, ha a kimeneti llapot megvltozott.
+	 */
+	bool setOutputBit(unsigned int index, bool value);
+
+	/**
+	 * @brief Egyetlen atomi lpsben mdostja a kimenet maszkkal kijellt bitjeit, gy azok egy idben, ugyanabban az utastsban
+	 * kerlnek ki az I/O interfszre. Csak belltott vagy csak trlt bitek esetn egyetlen VAGY, illetve S mvelet trtnik, vegyes
+	 * esetben sszehasonlt csere.
+	 *
+	 * @param mask A mdostand bitek maszkja.
+	 * @param bits A kijellt bitek j rtkei.
+	 * @return Igaz, ha a kimeneti llapot megvltozott.
+	 */
+	bool setOutputBits(std::uint16_t mask, std::uint16_t bits);
+
+	/**
+	 * @brief Atomi mvelettel belltja a teljes kimeneti llapotot.
+	 *
+	 * @param value Az j 16-bites kimeneti llapot.
+	 * @return Igaz, ha a kimeneti llapot megvltozott.
+	 */
+	bool setOutput(std::uint16_t value);
+
+	/**
+	 * @return A 16-bites kimeneti llapot.
+	 */
+	std::uint16_t getOutput() const;
+
+	/**
+	 * @return A kimeneti llapot verziszma. A verziszmot az llapot eltt kell kiolvasni, gy egy kzben trtnt vltozs legfeljebb
+	 * egy flsleges ismtelt kikldst okoz, de soha nem vsz el.
+	 */
+	std::uint32_t getOutputVersion() const;
+
+	/**
+	 * @brief Eltrolja a beolvasott bemeneti llapotot.
+	 *
+	 * @param value A 16-bites bemeneti llapot.
+	 * @return Igaz, ha a bemeneti llapot megvltozott.
+	 */
+	bool setInput(std::uint16_t value);
+
+	/**
+	 * @return A legutbb beolvasott 16-bites bemeneti llapot.
+	 */
+	std::uint16_t getInput() const;
+
+	/**
+	 * @return A bemeneti llapot verziszma.
+	 */
+	std::uint32_t getInputVersion() const;
+};
+
+#endif /* INC_IOIMAGE_H_ */
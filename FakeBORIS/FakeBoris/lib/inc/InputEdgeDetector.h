@@ -0,0 +1,202 @@
+#ifndef INC_INPUTEDGEDETECTOR_H_
+#define INC_INPUTEDGEDETECTOR_H_
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Az I/O interfsz bemeneti llapotnak vltozsait ldetektlssal felismer s a feliratkozknak tovbbt osztly. Minden
+ * beolvasott llapotot az elzvel kizr VAGY mvelettel hasonlt ssze, gy vltozs nlkli minta esetn egyetlen sszehasonlts
+ * utn visszatr, s a feliratkozk csak tnyleges, a pergsmentestsen is tjutott vltozsrl kapnak rtestst. A bemenetenknt
+ * bellthat pergsmentestsi id alatt visszafordul vltozs nem okoz lt. Az lek idblyege annak a vlasznak a berkezsi
+ * ideje, amelyben az j llapot elszr megjelent.
+ */
+class InputEdgeDetector {
+public:
+	/**
+	 * @brief A figyelt lek fajti.
+	 */
+	enum class Edge {
+		/**
+		 * A bemenet 0-bl 1-be vltsa.
+		 */
+		RISING = 1,
+
+		/**
+		 * A bemenet 1-bl 0-ba vltsa.
+		 */
+		FALLING = 2,
+
+		/**
+		 * Mindkt irny vlts.
+		 */
+		BOTH = 3
+	};
+
+	/**
+	 * @brief Az lek feliratkozinak fggvnytpusa. Paramterei a bemenet sorszma 0 s 15 kztt, az l fajtja (RISING vagy
+	 * FALLING) s az l idblyege.
+	 */
+	typedef std::function<void (unsigned int, Edge, std::chrono::steady_clock::time_point)> EdgeHandler;
+
+private:
+	/**
+	 * @brief Egy feliratkozs adatai.
+	 */
+	struct Subscription {
+		/**
+		 * A feliratkozs azonostja a leiratkozshoz.
+		 */
+		unsigned int id;
+
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyek felfut leirl a feliratkoz rtestst kr.
+		 */
+		std::uint16_t risingMask;
+
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyek lefut leirl a feliratkoz rtestst kr.
+		 */
+		std::uint16_t fallingMask;
+
+		/**
+		 * Az leknl meghvott fggvny.
+		 */
+		EdgeHandler handler;
+	};
+
+	/**
+	 * A feliratkozsokat s a pergsmentestsi idket klcsnsen kizr adattag. Az llapot vltozatlansga esetn a mintk
+	 * feldolgozsa nem zrolja.
+	 */
+	std::mutex configMutex;
+
+	/**
+	 * A feliratkozsok.
+	 */
+	std::vector<Subscription> subscriptions;
+
+	/**
+	 * A kvetkez feliratkozs azonostja.
+	 */
+	unsigned int nextId;
+
+	/**
+	 * Azoknak a bemeneteknek a maszkja, amelyek felfut lre legalbb egy feliratkoz van.
+	 */
+	std::uint16_t risingInterest;
+
+	/**
+	 * Azoknak a bemeneteknek a maszkja, amelyek lefut lre legalbb egy feliratkoz van.
+	 */
+	std::uint16_t fallingInterest;
+
+	/**
+	 * A bemenetenknti pergsmentestsi idk.
+	 */
+	std::chrono::nanoseconds debounce[16];
+
+	/**
+	 * Igaz, ha mr rkezett minta. Az els minta csak a kiindul llapotot lltja be, lt nem okoz. Csak a mintkat feldolgoz szl
+	 * hasznlja.
+	 */
+	bool initialized;
+
+	/**
+	 * A legutbbi minta, pergsmentests nlkl. Csak a mintkat feldolgoz szl hasznlja.
+	 */
+	std::uint16_t raw;
+
+	/**
+	 * Azoknak a bemeneteknek a maszkja, amelyek nyers llapota eltr a pergsmentestett llapottl, s a pergsmentestsi id
+	 * leteltre vrnak. Csak a mintkat feldolgoz szl hasznlja.
+	 */
+	std::uint16_t pending;
+
+	/**
+	 * A bemenetenknt annak a mintnak a berkezsi ideje, amelyben a nyers llapot utoljra megvltozott. Csak a mintkat feldolgoz
+	 * szl hasznlja.
+	 */
+	std::chrono::steady_clock::time_point changeTime[16];
+
+	/**
+	 * A pergsmentestett bemeneti llapot.
+	 */
+	std::atomic<std::uint16_t> state;
+
+	/**
+	 * @brief jraszmolja a feliratkozk ltal figyelt lek maszkjait. A hvnak zrolnia kell a belltsokat.
+	 */
+	void updateInterest();
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	InputEdgeDetector(InputEdgeDetector&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	InputEdgeDetector& operator=(const InputEdgeDetector&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora, pergsmentests s feliratkozk nlkl.
+	 */
+	InputEdgeDetector();
+
+	/**
+	 * @brief Feliratkozik a megadott bemenetek megadott fajtj leire. A fggvny a mintkat feldolgoz szlon, a belltsok
+	 * zrolsa mellett hvdik meg, ezrt gyorsan vissza kell trnie, s nem iratkozhat fel vagy le. Brmelyik szlrl hvhat.
+	 *
+	 * @param pins A figyelt bemenetek maszkja, a 0. bit az I00 bemenet.
+	 * @param edges A figyelt lek fajtja.
+	 * @param handler Az leknl meghvott fggvny.
+	 * @return A feliratkozs azonostja.
+	 */
+	unsigned int subscribe(std::uint16_t pins, Edge edges, const EdgeHandler& handler);
+
+	/**
+	 * @brief Megsznteti a megadott feliratkozst. Visszatrse utn a fggvny mr nem hvdik meg. Brmelyik szlrl hvhat, a
+	 * feliratkoz fggvnybl kivve.
+	 *
+	 * @param id A feliratkozs azonostja.
+	 */
+	void unsubscribe(unsigned int id);
+
+	/**
+	 * @brief Belltja a megadott bemenetek pergsmentestsi idejt. Az j llapot csak akkor okoz lt, ha legalbb ennyi ideig
+	 * vltozatlan maradt; mivel a vltozs csak mintavtelkor vehet szre, az l legkorbban az id letelte utni els mintnl
+	 * jelentkezik, de az idblyege a vltozs els szlelsnek ideje. Brmelyik szlrl hvhat.
+	 *
+	 * @param pins A bemenetek maszkja.
+	 * @param window A pergsmentestsi id, vagy nulla a kikapcsolshoz.
+	 */
+	void setDebounce(std::uint16_t pins, std::chrono::nanoseconds window);
+
+	/**
+	 * @brief Elfelejti a korbbi mintkat, gy a kvetkez minta ismt csak a kiindul llapotot lltja be. Csak akkor hvhat, amikor
+	 * mintk nem rkeznek, pldul a kapcsolat ltrehozsa eltt.
+	 */
+	void reset();
+
+	/**
+	 * @brief Feldolgoz egy beolvasott bemeneti llapotot, s rtesti a feliratkozkat a pergsmentestsen tjutott lekrl. Egyszerre
+	 * csak egy szlrl hvhat.
+	 *
+	 * @param value A 16-bites bemeneti llapot.
+	 * @param receive_time Az llapotot tartalmaz vlasz berkezsnek ideje.
+	 */
+	void sample(std::uint16_t value, std::chrono::steady_clock::time_point receive_time);
+
+	/**
+	 * @return A pergsmentestett 16-bites bemeneti llapot.
+	 */
+	std::uint16_t getState() const;
+};
+
+#endif /* INC_INPUTEDGEDETECTOR_H_ */
@@ -0,0 +1,159 @@
+#ifndef INC_LOOPBENCHMARK_H_
+#define INC_LOOPBENCHMARK_H_
+
+#include <inc\PollEngine.h>
+#include <inc\AbstractTransport.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief A FakeBoris ismtld adatcserjt konzolkp nlkl, mrsre elksztve vgz osztly. Az adatcsert maga a PollEngine
+ * vgzi, gy a mrs pontosan azt a ciklust mri, amelyet a FakeBoris is futtat. Az osztly a vlaszok krlfordulsi idejt rgzti,
+ * a mrs vgn pedig kiszmtja az teresztkpessget, a krlfordulsi idk percentiliseit s a tranzakcinknt felhasznlt
+ * processzoridt.
+ */
+class LoopBenchmark: public PollEngine {
+public:
+	/**
+	 * @brief Egy mrs eredmnye.
+	 */
+	struct Result {
+		/**
+		 * A mrs alatt megvlaszolt lekrdezsek szma.
+		 */
+		unsigned long long int completed;
+
+		/**
+		 * A mrs alatt lejrt lekrdezsek szma.
+		 */
+		unsigned long long int timeouts;
+
+		/**
+		 * A megvlaszolt lekrdezsek szma msodpercenknt.
+		 */
+		double throughput;
+
+		/**
+		 * A krlfordulsi idk medinja.
+		 */
+		std::chrono::nanoseconds p50;
+
+		/**
+		 * A krlfordulsi idk 99. percentilise.
+		 */
+		std::chrono::nanoseconds p99;
+
+		/**
+		 * A krlfordulsi idk 99,9. percentilise.
+		 */
+		std::chrono::nanoseconds p999;
+
+		/**
+		 * A folyamat ltal egy megvlaszolt lekrdezsre jut felhasznlt processzorid. Folyamaton belli emultor esetn az eszkz
+		 * oldalt is tartalmazza.
+		 */
+		std::chrono::nanoseconds cpuPerTransaction;
+	};
+
+private:
+	/**
+	 * A mrs eltt a krlfordulsi idk szmra lefoglalt hely, hogy a mrs alatt ne legyen memriafoglals.
+	 */
+	static const std::size_t SAMPLE_RESERVE;
+
+	/**
+	 * Igaz, ha a lekrdezsek a vlaszok berkezsekor azonnal kvetik egymst. Ekkor a peridus csak a lejrt lekrdezsek ptlst
+	 * idzti.
+	 */
+	bool closedLoop;
+
+	/**
+	 * Igaz, amg a mrs tart. Csak a mrs alatt berkezett vlaszok krlfordulsi ideje kerl rgztsre.
+	 */
+	std::atomic<bool> measuring;
+
+	/**
+	 * A mrs alatt berkezett vlaszok krlfordulsi idejei. Csak a soros port olvassnak szla rja, a mrs vgn a port
+	 * lezrsa utn olvashat.
+	 */
+	std::vector<std::chrono::nanoseconds> samples;
+
+	/**
+	 * @brief Elkldi az I/O interfsznek a kimenet belltst s a bemenet lekrdezst a PollEngine ismtld adatcserjvel. Zrt
+	 * hurk mrs esetn annyi lekrdezst kld, amennyi a tranzakcis rteg mlysgbe belefr.
+	 */
+	virtual void performScheduledAction();
+
+	/**
+	 * @brief Rgzti egy, a lekrdezshez prostott vlasz krlfordulsi idejt, zrt hurk mrs esetn pedig azonnal kivltja a
+	 * kvetkez lekrdezst.
+	 *
+	 * @param round_trip A lekrdezs krlfordulsi ideje, vagy nulla, ha a vlasz nem volt lekrdezshez prosthat.
+	 */
+	virtual void roundTripSampled(std::chrono::nanoseconds round_trip);
+
+	/**
+	 * @return A folyamat ltal eddig felhasznlt processzorid.
+	 */
+	static std::chrono::nanoseconds processCpuTime();
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	LoopBenchmark() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	LoopBenchmark(LoopBenchmark&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	LoopBenchmark& operator=(const LoopBenchmark&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param transport_layer Az I/O interfsszel val kapcsolatot ltrehoz tvitel.
+	 */
+	explicit LoopBenchmark(std::unique_ptr<AbstractTransport> transport_layer);
+
+	/**
+	 * @brief Az osztly virtulis destruktora. Lelltja a mrst s lezrja a kapcsolatot.
+	 */
+	virtual ~LoopBenchmark();
+
+	/**
+	 * @brief Belltja, hogy a lekrdezsek a vlaszok berkezsekor azonnal kvessk-e egymst. Ekkor a lekrdezs peridust a
+	 * lekrdezsek lejrati idejre rdemes lltani, mert az csak a lejrt lekrdezsek ptlst idzti. Csak a kapcsolat ltrehozsa
+	 * eltt van hatsa.
+	 *
+	 * @param closed_loop Igaz esetn zrt hurk, egybknt periodikus mrs.
+	 */
+	void setClosedLoop(bool closed_loop);
+
+	/**
+	 * @brief Ltrehozza a kapcsolatot az I/O interfsszel s elindtja az ismtld adatcsert, de a mrst mg nem. A kapcsolds
+	 * hibjt megjelenti.
+	 *
+	 * @return Igaz, ha a kapcsolat ltrejtt.
+	 */
+	bool open();
+
+	/**
+	 * @brief Elvgzi a mrst a megadott ideig, majd lelltja az adatcsert s lezrja a kapcsolatot. Objektumonknt egyszer hvhat.
+	 *
+	 * @param duration A mrs hossza.
+	 * @return A mrs eredmnye.
+	 */
+	Result run(std::chrono::nanoseconds duration);
+};
+
+#endif /* INC_LOOPBENCHMARK_H_ */
@@ -0,0 +1,49 @@
+#ifndef INC_LOOPBACKPEERTRANSPORT_H_
+#define INC_LOOPBACKPEERTRANSPORT_H_
+
+#include <inc\LoopbackTransport.h>
+
+#include <string>
+
+#ifndef _WIN32
+
+/**
+ * @brief Egy folyamaton belli hurok msik vge, amelyen keresztl pldul egy eszkzemultor csatlakozik a hurkot megnyit flhez.
+ * A hurkot a LoopbackTransport hozza ltre, ezrt a megnyits csak annak megnyitsa utn lehetsges. Csak POSIX rendszereken rhet el.
+ */
+class LoopbackPeerTransport: public AbstractTransport {
+	/**
+	 * A hurkot ltrehoz tvitel, amelynek lettartama meg kell haladja ennek az objektumnak a hasznlatt.
+	 */
+	LoopbackTransport& loopback;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	LoopbackPeerTransport() = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param loopback_transport A hurkot ltrehoz tvitel.
+	 */
+	explicit LoopbackPeerTransport(LoopbackTransport& loopback_transport);
+
+	/**
+	 * @brief A hurok msik vgt a soros kommunikcit megvalst objektumhoz rendeli. Ha a hurok mg nincs ltrehozva, akkor
+	 * boost::system::system_error kivtelt dob.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port);
+
+	/**
+	 * @return A hurok lersa.
+	 */
+	virtual std::string describe() const;
+};
+
+#endif
+
+#endif /* INC_LOOPBACKPEERTRANSPORT_H_ */
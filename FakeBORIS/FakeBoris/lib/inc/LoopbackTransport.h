@@ -0,0 +1,54 @@
+#ifndef INC_LOOPBACKTRANSPORT_H_
+#define INC_LOOPBACKTRANSPORT_H_
+
+#include <inc\AbstractTransport.h>
+
+#include <string>
+
+#ifndef _WIN32
+
+/**
+ * @brief A folyamaton belli hurok, amelynek msik vgre egy ugyanabban a folyamatban fut fl, pldul egy eszkzemultor
+ * csatlakozik. A hurok egy UNIX socketpr, gy az adatok eszkz nlkl, a memrin keresztl haladnak, a kommunikci pedig teljes
+ * sebessggel mrhet. Csak POSIX rendszereken rhet el.
+ */
+class LoopbackTransport: public AbstractTransport {
+	/**
+	 * A hurok msik vgnek lerja, vagy negatv rtk, ha a hurok nincs ltrehozva, vagy a msik vg mr t lett adva.
+	 */
+	int peerDescriptor;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora.
+	 */
+	LoopbackTransport();
+
+	/**
+	 * @brief Az osztly virtulis destruktora. Lezrja a hurok msik vgt, ha az mg nem lett tadva.
+	 */
+	virtual ~LoopbackTransport();
+
+	/**
+	 * @brief Ltrehozza a hurkot s az egyik vgt a soros kommunikcit megvalst objektumhoz rendeli.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port);
+
+	/**
+	 * @brief A hurok msik vgt a msik fl soros kommunikcit megvalst objektumhoz rendeli. Az open() utn egyszer hvhat.
+	 *
+	 * @param peer_port A msik fl soros kommunikcit megvalst objektuma.
+	 */
+	void openPeer(CallbackAsyncSerial& peer_port);
+
+	/**
+	 * @return A hurok lersa.
+	 */
+	virtual std::string describe() const;
+};
+
+#endif
+
+#endif /* INC_LOOPBACKTRANSPORT_H_ */
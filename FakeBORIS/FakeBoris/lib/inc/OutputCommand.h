@@ -0,0 +1,75 @@
+#ifndef INC_OUTPUTCOMMAND_H_
+#define INC_OUTPUTCOMMAND_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Egy vagy tbb kimenetet egyszerre mdost parancs, amelynek minden bitje egyetlen atomi lpsben, ugyanabban a kimenetbellt
+ * utastsban kerl ki az I/O interfszre. A parancs vesszvel elvlasztott elemekbl ll, minden elem egy kimenet vagy kimenettartomny
+ * s egy rtk:
+ *
+ *   Q03=1            egyetlen kimenet,
+ *   Q00-07=0xA5      kimenettartomny, az rtk legalacsonyabb helyirtk bitje a legkisebb sorszm kimenetre kerl,
+ *   Q*=0xBEEF        a teljes 16-bites kimeneti sz,
+ *   Q03=1,Q12=0      tbb elem, amelyek kzl tfeds esetn a ksbbi rvnyes.
+ *
+ * Az rtkek tzes vagy 0x eltag tizenhatos szmrendszerben adhatk meg, a Q eltag s a szkzk elhagyhatk.
+ */
+class OutputCommand {
+	/**
+	 * A parancs ltal mdostott kimenetek maszkja.
+	 */
+	std::uint16_t mask;
+
+	/**
+	 * A mdostott kimenetek j rtkei.
+	 */
+	std::uint16_t bits;
+
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param command_mask A mdostott kimenetek maszkja.
+	 * @param command_bits A mdostott kimenetek j rtkei.
+	 */
+	OutputCommand(std::uint16_t command_mask, std::uint16_t command_bits);
+
+	/**
+	 * @brief rtelmez egy kimenetsorszmot a megadott pozcitl.
+	 *
+	 * @param text A parancs szvege.
+	 * @param position Az rtelmezs kezdpozcija, amely a sorszm utnra lp.
+	 * @return A kimenet sorszma 0 s 15 kztt.
+	 */
+	static unsigned int parseIndex(const std::string& text, std::size_t& position);
+
+	/**
+	 * @brief rtelmez egy tzes vagy 0x eltag tizenhatos szmrendszerbeli rtket.
+	 *
+	 * @param text Az rtk szvege.
+	 * @return Az rtk.
+	 */
+	static unsigned long int parseValue(const std::string& text);
+
+public:
+	/**
+	 * @brief rtelmezi a parancs szvegt. Hibs parancs esetn std::invalid_argument kivtelt dob, amelynek zenete megnevezi a hibt.
+	 *
+	 * @param text A parancs szvege.
+	 * @return Az rtelmezett parancs.
+	 */
+	static OutputCommand parse(const std::string& text);
+
+	/**
+	 * @return A parancs ltal mdostott kimenetek maszkja.
+	 */
+	std::uint16_t getMask() const;
+
+	/**
+	 * @return A mdostott kimenetek j rtkei.
+	 */
+	std::uint16_t getBits() const;
+};
+
+#endif /* INC_OUTPUTCOMMAND_H_ */
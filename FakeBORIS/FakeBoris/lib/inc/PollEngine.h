@@ -0,0 +1,525 @@
+#ifndef INC_POLLENGINE_H_
+#define INC_POLLENGINE_H_
+
+#include <inc\AbstractScheduler.h>
+#include <inc\RealTimeProfile.h>
+#include <inc\AdaptivePeriod.h>
+#include <inc\CommandPipeline.h>
+#include <inc\AbstractTransport.h>
+#include <inc\IOImage.h>
+#include <inc\InputEdgeDetector.h>
+#include <inc\ReflexRules.h>
+#include <inc\BlockDiagram.h>
+#include <inc\TrafficRecorder.h>
+#include <AsyncSerial\AsyncSerial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+/**
+ * @brief A CO3715-1H tpus I/O interfsszel a BORIS szoftver protokolljn ismtld adatcsert folytat osztly, konzolkp nlkl.
+ * Belltja a kimeneteket, lekrdezi a bemeneteket s nyilvntartja az llapotukat, de semmit nem rajzol ki, gy Windows konzol
+ * nlkl, POSIX rendszereken s httrfolyamatknt is futtathat. A megjelentst a leszrmazott osztlyok a bemenetek
+ * megvltozsakor meghvott virtulis fggvnyben vgezhetik.
+ */
+class PollEngine: public AbstractScheduler {
+public:
+	/**
+	 * @brief A kimenetek I/O interfszre rsnak mdjai.
+	 */
+	enum class WriteMode {
+		/**
+		 * A kimenetek llapota minden lekrdezskor kikldsre kerl, akkor is, ha nem vltozott.
+		 */
+		PERIODIC,
+
+		/**
+		 * A kimenetek llapota csak megvltozsukkor, de akkor azonnal kikldsre kerl. A kzel egyidej vltozsok egyetlen
+		 * utastsba olvadnak ssze, a vltozs nlkli temezett lekrdezsek pedig csak a bemenetet olvassk be.
+		 */
+		ON_CHANGE
+	};
+
+private:
+	/**
+	 * Az I/O interfsszel val kapcsolatot ltrehoz tvitel.
+	 */
+	const std::unique_ptr<AbstractTransport> transport;
+
+	/**
+	 * A soros ponton keresztli aszinkron kommunikcit megvalst objektum.
+	 */
+	CallbackAsyncSerial serialPort;
+
+	/**
+	 * Az I/O interfsz lekrdezsnek peridusa. Nulla rtk esetn a peridust az adattviteli sebessg s a mrt krlfordulsi
+	 * idk hatrozzk meg.
+	 */
+	std::chrono::nanoseconds pollPeriod;
+
+	/**
+	 * Az automatikus lekrdezsi peridust az adattviteli sebessgbl s a krlfordulsi idkbl meghatroz objektum.
+	 */
+	AdaptivePeriod adaptivePeriod;
+
+	/**
+	 * A kikldtt s a berkezett bjtokat rgzt objektum, vagy nullpointer, ha nincs rgzts. A tranzakcis rteg eltt szerepel,
+	 * gy csak utna sznik meg.
+	 */
+	std::unique_ptr<TrafficRecorder> trafficRecorder;
+
+	/**
+	 * A bemenet-lekrdezseket nyilvntart s a vlaszokat hozzjuk prost tranzakcis rteg.
+	 */
+	CommandPipeline pipeline;
+
+	/**
+	 * Az egy olvassbl dekdolt legfrissebb bemeneti llapot, vagy negatv rtk, ha az olvassbl nem llt ssze teljes vlasz.
+	 * Csak a berkezett bjtokat feldolgoz szl hasznlja.
+	 */
+	long int latestInput;
+
+	/**
+	 * Az ismtld adatcsere s a soros port olvassnak szlaira alkalmazott vals idej temezsi profil.
+	 */
+	RealTimeProfile realTimeProfile;
+
+	/**
+	 * A 16-bites bemeneti s kimeneti llapotot zrols nlkl trol objektum.
+	 */
+	IOImage ioImage;
+
+	/**
+	 * A beolvasott bemeneti llapotok leit felismer s a feliratkozknak tovbbt objektum.
+	 */
+	InputEdgeDetector edgeDetector;
+
+	/**
+	 * A vlaszok feldolgozsakor kirtkelt reflexszablyok. Csak a berkezett bjtokat feldolgoz szl hasznlja.
+	 */
+	ReflexRules reflexRules;
+
+	/**
+	 * A reflexszablyok ltal az aktulis olvass vlaszaibl kiszmolt kimenetek maszkja. Csak a berkezett bjtokat feldolgoz szl
+	 * hasznlja.
+	 */
+	std::uint16_t reflexMask;
+
+	/**
+	 * A reflexszablyok ltal az aktulis olvass vlaszaibl kiszmolt kimenetek j rtkei.
+	 */
+	std::uint16_t reflexBits;
+
+	/**
+	 * Az ismtld adatcsere minden peridusban lefut blokkdiagram. Csak az ismtld adatcsere szla hasznlja.
+	 */
+	BlockDiagram blockDiagram;
+
+	/**
+	 * A kimenetek I/O interfszre rsnak mdja.
+	 */
+	WriteMode writeMode;
+
+	/**
+	 * A kimeneti llapot kiolvasst s kikldst klcsnsen kizr adattag, mivel az ismtld adatcsere s a reflexszablyok is
+	 * kikldhetik a kimeneteket.
+	 */
+	std::mutex outputMutex;
+
+	/**
+	 * A legutbb kikldtt kimeneti llapot verziszma.
+	 */
+	std::uint32_t lastSentVersion;
+
+	/**
+	 * Igaz, ha a kimeneti llapot mr legalbb egyszer kikldsre kerlt.
+	 */
+	bool outputSent;
+
+	/**
+	 * A soros port fogadsi gyrjnek mrete bjtokban, vagy nulla, ha a berkezett bjtokat kzvetlenl a soros port olvassnak
+	 * szla dolgozza fel.
+	 */
+	std::size_t receiveRingSize;
+
+	/**
+	 * Az indtskor vgzett krlfordulsiid-mrs lekrdezseinek szma, vagy nulla, ha mrs csak automatikus peridus esetn
+	 * trtnik.
+	 */
+	unsigned int probeSamples;
+
+	/**
+	 * @brief Kikldi az I/O interfsznek a kimenetek llapott. Brmelyik szlrl hvhat.
+	 *
+	 * @param changed_only Igaz esetn a kiklds csak akkor trtnik meg, ha az llapot a legutbbi kiklds ta megvltozott.
+	 */
+	void sendOutput(bool changed_only);
+
+	/**
+	 * @brief Alkalmazza a vals idej temezsi profilt az ismtld adatcsere szlra.
+	 */
+	virtual void prepareThread();
+
+	/**
+	 * @brief Alkalmazza a vals idej temezsi profilt a hv szlra s figyelmeztetst r ki, ha az nem sikerlt.
+	 *
+	 * @param thread_name A szl megnevezse a figyelmeztet zenetben.
+	 */
+	void applyRealTimeProfile(const char* thread_name);
+
+	/**
+	 * @brief Fogadja a soros kommunikcis porton rkez zenetet az I/O interfsztl, s a feldolgozst kveten eltrolja a bemenetek
+	 * llapott. Az zenet a vlaszok tetszleges tredke vagy tbb vlasz egyms utn is lehet.
+	 *
+	 * @param read_data A soros kommunikcis portra rkezett zenet els elemre mutat pointer.
+	 * @param data_size A soros kommunikcis portra rkezett zenet hossza.
+	 */
+	void readIODevice(const char* input, size_t data_size);
+
+	/**
+	 * @brief Feldolgoz egy, a lekrdezshez prostott vlaszt: rgzti a krlfordulsi idt az automatikus peridus szmtshoz,
+	 * tadja a bemeneti llapotot az ldetektlsnak, eltrolja azt, s tadja a krlfordulsi idt a leszrmazott osztlynak.
+	 *
+	 * @param reply A 16-bites bemeneti llapot.
+	 * @param receive_time A vlasz berkezsnek idpontja.
+	 * @param round_trip A lekrdezs krlfordulsi ideje, vagy nulla, ha a vlasz nem volt lekrdezshez prosthat.
+	 */
+	void processReply(std::uint16_t reply, std::chrono::steady_clock::time_point receive_time, std::chrono::nanoseconds round_trip);
+
+	/**
+	 * @brief Kiolvassa a soros port fogadsi gyrjbl a berkezett bjtokat s feldolgozza ket.
+	 */
+	void pullReceivedData();
+
+	/**
+	 * @brief Szinkron lekrdezsek sorozatval megmri az I/O interfsz krlfordulsi idejt, a mrt rtkekkel elkszti az automatikus
+	 * peridus szmtst, s megjelenti az eredmnyt. A soros portnak nyitva kell lennie, de az olvassi visszahv fggvny mg nem
+	 * lehet belltva.
+	 *
+	 * @param samples A lekrdezsek szma.
+	 */
+	void probeRoundTrip(unsigned int samples);
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	PollEngine() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	PollEngine(PollEngine&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	PollEngine& operator=(const PollEngine&) = delete;
+
+protected:
+	/**
+	 * A konzolkpernyre tbb szlrl trtn rsi mveleteket klcsnsen kizr adattag.
+	 */
+	std::recursive_mutex printLocker;
+
+	/**
+	 * Igaz esetn a kapcsolat lersa s a lelltskori statisztika nem jelenik meg, csak a hibazenetek. A leszrmazott osztlyok
+	 * sajt kimenetk tisztn tartsra kapcsolhatjk be.
+	 */
+	bool quiet;
+
+	/**
+	 * @brief Ismtld idkznknt elkldi az I/O interfsznek a belltott kimenetet s lekrdezi a bemenet llapott. Ha mr a
+	 * megengedett szm lekrdezs vr vlaszra, a lekrdezs elmarad.
+	 */
+	virtual void performScheduledAction();
+
+	/**
+	 * @brief A bemeneti llapot megvltozsakor, a berkezett bjtokat feldolgoz szlon hvdik meg. A leszrmazott osztlyok ebben
+	 * jelenthetik meg az j llapotot. Az alaprtelmezett megvalsts nem csinl semmit.
+	 *
+	 * @param value Az j 16-bites bemeneti llapot.
+	 */
+	virtual void inputChanged(std::uint16_t value);
+
+	/**
+	 * @brief A kimeneti llapot reflexszablyok ltali megvltozsakor a berkezett bjtokat feldolgoz szlon, a blokkdiagram ltali
+	 * megvltozsakor az ismtld adatcsere szln, a kiklds utn hvdik meg. Az alaprtelmezett megvalsts nem csinl semmit.
+	 *
+	 * @param value Az j 16-bites kimeneti llapot.
+	 */
+	virtual void outputChanged(std::uint16_t value);
+
+	/**
+	 * @brief Minden feldolgozott vlasznl, a berkezett bjtokat feldolgoz szlon hvdik meg a lekrdezs krlfordulsi idejvel.
+	 * A leszrmazott osztlyok ebben mrhetik a krlfordulsi idket. Az alaprtelmezett megvalsts nem csinl semmit.
+	 *
+	 * @param round_trip A lekrdezs krlfordulsi ideje, vagy nulla, ha a vlasz nem volt lekrdezshez prosthat.
+	 */
+	virtual void roundTripSampled(std::chrono::nanoseconds round_trip);
+
+	/**
+	 * @brief Alkalmazza a vals idej temezsi profil folyamatszint belltsait s megjelenti az bredsi ksleltetst, ha a profil
+	 * be van kapcsolva.
+	 */
+	void applyProcessProfile();
+
+	/**
+	 * @brief Ltrehozza a kapcsolatot az I/O interfsszel, szksg esetn megmri a krlfordulsi idt, s elindtja az ismtld
+	 * adatcsert. A kapcsolds hibjt megjelenti.
+	 *
+	 * @return Igaz, ha a kapcsolat ltrejtt.
+	 */
+	bool connect();
+
+public:
+	/**
+	 * @brief Az osztly konstruktora, amelyik fizikai soros porton keresztl kommunikl az I/O interfsszel.
+	 *
+	 * @param device A soros port neve.
+	 * @param baud_rate A soros port adattviteli sebessge.
+	 */
+	PollEngine(const std::string& device, unsigned int baud_rate);
+
+	/**
+	 * @brief Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+	 *
+	 * @param transport_layer Az I/O interfsszel val kapcsolatot ltrehoz tvitel.
+	 * @param baud_rate A vonal adattviteli sebessge, amelyhez az automatikus peridus igazodik.
+	 */
+	PollEngine(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate);
+
+	/**
+	 * @brief Az osztly virtulis destruktora. Lelltja az adatcsert s lezrja a kapcsolatot.
+	 */
+	virtual ~PollEngine();
+
+	/**
+	 * @brief Belltja az ismtld adatcsere s a soros port olvassnak szlaira alkalmazand vals idej temezsi profilt. Csak az
+	 * adatcsere elindtsa eltt van hatsa.
+	 *
+	 * @param profile A vals idej temezsi profil.
+	 */
+	void setRealTimeProfile(const RealTimeProfile& profile);
+
+	/**
+	 * @brief Belltja az I/O interfsszel trtn ismtld adatcsere idztsnek mdjt.
+	 *
+	 * @param scheduling_mode Az idzts mdja.
+	 * @param spin_window Hibrid idzts esetn a hatrid eltti aktv vrakozs legnagyobb hossza.
+	 * @param cpu_budget Hibrid idzts esetn a peridusnak az aktv vrakozssal tlthet legnagyobb hnyada (0 s 1 kztt).
+	 */
+	void setSchedulingMode(SchedulingMode scheduling_mode, std::chrono::nanoseconds spin_window, double cpu_budget);
+
+	/**
+	 * @brief Belltja az I/O interfsz lekrdezsnek peridust.
+	 *
+	 * @param poll_period A lekrdezs peridusa, vagy nulla az adattviteli sebessghez s a mrt krlfordulsi idkhz igazod
+	 * automatikus peridushoz.
+	 */
+	void setPollPeriod(std::chrono::nanoseconds poll_period);
+
+	/**
+	 * @brief Belltja a kimenetek I/O interfszre rsnak mdjt.
+	 *
+	 * @param write_mode A kimenetek rsnak mdja.
+	 */
+	void setWriteMode(WriteMode write_mode);
+
+	/**
+	 * @brief Belltja az egyszerre vlaszra vr bemenet-lekrdezsek legnagyobb szmt. Egynl nagyobb rtk esetn a kvetkez
+	 * lekrdezs a korbbi vlaszok megrkezse eltt is elkldhet, gy az automatikus peridus a krlfordulsi idnl rvidebb lehet.
+	 *
+	 * @param pipeline_depth A vlaszra vr lekrdezsek legnagyobb szma (1 s 16 kztt).
+	 */
+	void setPipelineDepth(unsigned int pipeline_depth);
+
+	/**
+	 * @return Az egyszerre vlaszra vr bemenet-lekrdezsek legnagyobb szma.
+	 */
+	unsigned int getPipelineDepth() const;
+
+	/**
+	 * @return A vlaszra vr bemenet-lekrdezsek szma.
+	 */
+	unsigned int getOutstanding();
+
+	/**
+	 * @return A lejrt bemenet-lekrdezsek szma.
+	 */
+	unsigned long long int getTimeoutCount() const;
+
+	/**
+	 * @brief Belltja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a program lejrtnak tekint.
+	 *
+	 * @param request_timeout A lekrdezsek lejrati ideje.
+	 */
+	void setRequestTimeout(std::chrono::nanoseconds request_timeout);
+
+	/**
+	 * @brief Belltja a soros port kimeneti sorban egyszerre vrakoz bjtok legnagyobb szmt. Ha a vonal lassabb a lekrdezseknl,
+	 * a korltot tllp lekrdezsek elmaradnak, a kimenetek llapota pedig mindig csak a legjabb rtkkel vrakozik, gy a
+	 * ksleltets tlterhels esetn is korltos marad.
+	 *
+	 * @param bytes A vrakoz bjtok legnagyobb szma, vagy nulla a korlt nlkli sorhoz.
+	 */
+	void setWriteQueueLimit(std::size_t bytes);
+
+	/**
+	 * @brief Belltja a soros port fogadsi gyrjnek mrett. Bekapcsolt gyr esetn a soros port olvassnak szla csak eltrolja a
+	 * berkezett bjtokat, a feldolgozsuk s a megjelentsk pedig az ismtld adatcsere szln trtnik, gy a megjelents
+	 * lasssga nem akadlyozza a fogadst. Ekkor a krlfordulsi id csak a peridus felbontsval mrhet, ezrt az automatikus
+	 * peridust csak az indtskori mrs hatrozza meg. Csak az adatcsere elindtsa eltt van hatsa.
+	 *
+	 * @param bytes A fogadsi gyr mrete bjtokban, vagy nulla a gyr kikapcsolshoz.
+	 */
+	void setReceiveRing(std::size_t bytes);
+
+	/**
+	 * @brief Belltja a soros port ksleltetst befolysol belltsait: a blokkol olvass VMIN s VTIME rtkt, az USB-soros
+	 * talaktk ksleltetsi idztjt kikapcsol ASYNC_LOW_LATENCY jelzt s a szabvnyostl eltr adattviteli sebessgek
+	 * engedlyezst. Csak az adatcsere elindtsa eltt van hatsa.
+	 *
+	 * @param options A ksleltetst befolysol belltsok.
+	 */
+	void setLatencyOptions(const AsyncSerial::LatencyOptions& options);
+
+	/**
+	 * @brief Belltja, hogy indtskor hny szinkron lekrdezssel mrje meg a program az I/O interfsz krlfordulsi idejt. A mrs
+	 * eredmnye megmutatja a ksleltetst befolysol belltsok hatst. Csak az adatcsere elindtsa eltt van hatsa.
+	 *
+	 * @param samples A lekrdezsek szma, vagy nulla, ha mrs csak automatikus peridus esetn trtnjen.
+	 */
+	void setProbeSamples(unsigned int samples);
+
+	/**
+	 * @brief Mdostja a kimenetek megadott bitjeit egyetlen atomi lpsben, s vltozs esetn azonnal kikldi az j llapotot, hogy a
+	 * vltozs egy tranzakcinyi idn bell megjelenjen az I/O interfszen. Brmelyik szlrl hvhat.
+	 *
+	 * @param mask A mdostand bitek maszkja.
+	 * @param bits A mdostand bitek j rtkei.
+	 * @return Igaz, ha a kimeneti llapot megvltozott.
+	 */
+	bool setOutputBits(std::uint16_t mask, std::uint16_t bits);
+
+	/**
+	 * @brief Feliratkozik a megadott bemenetek megadott fajtj leire. A fggvny a berkezett bjtokat feldolgoz szlon hvdik meg,
+	 * a pergsmentestsen tjutott lekre, a vlasz berkezsi idejvel. Brmelyik szlrl hvhat.
+	 *
+	 * @param pins A figyelt bemenetek maszkja, a 0. bit az I00 bemenet.
+	 * @param edges A figyelt lek fajtja.
+	 * @param handler Az leknl meghvott fggvny, amelyik nem iratkozhat fel vagy le.
+	 * @return A feliratkozs azonostja.
+	 */
+	unsigned int subscribeEdges(std::uint16_t pins, InputEdgeDetector::Edge edges, const InputEdgeDetector::EdgeHandler& handler);
+
+	/**
+	 * @brief Megsznteti a megadott lfeliratkozst.
+	 *
+	 * @param id A feliratkozs azonostja.
+	 */
+	void unsubscribeEdges(unsigned int id);
+
+	/**
+	 * @brief Belltja a megadott bemenetek pergsmentestsi idejt. A bellts csak az leket s a pergsmentestett llapotot
+	 * rinti, a beolvasott llapot kijelzst nem.
+	 *
+	 * @param pins A bemenetek maszkja.
+	 * @param window A pergsmentestsi id, vagy nulla a kikapcsolshoz.
+	 */
+	void setDebounce(std::uint16_t pins, std::chrono::nanoseconds window);
+
+	/**
+	 * @brief Lefordt s hozzad egy reflexszablyt, amelyet a program minden berkezett vlaszra kirtkel, s a kimenetek vltozst
+	 * mg a vlasz feldolgozsa kzben kikldi. A szablyok formtumt a ReflexRules osztly rja le. Hibs szably esetn
+	 * std::invalid_argument kivtelt dob. Csak az adatcsere elindtsa eltt hvhat.
+	 *
+	 * @param rule A szably szvege.
+	 */
+	void addReflexRule(const std::string& rule);
+
+	/**
+	 * @brief Betlti a blokkdiagramot, amelyet a program az ismtld adatcsere minden peridusban lefuttat a legutbb beolvasott
+	 * bemeneti llapottal, s az ltala meghajtott kimeneteket mg ugyanabban a peridusban kikldi. A blokklista formtumt a
+	 * BlockDiagram osztly rja le. Hibs blokklista esetn std::invalid_argument kivtelt dob. Csak az adatcsere elindtsa eltt
+	 * hvhat.
+	 *
+	 * @param input A blokklistt tartalmaz adatfolyam.
+	 * @return A lefordtott utastsok szma.
+	 */
+	std::size_t loadBlockDiagram(std::istream& input);
+
+	/**
+	 * @brief Belltja a kikldtt s a berkezett bjtokat rgzt objektumot. A kikldtt bjtok akkor kerlnek rgztsre, amikor
+	 * a soros port tadja ket az eszkznek, a berkezettek a vlaszok feldolgozsakor, gy ezek idblyege fogadgyr hasznlatakor a
+	 * feldolgozs ideje. Csak az adatcsere
+	 * elindtsa eltt hvhat.
+	 *
+	 * @param traffic_recorder A rgzt objektum, vagy nullpointer a rgzts kikapcsolshoz.
+	 */
+	void setTrafficRecorder(std::unique_ptr<TrafficRecorder> traffic_recorder);
+
+	/**
+	 * @return A 16-bites kimeneti llapot.
+	 */
+	std::uint16_t getOutput() const;
+
+	/**
+	 * @return A legutbb beolvasott 16-bites bemeneti llapot.
+	 */
+	std::uint16_t getInput() const;
+
+	/**
+	 * @return A pergsmentestett 16-bites bemeneti llapot.
+	 */
+	std::uint16_t getDebouncedInput() const;
+
+	/**
+	 * @return Az tvitel rvid lersa.
+	 */
+	std::string describe() const;
+
+	/**
+	 * @brief Kirja a lekrdezsek, a fogadsi gyr s a kimeneti sor statisztikjt.
+	 *
+	 * @param out A statisztikt fogad adatfolyam.
+	 * @param problems_only Igaz esetn csak azok a sorok jelennek meg, amelyek lejrt lekrdezst, eldobott bjtot vagy a kimeneti sor
+	 * teltdst jelzik.
+	 */
+	void printStatistics(std::ostream& out, bool problems_only);
+
+	/**
+	 * @brief Ltrehozza a kapcsolatot az I/O interfsszel s elindtja az ismtld adatcsert. A kapcsolds hibjt megjelenti.
+	 *
+	 * @return Igaz, ha a kapcsolat ltrejtt.
+	 */
+	virtual bool start();
+
+	/**
+	 * @brief Lelltja az ismtld adatcsert, lezrja a kapcsolatot s megjelenti a statisztikt, ha a lekrdezsek kzben problma
+	 * volt.
+	 */
+	virtual void stop();
+
+private:
+	/**
+	 * Az I/O interfsz kimeneteit bellt utasts.
+	 */
+	static const unsigned char CMD_WRITE_OUTPUT;
+
+	/**
+	 * Az I/O interfsz bemeneteit beolvas utasts.
+	 */
+	static const unsigned char CMD_READ_INPUT;
+
+	/**
+	 * Az automatikus peridus elksztshez indtskor vgzett szinkron lekrdezsek szma.
+	 */
+	static const unsigned int ROUND_TRIP_PROBE_SAMPLES;
+};
+
+#endif /* INC_POLLENGINE_H_ */
@@ -0,0 +1,53 @@
+#ifndef INC_PTYTRANSPORT_H_
+#define INC_PTYTRANSPORT_H_
+
+#include <inc\AbstractTransport.h>
+
+#include <string>
+
+#ifndef _WIN32
+
+/**
+ * @brief Pszeudoterminlon keresztli tvitel. Az objektum a pszeudoterminl mester oldalt hasznlja, a msik fl, pldul egy
+ * eszkzemultor, a szolga oldal elrsi tjt nyithatja meg gy, mintha az egy soros port lenne. Csak POSIX rendszereken rhet el.
+ */
+class PtyTransport: public AbstractTransport {
+	/**
+	 * A pszeudoterminl szolga oldalnak lerja, vagy negatv rtk, ha mg nincs megnyitva. Az objektum nyitva tartja, hogy a mester
+	 * oldal olvassa ne zruljon le hibval, amg a msik fl nem csatlakozott.
+	 */
+	int slaveDescriptor;
+
+	/**
+	 * A pszeudoterminl szolga oldalnak elrsi tja.
+	 */
+	std::string slaveName;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora.
+	 */
+	PtyTransport();
+
+	/**
+	 * @brief Az osztly virtulis destruktora. Lezrja a pszeudoterminl szolga oldalt.
+	 */
+	virtual ~PtyTransport();
+
+	/**
+	 * @brief Ltrehoz egy j pszeudoterminlt, nyers mdba lltja s a mester oldalt a soros kommunikcit megvalst objektumhoz
+	 * rendeli.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port);
+
+	/**
+	 * @return A pszeudoterminl szolga oldalnak elrsi tja, vagy res sztring, ha mg nincs megnyitva.
+	 */
+	virtual std::string describe() const;
+};
+
+#endif
+
+#endif /* INC_PTYTRANSPORT_H_ */
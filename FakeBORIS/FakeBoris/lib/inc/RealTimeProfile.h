@@ -0,0 +1,118 @@
+#ifndef INC_REALTIMEPROFILE_H_
+#define INC_REALTIMEPROFILE_H_
+
+#include <cstddef>
+#include <chrono>
+
+/**
+ * @brief Az idkritikus szlak (az ismtld adatcsere s a soros port olvassnak szla) vals idej temezsi belltsait ler s
+ * alkalmaz osztly. Alaprtelmezsben kikapcsolt llapot, ekkor egyetlen belltst sem mdost.
+ */
+class RealTimeProfile {
+	/**
+	 * A profil bekapcsolt llapott jelz bit.
+	 */
+	bool enabled;
+
+	/**
+	 * A szlak vals idej temezsi prioritsa (Linux rendszeren a SCHED_FIFO temezsi osztlyon bell, Windows rendszeren a
+	 * szlprioritsi szintekre lekpezve).
+	 */
+	int priority;
+
+	/**
+	 * Annak a processzormagnak a sorszma, amelyhez a szlakat hozz kell ktni. Negatv rtk esetn a szlak brmelyik magon futhatnak.
+	 */
+	int cpu;
+
+	/**
+	 * @brief Elzetesen vgigrinti a hv szl vermnek a megadott mret rszt, hogy a ksbbi fggvnyhvsok ne okozzanak
+	 * laphibt az idkritikus szakaszokban.
+	 */
+	static void prefaultStack();
+
+public:
+	/**
+	 * @brief Az bredsi ksleltets mrsnek eredmnyt trol struktra. Az rtkek mikroszekundumokban rtendk.
+	 */
+	struct WakeupLatency {
+		double minimum;
+		double average;
+		double percentile99;
+		double maximum;
+	};
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora, amelyik kikapcsolt profilt hoz ltre.
+	 */
+	RealTimeProfile();
+
+	/**
+	 * @brief Az osztly konstruktora, amelyik bekapcsolt profilt hoz ltre. A tartomnyon kvli priorits vagy processzormag esetn
+	 * std::invalid_argument kivtelt dob.
+	 *
+	 * @param rt_priority A szlak vals idej temezsi prioritsa MIN_PRIORITY s MAX_PRIORITY kztt.
+	 * @param cpu_index Annak a processzormagnak a sorszma, amelyhez a szlakat hozz kell ktni, vagy negatv rtk a kts mellzshez.
+	 */
+	RealTimeProfile(int rt_priority, int cpu_index);
+
+	/**
+	 * @brief Lekrdezi, hogy a profil be van-e kapcsolva.
+	 *
+	 * @return Igaz, ha a profil be van kapcsolva.
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * @brief Alkalmazza a profil folyamatszint belltsait: a folyamat sszes lapjt a fizikai memriban rgzti (mlockall), Windows
+	 * rendszeren pedig megnveli a munkakszlet mrett s a rendszeridzt felbontst.
+	 *
+	 * @return Igaz, ha minden bellts sikeresen megtrtnt.
+	 */
+	bool applyToProcess() const;
+
+	/**
+	 * @brief Alkalmazza a profil szlszint belltsait a hv szlra: vals idej priorits, processzormaghoz kts s a verem
+	 * elzetes lefoglalsa.
+	 *
+	 * @return Igaz, ha minden bellts sikeresen megtrtnt.
+	 */
+	bool applyToCurrentThread() const;
+
+	/**
+	 * @brief Megmri egy, a profil belltsaival fut szl bredsi ksleltetst a megadott peridus vrakozsok sorozatval.
+	 *
+	 * @param samples A mrsek szma.
+	 * @param period Az egyes vrakozsok hossza.
+	 * @return A mrt ksleltetsek statisztikja.
+	 */
+	WakeupLatency measureWakeupLatency(unsigned int samples, std::chrono::microseconds period) const;
+
+	/**
+	 * A szlak alaprtelmezett vals idej temezsi prioritsa.
+	 */
+	static const int DEFAULT_PRIORITY;
+
+	/**
+	 * A szlak legkisebb vals idej temezsi prioritsa.
+	 */
+	static const int MIN_PRIORITY;
+
+	/**
+	 * A szlak legnagyobb vals idej temezsi prioritsa. Windows rendszeren ez a folyamatot a vals idej prioritsi osztlyba
+	 * helyezi, kisebb priorits esetn a folyamat a magas prioritsi osztlyba kerl.
+	 */
+	static const int MAX_PRIORITY;
+
+	/**
+	 * A szlak hozzktshez megadhat legnagyobb processzormag-sorszm.
+	 */
+	static const int MAX_CPU_INDEX;
+
+	/**
+	 * A szlak vermnek elzetesen lefoglalt mrete bjtokban.
+	 */
+	static const std::size_t STACK_PREFAULT_SIZE = 64 * 1024;
+};
+
+#endif /* INC_REALTIMEPROFILE_H_ */
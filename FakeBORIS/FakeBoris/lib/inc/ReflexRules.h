@@ -0,0 +1,206 @@
+#ifndef INC_REFLEXRULES_H_
+#define INC_REFLEXRULES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A bemenetekre kzvetlenl, a vlaszok feldolgozsakor reagl reflexszablyokat trol s kirtkel osztly. Egy szably
+ * egy kimenetet r le a bemenetek fggvnyben, pldul:
+ *
+ *   Q05 = I03 AND NOT I07                A kimenet a kifejezs rtkt kveti.
+ *   Q06 = I01 OR I02 AND I04 AFTER 50ms  A kimenet csak 50 ms folyamatos teljesls utn kapcsol be (bekapcsolsi ksleltets).
+ *   Q07 = RISE I00 FOR 200ms             A kimenet az I00 felfut lnl 200 ms-ig bekapcsol (impulzus).
+ *   Q08 TOGGLE RISE I01                  A kimenet az I01 felfut lnl tvlt. SET s RESET is hasznlhat.
+ *
+ * A kifejezs tagjai Inn, NOT Inn, RISE Inn s FALL Inn lehetnek, az AND ersebben kt az OR-nl, zrjel nincs. A RISE s a FALL csak
+ * abban a vlaszban igaz, amelyben az l megjelent. A szablyok betltskor bitmaszkok lapos tblzatv fordulnak: minden S-tag ngy
+ * maszk (ktelezen 1, ktelezen 0, felfut l, lefut l), gy egy tag kirtkelse nhny bitmvelet. Az idztsek csak a
+ * vlaszok berkezsekor rtkeldnek ki, gy a felbontsuk a lekrdezs peridusa.
+ */
+class ReflexRules {
+	/**
+	 * @brief A szably ltal vgzett mvelet.
+	 */
+	enum class Action {
+		/**
+		 * A kimenet a kifejezs rtkt kveti.
+		 */
+		ASSIGN,
+
+		/**
+		 * A kimenet bekapcsol, ha a kifejezs igaz.
+		 */
+		SET,
+
+		/**
+		 * A kimenet kikapcsol, ha a kifejezs igaz.
+		 */
+		RESET,
+
+		/**
+		 * A kimenet tvlt, ha a kifejezs igaz.
+		 */
+		TOGGLE
+	};
+
+	/**
+	 * @brief A kifejezs egy S-tagja. A tag akkor igaz, ha minden felttele teljesl.
+	 */
+	struct Term {
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyeknek 1 rtknek kell lennik.
+		 */
+		std::uint16_t ones;
+
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyeknek 0 rtknek kell lennik.
+		 */
+		std::uint16_t zeros;
+
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyeknek ebben a vlaszban felfut lk van.
+		 */
+		std::uint16_t rising;
+
+		/**
+		 * Azoknak a bemeneteknek a maszkja, amelyeknek ebben a vlaszban lefut lk van.
+		 */
+		std::uint16_t falling;
+	};
+
+	/**
+	 * @brief Egy lefordtott szably s az idztseinek llapota.
+	 */
+	struct Rule {
+		/**
+		 * A szably ltal rt kimenet maszkja.
+		 */
+		std::uint16_t output;
+
+		/**
+		 * A szably ltal vgzett mvelet.
+		 */
+		Action action;
+
+		/**
+		 * A szably els S-tagjnak indexe a tagok tblzatban.
+		 */
+		std::size_t firstTerm;
+
+		/**
+		 * A szably S-tagjainak szma.
+		 */
+		std::size_t termCount;
+
+		/**
+		 * A bekapcsolsi ksleltets, vagy nulla.
+		 */
+		std::chrono::nanoseconds after;
+
+		/**
+		 * Az impulzus hossza, vagy nulla.
+		 */
+		std::chrono::nanoseconds hold;
+
+		/**
+		 * Igaz, ha a kifejezs az elz vlasznl is igaz volt.
+		 */
+		bool active;
+
+		/**
+		 * Az az idpont, amita a kifejezs folyamatosan igaz.
+		 */
+		std::chrono::steady_clock::time_point since;
+
+		/**
+		 * Az az idpont, ameddig az impulzus tart.
+		 */
+		std::chrono::steady_clock::time_point until;
+	};
+
+	/**
+	 * Az sszes szably S-tagjai egyms utn, szablyonknt sszefgg tartomnyban.
+	 */
+	std::vector<Term> terms;
+
+	/**
+	 * A szablyok a betltsk sorrendjben. Ugyanazt a kimenetet r szablyok kzl a ksbbi rvnyesl.
+	 */
+	std::vector<Rule> rules;
+
+	/**
+	 * Igaz, ha mr rkezett bemeneti llapot, gy az lek meghatrozhatk.
+	 */
+	bool initialized;
+
+	/**
+	 * Az elz bemeneti llapot az lek meghatrozshoz.
+	 */
+	std::uint16_t previousInput;
+
+	/**
+	 * @brief Beolvas egy Inn vagy Qnn alak ki- vagy bemenetnevet.
+	 *
+	 * @param token A nv.
+	 * @param prefix A nv elvrt kezdbetje.
+	 * @return A ki- vagy bemenet maszkja.
+	 */
+	static std::uint16_t parsePin(const std::string& token, char prefix);
+
+	/**
+	 * @brief Beolvas egy <n>ms, <n>us vagy <n> (ezredmsodperc) alak idtartamot.
+	 *
+	 * @param token Az idtartam.
+	 * @return Az idtartam.
+	 */
+	static std::chrono::nanoseconds parseDuration(const std::string& token);
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora, szablyok nlkl.
+	 */
+	ReflexRules();
+
+	/**
+	 * @brief Lefordt s a tblzat vgre fz egy szablyt. Hibs szably esetn std::invalid_argument kivtelt dob, s a tblzat
+	 * nem vltozik.
+	 *
+	 * @param line A szably szvege, a kulcsszavak kis- s nagybetvel is rhatk.
+	 */
+	void add(const std::string& line);
+
+	/**
+	 * @return Igaz, ha nincs egyetlen szably sem.
+	 */
+	bool empty() const;
+
+	/**
+	 * @return A szablyok szma.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief Elfelejti az elz bemeneti llapotot s az idztsek llapott, pldul a kapcsolat jbli ltrehozsa eltt.
+	 */
+	void reset();
+
+	/**
+	 * @brief Kirtkeli a szablyokat egy beolvasott bemeneti llapotra. Az eredmnyt a maszkkal kijellt kimenetek j rtkeiknt adja
+	 * vissza, a korbbi eredmnyeket fellrva, gy egy olvass tbb vlasznak eredmnye egyetlen kimenetbelltss vonhat ssze.
+	 * Egyszerre csak egy szlrl hvhat.
+	 *
+	 * @param input A 16-bites bemeneti llapot.
+	 * @param output A kimenetek jelenlegi llapota, az tvltshoz.
+	 * @param receive_time A vlasz berkezsnek ideje.
+	 * @param mask A szablyok ltal rt kimenetek maszkja, amelyhez a fggvny hozzadja a sajt kimeneteit.
+	 * @param bits A szablyok ltal rt kimenetek j rtkei.
+	 */
+	void evaluate(std::uint16_t input, std::uint16_t output, std::chrono::steady_clock::time_point receive_time, std::uint16_t& mask,
+		std::uint16_t& bits);
+};
+
+#endif /* INC_REFLEXRULES_H_ */
@@ -0,0 +1,128 @@
+#ifndef INC_REPLYDECODER_H_
+#define INC_REPLYDECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Az I/O interfsz ktbjtos vlaszait tetszlegesen darabolt vagy sszevont olvassokbl jra sszellt adatfolyam-dekdol.
+ * A berkezett bjtokat egy kis mret gyrpufferben gyjti, s a tl rgi, befejezetlen vlaszok eldobsval jraszinkronizl.
+ * Egyetlen szlrl (a soros port olvassnak szlbl) hasznlhat, a statisztikk viszont brmelyik szlrl lekrdezhetk.
+ */
+class ReplyDecoder {
+	/**
+	 * A gyrpuffer mrete bjtokban. Kett hatvnynak kell lennie.
+	 */
+	static const std::size_t RING_SIZE = 64;
+
+	/**
+	 * Egy vlasz hossza bjtokban.
+	 */
+	static const std::size_t FRAME_SIZE = 2;
+
+	/**
+	 * A berkezett, de mg fel nem dolgozott bjtokat trol gyrpuffer.
+	 */
+	unsigned char ring[RING_SIZE];
+
+	/**
+	 * A kvetkez feldolgozand bjt folyamatosan nvekv sorszma.
+	 */
+	std::size_t head;
+
+	/**
+	 * A kvetkez berkez bjt folyamatosan nvekv sorszma.
+	 */
+	std::size_t tail;
+
+	/**
+	 * A legutbbi bjt berkezsnek idpontja.
+	 */
+	std::chrono::steady_clock::time_point lastByteTime;
+
+	/**
+	 * Az az idtartam nanoszekundumokban, amelynl rgebbi befejezetlen vlaszt a dekdol eldob.
+	 */
+	std::atomic<long long int> frameGap;
+
+	/**
+	 * Az sszes eldobott bjt szma.
+	 */
+	std::atomic<unsigned long long int> droppedBytes;
+
+	/**
+	 * Az jraszinkronizlsok szma.
+	 */
+	std::atomic<unsigned long long int> resyncCount;
+
+	/**
+	 * Az sszes sikeresen dekdolt vlasz szma.
+	 */
+	std::atomic<unsigned long long int> frameCount;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	ReplyDecoder(ReplyDecoder&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	ReplyDecoder& operator=(const ReplyDecoder&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param frame_gap Az az idtartam, amelynl rgebbi befejezetlen vlaszt a dekdol eldob.
+	 */
+	explicit ReplyDecoder(std::chrono::nanoseconds frame_gap);
+
+	/**
+	 * @brief Belltja azt az idtartamot, amelynl rgebbi befejezetlen vlaszt a dekdol eldob. Brmelyik szlrl hvhat.
+	 *
+	 * @param frame_gap Az eldobs idkszbe.
+	 */
+	void setFrameGap(std::chrono::nanoseconds frame_gap);
+
+	/**
+	 * @brief Hozzadja a soros porton berkezett bjtokat a dekdoland adatfolyamhoz.
+	 *
+	 * @param data A berkezett bjtok els elemre mutat pointer.
+	 * @param size A berkezett bjtok szma.
+	 * @param timestamp A bjtok berkezsnek idpontja.
+	 */
+	void feed(const char* data, std::size_t size, std::chrono::steady_clock::time_point timestamp);
+
+	/**
+	 * @brief Kiveszi az adatfolyambl a kvetkez teljes vlaszt, amennyiben van ilyen.
+	 *
+	 * @param reply A dekdolt 16-bites bemeneti llapot.
+	 * @return Igaz, ha volt teljes vlasz az adatfolyamban.
+	 */
+	bool next(std::uint16_t& reply);
+
+	/**
+	 * @brief Eldobja a befejezetlen vlaszt, s az jraszinkronizlsok kz szmtja.
+	 */
+	void resync();
+
+	/**
+	 * @return Az sszes eldobott bjt szma.
+	 */
+	unsigned long long int getDroppedBytes() const;
+
+	/**
+	 * @return Az jraszinkronizlsok szma.
+	 */
+	unsigned long long int getResyncCount() const;
+
+	/**
+	 * @return Az sszes sikeresen dekdolt vlasz szma.
+	 */
+	unsigned long long int getFrameCount() const;
+};
+
+#endif /* INC_REPLYDECODER_H_ */
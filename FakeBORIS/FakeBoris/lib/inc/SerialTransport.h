@@ -0,0 +1,49 @@
+#ifndef INC_SERIALTRANSPORT_H_
+#define INC_SERIALTRANSPORT_H_
+
+#include <inc\AbstractTransport.h>
+
+#include <string>
+
+/**
+ * @brief Fizikai soros porton keresztli tvitel, amelyen az I/O interfsz tnylegesen csatlakozik a szmtgphez.
+ */
+class SerialTransport: public AbstractTransport {
+	/**
+	 * A soros port neve.
+	 */
+	const std::string portName;
+
+	/**
+	 * A soros port adattviteli sebessge.
+	 */
+	const unsigned int baudRate;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	SerialTransport() = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param port_name A soros port neve, pldul "COM3" vagy "/dev/ttyUSB0".
+	 * @param baud_rate A soros port adattviteli sebessge.
+	 */
+	SerialTransport(const std::string& port_name, unsigned int baud_rate);
+
+	/**
+	 * @brief Megnyitja a soros portot a belltott adattviteli sebessggel.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port);
+
+	/**
+	 * @return A soros port neve.
+	 */
+	virtual std::string describe() const;
+};
+
+#endif /* INC_SERIALTRANSPORT_H_ */
@@ -0,0 +1,55 @@
+#ifndef INC_TCPTRANSPORT_H_
+#define INC_TCPTRANSPORT_H_
+
+#include <inc\AbstractTransport.h>
+
+#include <string>
+
+#ifndef _WIN32
+
+/**
+ * @brief TCP kapcsolaton keresztli tvitel, amelynek msik vgn egy, a megadott cmen figyel fl, pldul egy eszkzemultor
+ * vagy egy soros-Ethernet talakt ll. A Nagle-algoritmus ki van kapcsolva, gy a rvid utastsok ksleltets nlkl indulnak el.
+ * Csak POSIX rendszereken rhet el.
+ */
+class TcpTransport: public AbstractTransport {
+	/**
+	 * A msik fl gpnek neve vagy cme.
+	 */
+	const std::string host;
+
+	/**
+	 * A msik fl TCP portja.
+	 */
+	const std::string service;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	TcpTransport() = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora.
+	 *
+	 * @param host_name A msik fl gpnek neve vagy cme.
+	 * @param port_number A msik fl TCP portja.
+	 */
+	TcpTransport(const std::string& host_name, const std::string& port_number);
+
+	/**
+	 * @brief Kapcsoldik a msik flhez s a kapcsolatot a soros kommunikcit megvalst objektumhoz rendeli.
+	 *
+	 * @param port A soros kommunikcit megvalst objektum.
+	 */
+	virtual void open(CallbackAsyncSerial& port);
+
+	/**
+	 * @return A msik fl cme s portja "gp:port" alakban.
+	 */
+	virtual std::string describe() const;
+};
+
+#endif
+
+#endif /* INC_TCPTRANSPORT_H_ */
@@ -0,0 +1,159 @@
+#ifndef INC_TERMINALBORIS_H_
+#define INC_TERMINALBORIS_H_
+
+#include <inc\PollEngine.h>
+#include <inc\OutputCommand.h>
+#include <inc\ConsoleRenderer.h>
+#include <inc\AnsiConsole.h>
+
+#include <string>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief A FakeBoris osztly megfelelje ANSI vezrlszekvencikat ismer terminlokra, elssorban POSIX rendszereken. Az adatcsert a
+ * PollEngine vgzi, ez az osztly a kperny trlse utn a bal fels saroktl kirajzolja az I/O interfsz karakterkpt, az llapotokat
+ * az AnsiConsole objektumon keresztl megjelent ConsoleRenderer frissti, a kimenetek mdostsait pedig a karakterkp alatti
+ * beviteli sorbl, soronknt olvassa be. A terminl a bevitt karaktereket maga visszhangozza, ezrt a szabvnyos bemenetnek s
+ * kimenetnek is terminlnak kell lennie.
+ */
+class TerminalBoris: public PollEngine {
+private:
+	/**
+	 * A fogadott jelek kijelzsnek sora a terminl koordintarendszerben.
+	 */
+	int inputLine;
+
+	/**
+	 * A kikldtt jelek kijelzsnek sora a terminl koordintarendszerben.
+	 */
+	int outputLine;
+
+	/**
+	 * A megjelents ltal birtokolt terminlra mutat pointer, amelyen keresztl a kperny trlhet.
+	 */
+	AnsiConsole* console;
+
+	/**
+	 * A bemenetek s a kimenetek llapotait korltozott kpkockasebessggel, csak a vltozsokat kirva megjelent objektum.
+	 */
+	ConsoleRenderer renderer;
+
+	/**
+	 * @brief Kirajzolja a terminl kpernyjre az I/O interfszt brzol karakterkpet.
+	 */
+	void drawIODisplay();
+
+	/**
+	 * @brief Kirja a beviteli sor alatti sorba a megadott zenetet, majd a kurzort a trlt beviteli sor elejre mozgatja. A terminl
+	 * a sortrst a bevitt sor utn maga visszhangozza, ezrt a kurzor a hvs eltt a beviteli sor alatt ll.
+	 *
+	 * @param message A kirand zenet, res sztring esetn az elz zenet trldik.
+	 */
+	void showPrompt(const std::string& message);
+
+	/**
+	 * @brief Belltja a megjelentsben egy 16-bites llapot sszes bitjt. A bitek a kvetkez kpkockban jelennek meg.
+	 *
+	 * @param y Az llapot kijelzsnek sora a terminl koordintarendszerben.
+	 * @param value A megjelentend llapot.
+	 * @param mask A megjelentend bitek maszkja.
+	 */
+	void showBits(int y, std::uint16_t value, std::uint16_t mask);
+
+	/**
+	 * @brief Megjelenti a megvltozott bemeneti llapotot.
+	 *
+	 * @param value Az j 16-bites bemeneti llapot.
+	 */
+	virtual void inputChanged(std::uint16_t value);
+
+	/**
+	 * @brief Megjelenti a reflexszablyok ltal megvltoztatott kimeneti llapotot.
+	 *
+	 * @param value Az j 16-bites kimeneti llapot.
+	 */
+	virtual void outputChanged(std::uint16_t value);
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	TerminalBoris() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	TerminalBoris(TerminalBoris&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	TerminalBoris& operator=(const TerminalBoris&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+	 *
+	 * @param transport_layer Az I/O interfsszel val kapcsolatot ltrehoz tvitel.
+	 * @param baud_rate A vonal adattviteli sebessge, amelyhez az automatikus peridus igazodik.
+	 */
+	TerminalBoris(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate);
+
+	/**
+	 * @brief Az osztly virtulis destruktora.
+	 */
+	virtual ~TerminalBoris();
+
+	/**
+	 * @brief Belltja a bemenetek s a kimenetek megjelentsnek legnagyobb kpkockasebessgt. Csak az adatcsere elindtsa eltt
+	 * van hatsa.
+	 *
+	 * @param frames_per_second A kpkockk legnagyobb szma msodpercenknt.
+	 */
+	void setFrameRate(unsigned int frames_per_second);
+
+	/**
+	 * @brief Trli a terminl kpernyjt, kirajzolja az I/O interfszt brzol karakterkpet s a sgt, majd elindtja az I/O
+	 * interfsszel trtn ismtld adatcsert.
+	 *
+	 * @return Igaz, ha a kapcsolat ltrejtt.
+	 */
+	virtual bool start();
+
+	/**
+	 * @brief Lelltja az ismtld adatcsert, lezrja a kapcsolatot s a megjelentst.
+	 */
+	virtual void stop();
+
+	/**
+	 * @brief Soronknt bekri a felhasznltl a kimenetek llapotainak megvltoztatst elidz parancsokat, amg egy sor csak a
+	 * megadott megllt karaktert tartalmazza, vagy a szabvnyos bemenet vget r.
+	 *
+	 * @param stop_char A beolvasst megszakt karakter.
+	 */
+	void readUntil(char stop_char);
+
+private:
+	/**
+	 * Az I/O interfsz testt brzol karakterkp sznt bellt vezrlszekvencia.
+	 */
+	static const char* const BODY_COLOR;
+
+	/**
+	 * Az I/O interfsz csatlakozit brzol karakterkp sznt bellt vezrlszekvencia.
+	 */
+	static const char* const PIN_COLOR;
+
+	/**
+	 * Az I/O interfsz csatlakozinak a neveit brzol karakterkp sznt bellt vezrlszekvencia.
+	 */
+	static const char* const IO_NAMES_COLOR;
+
+	/**
+	 * A terminl alaprtelmezett szneit visszallt vezrlszekvencia.
+	 */
+	static const char* const DEFAULT_COLOR;
+};
+
+#endif /* INC_TERMINALBORIS_H_ */
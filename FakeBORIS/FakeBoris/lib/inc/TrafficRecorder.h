@@ -0,0 +1,220 @@
+#ifndef INC_TRAFFICRECORDER_H_
+#define INC_TRAFFICRECORDER_H_
+
+#include <boost\interprocess\file_mapping.hpp>
+#include <boost\interprocess\mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/**
+ * @brief A soros vonalon kikldtt s fogadott bjtokat egy memriba lekpezett gyrfjlba rgzt osztly. A fjl egy rgztett
+ * mret fejlcbl s rgztett mret rekordokbl ll; minden rekord egy monoton idblyeget, az irnyt s legfeljebb
+ * RECORD_DATA_SIZE bjtot tartalmaz, a hosszabb adatok egymst kvet rekordokba kerlnek. Betelt gyr esetn a legrgebbi rekordok
+ * rdnak fell. A rgzts egy atomi helyfoglalsbl s egy memriamsolsbl ll, rendszerhvs nlkl, gy folyamatosan
+ * bekapcsolva hagyhat. A fjlt az opercis rendszer a program vratlan lellsa utn is kirja, gy egy hiba eltti forgalom
+ * utlag visszajtszhat. A rekordok sorrendjt a sorszmuk adja meg, a nulla sorszm rekord res.
+ */
+class TrafficRecorder {
+public:
+	/**
+	 * @brief Az adatforgalom irnya.
+	 */
+	enum class Direction : std::uint8_t {
+		/**
+		 * Az I/O interfsznek kikldtt bjtok.
+		 */
+		SENT = 1,
+
+		/**
+		 * Az I/O interfsztl fogadott bjtok.
+		 */
+		RECEIVED = 2
+	};
+
+	/**
+	 * @brief A fjl fejlce.
+	 */
+	struct Header {
+		/**
+		 * A fjl azonostja.
+		 */
+		char magic[8];
+
+		/**
+		 * A fjlformtum verziszma.
+		 */
+		std::uint32_t version;
+
+		/**
+		 * Egy rekord mrete bjtokban.
+		 */
+		std::uint32_t recordSize;
+
+		/**
+		 * A gyr rekordjainak szma.
+		 */
+		std::uint64_t capacity;
+
+		/**
+		 * A rgzts kezdetnek idpontja a rendszerra szerint, nanoszekundumban.
+		 */
+		std::uint64_t startTime;
+
+		/**
+		 * A rgzts kezdete ta kirt rekordok szma a rgzts lezrsakor, vagy nulla, ha a program vratlanul lellt. A rekordok
+		 * sorrendjt ettl fggetlenl a sorszmuk adja meg.
+		 */
+		std::uint64_t written;
+
+		/**
+		 * Fenntartott terlet a fejlc 64 bjtra kiegsztshez.
+		 */
+		char reserved[24];
+	};
+
+	/**
+	 * @brief Egy rekord a fjlban.
+	 */
+	struct Record {
+		/**
+		 * A rekord egytl indul sorszma, vagy nulla, ha a rekord res. A rekord kirsakor utoljra rdik.
+		 */
+		std::uint64_t sequence;
+
+		/**
+		 * A rgzts kezdete ta eltelt id a monoton ra szerint, nanoszekundumban.
+		 */
+		std::uint64_t timestamp;
+
+		/**
+		 * Az irny, s a CONTINUATION bit, ha a rekord az elz rekordban kezddtt bjtsorozat folytatsa.
+		 */
+		std::uint8_t flags;
+
+		/**
+		 * A rekordban lv bjtok szma.
+		 */
+		std::uint8_t size;
+
+		/**
+		 * A rgztett bjtok.
+		 */
+		std::uint8_t data[14];
+	};
+
+	/**
+	 * A rekordba fr bjtok legnagyobb szma.
+	 */
+	static const std::size_t RECORD_DATA_SIZE;
+
+	/**
+	 * A rekord jelzbitje, amely szerint a rekord az elz rekordban kezddtt bjtsorozat folytatsa.
+	 */
+	static const std::uint8_t CONTINUATION;
+
+	/**
+	 * A fjl azonostja.
+	 */
+	static const char MAGIC[8];
+
+	/**
+	 * A fjlformtum verziszma.
+	 */
+	static const std::uint32_t VERSION;
+
+private:
+	/**
+	 * A fjl lekpezse.
+	 */
+	boost::interprocess::file_mapping mapping;
+
+	/**
+	 * A fjl memriba lekpezett tartomnya.
+	 */
+	boost::interprocess::mapped_region region;
+
+	/**
+	 * A lekpezett fejlc.
+	 */
+	Header* header;
+
+	/**
+	 * A lekpezett rekordok.
+	 */
+	Record* records;
+
+	/**
+	 * A gyr rekordjainak szma.
+	 */
+	std::uint64_t capacity;
+
+	/**
+	 * A kvetkez rekord nulltl indul sorszma. A rgzt szlak ezzel foglalnak helyet a gyrben.
+	 */
+	std::atomic<std::uint64_t> nextRecord;
+
+	/**
+	 * A rgzts kezdetnek idpontja a monoton ra szerint.
+	 */
+	std::chrono::steady_clock::time_point startTime;
+
+	/**
+	 * A fjl neve.
+	 */
+	std::string fileName;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	TrafficRecorder() = delete;
+
+	/**
+	 * @brief Az osztly msol konstruktornak tiltsa.
+	 */
+	TrafficRecorder(TrafficRecorder&) = delete;
+
+	/**
+	 * @brief Az rtkad opertor tiltsa az osztlyra.
+	 */
+	TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora, amelyik ltrehozza vagy fellrja a fjlt s a memriba kpezi. Sikertelen ltrehozs esetn
+	 * std::exception leszrmazott kivtelt dob.
+	 *
+	 * @param file_name A fjl neve.
+	 * @param record_count A gyr rekordjainak szma.
+	 */
+	TrafficRecorder(const std::string& file_name, std::size_t record_count);
+
+	/**
+	 * @brief Az osztly destruktora, amelyik lezrja a rgztst s a lekpezett tartomnyt a fjlba rja.
+	 */
+	~TrafficRecorder();
+
+	/**
+	 * @brief Rgzt egy kikldtt vagy fogadott bjtsorozatot. Brmelyik szlrl hvhat, egy sorozat rekordjai mindig egymst kvetik.
+	 *
+	 * @param direction Az irny.
+	 * @param data A bjtok.
+	 * @param size A bjtok szma.
+	 */
+	void record(Direction direction, const char* data, std::size_t size);
+
+	/**
+	 * @return A rgzts kezdete ta kirt rekordok szma.
+	 */
+	std::uint64_t getRecordCount() const;
+
+	/**
+	 * @return A rgzts rvid lersa.
+	 */
+	std::string describe() const;
+};
+
+#endif /* INC_TRAFFICRECORDER_H_ */
@@ -0,0 +1,88 @@
+#ifndef INC_TRAFFICREPLAYER_H_
+#define INC_TRAFFICREPLAYER_H_
+
+#include <inc\TrafficRecorder.h>
+#include <AsyncSerial\AsyncSerial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A TrafficRecorder ltal rgztett adatforgalmat beolvas s egy tvitelen keresztl visszajtsz osztly. Beolvasskor a
+ * gyr rvnyes rekordjai sorszm szerint rendezdnek, s a tbb rekordra bontott bjtsorozatok jra sszellnak. Egy flbemaradt
+ * sorozat, amelynek eleje mr fellrdott a gyrben, kimarad.
+ */
+class TrafficReplayer {
+public:
+	/**
+	 * @brief Egy rgztett bjtsorozat.
+	 */
+	struct Entry {
+		/**
+		 * A rgzts kezdete ta eltelt id.
+		 */
+		std::chrono::nanoseconds time;
+
+		/**
+		 * Az irny.
+		 */
+		TrafficRecorder::Direction direction;
+
+		/**
+		 * A bjtok.
+		 */
+		std::string data;
+	};
+
+private:
+	/**
+	 * A rgztett bjtsorozatok idrendben.
+	 */
+	std::vector<Entry> entries;
+
+	/**
+	 * A rgzts kezdetnek idpontja a rendszerra szerint.
+	 */
+	std::chrono::system_clock::time_point startTime;
+
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktornak tiltsa.
+	 */
+	TrafficReplayer() = delete;
+
+public:
+	/**
+	 * @brief Az osztly konstruktora, amelyik beolvassa a rgzts fjljt. Hibs vagy nem megnyithat fjl esetn std::runtime_error
+	 * kivtelt dob.
+	 *
+	 * @param file_name A fjl neve.
+	 */
+	explicit TrafficReplayer(const std::string& file_name);
+
+	/**
+	 * @return A rgztett bjtsorozatok idrendben.
+	 */
+	const std::vector<Entry>& getEntries() const;
+
+	/**
+	 * @return A rgzts kezdetnek idpontja a rendszerra szerint.
+	 */
+	std::chrono::system_clock::time_point getStartTime() const;
+
+	/**
+	 * @brief Visszajtssza a megadott irny bjtsorozatokat a soros porton, az eredeti idkzket a sebessggel elosztva. Az els
+	 * sorozat azonnal kikldsre kerl.
+	 *
+	 * @param port A megnyitott soros port.
+	 * @param direction A visszajtszott irny: a kikldtt bjtok egy I/O interfsznek, a fogadottak egy vezrlprogramnak jtszhatk
+	 * vissza.
+	 * @param speed A gyorsts szorzja, vagy nulla a vrakozs nlkli visszajtszshoz.
+	 * @return A kikldtt bjtsorozatok szma.
+	 */
+	std::size_t replay(CallbackAsyncSerial& port, TrafficRecorder::Direction direction, double speed) const;
+};
+
+#endif /* INC_TRAFFICREPLAYER_H_ */
@@ -0,0 +1,41 @@
+#ifndef INC_WIN32CONSOLE_H_
+#define INC_WIN32CONSOLE_H_
+
+#include <inc\AbstractConsole.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+
+/**
+ * @brief A Windows konzol programozi felletn keresztl r konzol. Minden karaktersorozatot egyetlen WriteConsoleOutputCharacter
+ * hvssal r ki, amely a kurzort nem mozgatja s a karakterek sznt megtartja, gy a megjelents nem zavarja a felhasznl bevitelt.
+ * Csak Windows rendszereken rhet el.
+ */
+class Win32Console: public AbstractConsole {
+	/**
+	 * A konzol kimenetnek lerja.
+	 */
+	HANDLE handle;
+
+public:
+	/**
+	 * @brief Az osztly alaprtelmezett konstruktora. A folyamat szabvnyos kimenetnek konzoljt hasznlja.
+	 */
+	Win32Console();
+
+	/**
+	 * @brief Az osztly virtulis destruktora.
+	 */
+	virtual ~Win32Console();
+
+	/**
+	 * @brief Kirja a megadott karaktersorozatokat a konzolkpernyre, karaktersorozatonknt egy hvssal.
+	 *
+	 * @param runs A kirand karaktersorozatok.
+	 */
+	virtual void write(const std::vector<Run>& runs);
+};
+
+#endif
+
+#endif /* INC_WIN32CONSOLE_H_ */
@@ -0,0 +1,11 @@
+#include <inc\AbstractConsole.h>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+AbstractConsole::AbstractConsole() {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+AbstractConsole::~AbstractConsole() {}
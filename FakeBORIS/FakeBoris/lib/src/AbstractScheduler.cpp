@@ -3,25 +3,84 @@
 #include <thread>
 #include <condition_variable>
 #include <chrono>
+#include <algorithm>
 
 /*
 * Kln szlon futva meghvja az ismtld mveletet definil fggvnyt, majd vrakozsba kezd s a vrakozs letelst kveten ismtli
 * nmagt.
 */
 void AbstractScheduler::schedule() {
+	prepareThread();
+
 	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
-	while(isStarted && period > 0) {
-		if(condition.wait_for(threadLock, std::chrono::milliseconds(period)) == std::cv_status::timeout)
-			performScheduledAction();
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + period;
+	while(isStarted && period > std::chrono::nanoseconds::zero()) {
+		if(mode == SchedulingMode::SLEEP) {
+			if(isTriggered || condition.wait_for(threadLock, period) == std::cv_status::timeout || isTriggered) {
+				isTriggered = false;
+				performUnlocked(threadLock);
+			}
+			continue;
+		}
+
+		/* Hibrid idzts esetn vrakozs a prgsi ablak kezdetig. A prgsi ablak hosszt a processzorid-keret is korltozza. Ha a
+		vrakozst soron kvli vgrehajts krse szaktja meg, a mvelet azonnal vgrehajtdik, lellts vagy a belltsok mdostsa
+		esetn pedig a felttelek jra kirtkeldnek. */
+		std::chrono::nanoseconds budget(static_cast<long long int>(period.count() * cpuBudget));
+		std::chrono::nanoseconds spin = std::min(spinWindow, budget);
+		if(isTriggered || (condition.wait_until(threadLock, deadline - spin) == std::cv_status::no_timeout &&
+			std::chrono::steady_clock::now() < deadline - spin)) {
+			if(isTriggered) {
+				isTriggered = false;
+				performUnlocked(threadLock);
+			}
+			continue;
+		}
+
+		/* Aktv vrakozs a monoton rt figyelve a hatrid elrsig. A vrakozs alatt a zrols fel van oldva, gy a soron kvli
+		vgrehajts krse, a lellts s a belltsok mdostsa sem akad el, a soron kvli vgrehajts krse s a lellts pedig
+		azonnal megszaktja a vrakozst. */
+		threadLock.unlock();
+		while(std::chrono::steady_clock::now() < deadline && isStarted && !isTriggered) {}
+		threadLock.lock();
+		if(!isStarted)
+			continue;
+
+		/* Az ismtld mvelet vgrehajtsa. A hatrid eltti, soron kvli vgrehajts a vrakozshoz hasonlan nem mdostja a
+		hatridt. */
+		bool early = isTriggered && std::chrono::steady_clock::now() < deadline;
+		isTriggered = false;
+		performUnlocked(threadLock);
+		if(early)
+			continue;
+
+		/* A kvetkez hatrid kiszmtsa. Ha a mvelet tlfutott egy vagy tbb hatridn, a kimaradt peridusok nem ptldnak. */
+		deadline += period;
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if(deadline < now)
+			deadline = now + period;
 	}
 }
 
+/*
+ * Vgrehajtja az ismtld mveletet a zrols feloldsa mellett.
+ */
+void AbstractScheduler::performUnlocked(std::unique_lock<std::recursive_mutex>& thread_lock) {
+	thread_lock.unlock();
+	performScheduledAction();
+	thread_lock.lock();
+}
+
 /*
  * Az osztly alaprtelmezett konstruktora.
  */
 AbstractScheduler::AbstractScheduler() :
 	period(0),
-	isStarted(false) {}
+	mode(SchedulingMode::SLEEP),
+	spinWindow(0),
+	cpuBudget(0.0),
+	isStarted(false),
+	isTriggered(false) {}
 
 /*
  * Az osztly virtulis destruktora. Meglltja az ismtld mvelet szlt s megvrja a befejezdst.
@@ -31,9 +90,7 @@ AbstractScheduler::~AbstractScheduler() {
 	stop();
 
 	/* A lelltott szl befejezdsnek megvrsa. */
-	std::unique_lock<std::recursive_mutex> joinLock(joinMutex);
-	if(timerThread.joinable())
-		timerThread.join();
+	join();
 }
 
 /*
@@ -42,7 +99,7 @@ AbstractScheduler::~AbstractScheduler() {
 void AbstractScheduler::start() {
 	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
 
-	if(!isStarted && period > 0) {
+	if(!isStarted && period > std::chrono::nanoseconds::zero()) {
 		isStarted = true;
 		timerThread = std::thread(&AbstractScheduler::schedule, this);
 	}
@@ -59,11 +116,62 @@ void AbstractScheduler::stop() {
 	}	
 }
 
+/*
+ * Megvrja a lelltott ismtld mvelet szlnak befejezdst.
+ */
+void AbstractScheduler::join() {
+	std::unique_lock<std::recursive_mutex> joinLock(joinMutex);
+	if(timerThread.joinable())
+		timerThread.join();
+}
+
+/*
+ * Felbreszti az ismtld mvelet szlt s soron kvl, azonnal vgrehajtatja vele a mveletet.
+ */
+void AbstractScheduler::trigger() {
+	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
+	if(isStarted) {
+		isTriggered = true;
+		condition.notify_all();
+	}
+}
+
 /*
  * Belltja a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt.
  */
 void AbstractScheduler::setPeriod(unsigned long long int _period) {
+	setPeriod(std::chrono::milliseconds(_period));
+}
+
+/*
+ * Belltja a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt, milliszekundumnl finomabb felbontssal.
+ */
+void AbstractScheduler::setPeriod(std::chrono::nanoseconds _period) {
 	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
 	period = _period;
 	condition.notify_all();
 }
+
+/*
+ * Lekrdezi a vrakozsi idt az ismtld mvelet jbli vgrehajtsai kztt.
+ */
+std::chrono::nanoseconds AbstractScheduler::getPeriod() {
+	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
+	return period;
+}
+
+/*
+ * Belltja az ismtld mvelet idztsnek mdjt.
+ */
+void AbstractScheduler::setSchedulingMode(SchedulingMode scheduling_mode, std::chrono::nanoseconds spin_window, double cpu_budget) {
+	std::unique_lock<std::recursive_mutex> threadLock(threadMutex);
+	mode = scheduling_mode;
+	spinWindow = spin_window;
+	cpuBudget = std::max(0.0, std::min(1.0, cpu_budget));
+	condition.notify_all();
+}
+
+/*
+ * Az ismtld mvelet szln, az els vgrehajts eltt egyszer hvdik meg.
+ */
+void AbstractScheduler::prepareThread() {}
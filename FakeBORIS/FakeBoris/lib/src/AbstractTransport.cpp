@@ -0,0 +1,11 @@
+#include <inc\AbstractTransport.h>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+AbstractTransport::AbstractTransport() {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+AbstractTransport::~AbstractTransport() {}
@@ -0,0 +1,66 @@
+#include <inc\AdaptivePeriod.h>
+
+#include <algorithm>
+
+/*
+ * Az osztly konstruktora.
+ */
+AdaptivePeriod::AdaptivePeriod(unsigned int baud_rate) :
+	minimum(minimumPeriod(baud_rate)),
+	smoothedRoundTrip(0),
+	roundTripVariation(0),
+	hasSamples(false) {}
+
+/*
+ * Kiszmtja egy teljes utasts s az arra rkez vlasz tviteli idejt a megadott adattviteli sebessgen.
+ */
+std::chrono::nanoseconds AdaptivePeriod::minimumPeriod(unsigned int baud_rate) {
+	if(baud_rate == 0)
+		return std::chrono::nanoseconds::zero();
+
+	unsigned long long int bits = (COMMAND_FRAME_SIZE + REPLY_FRAME_SIZE) * BITS_PER_BYTE;
+	return std::chrono::nanoseconds(bits * 1000000000ULL / baud_rate);
+}
+
+/*
+ * Figyelembe vesz egy jabb mrt krlfordulsi idt.
+ */
+void AdaptivePeriod::addRoundTrip(std::chrono::nanoseconds round_trip) {
+	std::lock_guard<std::mutex> guard(sampleMutex);
+
+	/* Az els mrs kzvetlenl belltja a simtott rtkeket, a tovbbiak a TCP jrakldsi idztjnl is hasznlt exponencilis
+	simtssal (1/8 s 1/4 sllyal) mdostjk azokat. */
+	if(!hasSamples) {
+		smoothedRoundTrip = round_trip;
+		roundTripVariation = round_trip / 2;
+		hasSamples = true;
+	}
+	else {
+		std::chrono::nanoseconds error = round_trip - smoothedRoundTrip;
+		roundTripVariation += ((error < std::chrono::nanoseconds::zero() ? -error : error) - roundTripVariation) / 4;
+		smoothedRoundTrip += error / 8;
+	}
+}
+
+/*
+ * Kiszmtja az aktulis lekrdezsi peridust.
+ */
+std::chrono::nanoseconds AdaptivePeriod::period(unsigned int pipeline_depth) const {
+	std::lock_guard<std::mutex> guard(sampleMutex);
+	return std::max(minimum, (smoothedRoundTrip + 4 * roundTripVariation) / std::max(pipeline_depth, 1u));
+}
+
+/*
+ * Az utastskeret hossznak inicializlsa.
+ */
+const unsigned int AdaptivePeriod::COMMAND_FRAME_SIZE = 4;
+
+/*
+ * A vlaszkeret hossznak inicializlsa.
+ */
+const unsigned int AdaptivePeriod::REPLY_FRAME_SIZE = 2;
+
+/*
+ * Egy bjt tvitelhez szksges bitek szmnak inicializlsa (8N1 keretezs).
+ */
+const unsigned int AdaptivePeriod::BITS_PER_BYTE = 10;
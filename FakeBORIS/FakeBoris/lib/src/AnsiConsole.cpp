@@ -0,0 +1,64 @@
+#include <inc\AnsiConsole.h>
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <Windows.h>
+
+/* A rgebbi Windows SDK-k mg nem ismerik a virtulis terminl md jelzjt. */
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#endif
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+AnsiConsole::AnsiConsole() :
+	AbstractConsole() {
+#ifdef _WIN32
+	/* A virtulis terminl md bekapcsolsa. Ha a konzol nem ismeri, a vezrlszekvencik karakterknt jelennek meg. */
+	HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+	DWORD mode = 0;
+	if(GetConsoleMode(handle, &mode))
+		SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+AnsiConsole::~AnsiConsole() {}
+
+/*
+ * Trli a terminl kpernyjt s a kurzort a bal fels sarokba mozgatja.
+ */
+void AnsiConsole::clear() {
+	std::cout << "\x1b[2J\x1b[H" << std::flush;
+}
+
+/*
+ * Kirja a megadott karaktersorozatokat a terminlra egyetlen kirssal.
+ */
+void AnsiConsole::write(const std::vector<Run>& runs) {
+	if(runs.empty())
+		return;
+
+	/* A kurzor helyzetnek mentse, majd minden karaktersorozat el a kurzort a sorozat elejre mozgat szekvencia. A terminl
+	koordinti egytl kezddnek. */
+	buffer.clear();
+	buffer += "\x1b" "7";
+	for(const Run& run : runs) {
+		buffer += "\x1b[";
+		buffer += std::to_string(run.y + 1);
+		buffer += ';';
+		buffer += std::to_string(run.x + 1);
+		buffer += 'H';
+		buffer.append(run.text, run.length);
+	}
+
+	/* A kurzor visszalltsa a mentett helyzetbe s a teljes puffer kikldse egyszerre. */
+	buffer += "\x1b" "8";
+	std::cout.write(buffer.data(), buffer.size());
+	std::cout.flush();
+}
@@ -0,0 +1,255 @@
+#include <inc\BatchSimulator.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * Megkeresi a legalacsonyabb helyirtk egyes bitet.
+ */
+unsigned int BatchSimulator::countTrailingZeros(std::uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<unsigned int>(index);
+#elif defined(_MSC_VER)
+	/* 32-bites fordtsnl a keress kt flszban trtnik. */
+	unsigned long index;
+	if(_BitScanForward(&index, static_cast<unsigned long>(word)))
+		return static_cast<unsigned int>(index);
+	_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+	return static_cast<unsigned int>(index) + 32;
+#else
+	return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+}
+
+/*
+ * Az osztly konstruktora.
+ */
+BatchSimulator::BatchSimulator(const BlockDiagram& diagram, std::chrono::nanoseconds step_time) :
+	program(diagram.getProgram()),
+	operands(diagram.getOperands()),
+	values(BlockDiagram::FIRST_BLOCK + diagram.getProgram().size(), 0),
+	previous(program.size(), 0),
+	q(program.size(), 0),
+	laneData(program.size() * LANES, 0),
+	stepCount(0) {
+	if(step_time <= std::chrono::nanoseconds::zero())
+		throw std::invalid_argument("a lpskznek pozitvnak kell lennie");
+	for(unsigned int i = 0; i < 16; i++)
+		outputSources[i] = diagram.getOutputSource(i);
+
+	/* Az idztk ideje lpsekben: egy idzt akkor jr le, ha az indtsa ta eltelt lpsek ideje elri az idejt. */
+	for(const BlockDiagram::Instruction& instruction : program) {
+		std::chrono::nanoseconds::rep steps = (instruction.duration.count() + step_time.count() - 1) / step_time.count();
+		durationSteps.push_back(static_cast<std::uint32_t>((std::min)(steps,
+			static_cast<std::chrono::nanoseconds::rep>((std::numeric_limits<std::uint32_t>::max)()))));
+	}
+	reset();
+}
+
+/*
+ * Minden svon alaphelyzetbe lltja a trolkat, az idztket s a szmllkat.
+ */
+void BatchSimulator::reset() {
+	std::fill(values.begin(), values.end(), 0);
+	values[BlockDiagram::CONSTANT_ZERO + 1] = ~0ull;
+	std::fill(previous.begin(), previous.end(), 0);
+	std::fill(q.begin(), q.end(), 0);
+	std::fill(laneData.begin(), laneData.end(), 0);
+	stepCount = 0;
+}
+
+/*
+ * Lefuttat egy lpst mind a 64 svon.
+ */
+void BatchSimulator::step(const std::uint64_t inputs[16], std::uint64_t outputs[16]) {
+	std::copy(inputs, inputs + 16, values.begin() + BlockDiagram::FIRST_INPUT);
+
+	/* Az utastsok vgrehajtsa a BlockDiagram sorrendjben s szablyai szerint, a logikai mveletek helyett bitmveletekkel. */
+	for(std::size_t i = 0; i < program.size(); i++) {
+		const BlockDiagram::Instruction& instruction = program[i];
+		const std::uint32_t* operand = &operands[instruction.firstOperand];
+		std::uint32_t* data = &laneData[i * LANES];
+		std::uint64_t a = values[operand[0]];
+		std::uint64_t b = instruction.operandCount > 1 ? values[operand[1]] : 0;
+		std::uint64_t result, lanes;
+		switch(instruction.opcode) {
+		case BlockDiagram::Opcode::AND:
+		case BlockDiagram::Opcode::NAND:
+			result = ~0ull;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result &= values[operand[k]];
+			if(instruction.opcode == BlockDiagram::Opcode::NAND)
+				result = ~result;
+			break;
+		case BlockDiagram::Opcode::OR:
+		case BlockDiagram::Opcode::NOR:
+			result = 0;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result |= values[operand[k]];
+			if(instruction.opcode == BlockDiagram::Opcode::NOR)
+				result = ~result;
+			break;
+		case BlockDiagram::Opcode::XOR:
+			result = 0;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result ^= values[operand[k]];
+			break;
+		case BlockDiagram::Opcode::NOT:
+			result = ~a;
+			break;
+		case BlockDiagram::Opcode::COPY:
+			result = a;
+			break;
+		case BlockDiagram::Opcode::RS:
+			result = q[i] = ~b & (a | q[i]);
+			break;
+		case BlockDiagram::Opcode::SR:
+			result = q[i] = a | (~b & q[i]);
+			break;
+		case BlockDiagram::Opcode::D:
+			lanes = b & ~previous[i];
+			result = q[i] = (q[i] & ~lanes) | (a & lanes);
+			previous[i] = b;
+			break;
+		case BlockDiagram::Opcode::T:
+			result = q[i] ^= a & ~previous[i];
+			previous[i] = a;
+			break;
+		case BlockDiagram::Opcode::TON:
+			/* Az indts lpsnek rgztse a felfut lek svjain, majd a lejrat vizsglata csak a bekapcsolt bemenet svokon. */
+			for(lanes = a & ~previous[i]; lanes != 0; lanes &= lanes - 1)
+				data[countTrailingZeros(lanes)] = stepCount;
+			previous[i] = a;
+			result = 0;
+			for(lanes = a; lanes != 0; lanes &= lanes - 1) {
+				unsigned int lane = countTrailingZeros(lanes);
+				if(stepCount - data[lane] >= durationSteps[i])
+					result |= 1ull << lane;
+			}
+			break;
+		case BlockDiagram::Opcode::TOF:
+			for(lanes = ~a & previous[i]; lanes != 0; lanes &= lanes - 1)
+				data[countTrailingZeros(lanes)] = stepCount;
+			previous[i] = a;
+			result = a;
+			for(lanes = q[i] & ~a; lanes != 0; lanes &= lanes - 1) {
+				unsigned int lane = countTrailingZeros(lanes);
+				if(stepCount - data[lane] < durationSteps[i])
+					result |= 1ull << lane;
+			}
+			q[i] = result;
+			break;
+		case BlockDiagram::Opcode::TP:
+			for(lanes = a & ~previous[i] & ~q[i]; lanes != 0; lanes &= lanes - 1)
+				data[countTrailingZeros(lanes)] = stepCount;
+			q[i] |= a & ~previous[i];
+			previous[i] = a;
+			for(lanes = q[i]; lanes != 0; lanes &= lanes - 1) {
+				unsigned int lane = countTrailingZeros(lanes);
+				if(stepCount - data[lane] >= durationSteps[i])
+					q[i] &= ~(1ull << lane);
+			}
+			result = q[i];
+			break;
+		default:
+			/* A szmllk svonknt szmolnak, de csak a trlt s a felfut l svokon vltoznak. Az elrt rtk elrse a kimenet
+			troljban marad meg. */
+			for(lanes = b; lanes != 0; lanes &= lanes - 1)
+				data[countTrailingZeros(lanes)] = 0;
+			for(lanes = a & ~previous[i] & ~b; lanes != 0; lanes &= lanes - 1) {
+				unsigned int lane = countTrailingZeros(lanes);
+				if(data[lane] < instruction.preset)
+					data[lane]++;
+			}
+			previous[i] = a;
+			if(instruction.preset == 0) {
+				result = ~0ull;
+				break;
+			}
+			result = q[i] & ~b;
+			for(lanes = ~result & ~b; lanes != 0; lanes &= lanes - 1) {
+				unsigned int lane = countTrailingZeros(lanes);
+				if(data[lane] >= instruction.preset)
+					result |= 1ull << lane;
+			}
+			q[i] = result;
+			break;
+		}
+		values[instruction.result] = result;
+	}
+	stepCount++;
+
+	for(unsigned int i = 0; i < 16; i++)
+		outputs[i] = outputSources[i] != 0 ? values[outputSources[i]] : 0;
+}
+
+/*
+ * Lefuttat egy lpst mind a 64 svon, svonknt egy 16-bites szval megadott bemenetekkel.
+ */
+void BatchSimulator::step(const std::uint16_t inputs[], std::uint16_t outputs[]) {
+	std::uint64_t inputLanes[16], outputLanes[16];
+	toLanes(inputs, inputLanes);
+	step(inputLanes, outputLanes);
+	fromLanes(outputLanes, outputs);
+}
+
+/*
+ * Kirtkeli a kapcsolst mind a 65536 bemeneti llapotra.
+ */
+std::vector<std::uint16_t> BatchSimulator::sweep() {
+	/* Egy kteg 64 egymst kvet bemeneti llapot: az als hat bit svonknt vltozik, ezek szavai lland bitmintk, a fels tz
+	bit a kteg sorszma, ezek szavai csupa egyesek vagy nullk. */
+	static const std::uint64_t LOW_BITS[6] = {
+		0xaaaaaaaaaaaaaaaaull, 0xccccccccccccccccull, 0xf0f0f0f0f0f0f0f0ull,
+		0xff00ff00ff00ff00ull, 0xffff0000ffff0000ull, 0xffffffff00000000ull
+	};
+	std::vector<std::uint16_t> table(INPUT_COMBINATIONS);
+	std::uint64_t inputs[16], outputs[16];
+	std::copy(LOW_BITS, LOW_BITS + 6, inputs);
+	for(std::size_t batch = 0; batch < INPUT_COMBINATIONS / LANES; batch++) {
+		for(unsigned int bit = 6; bit < 16; bit++)
+			inputs[bit] = ((batch >> (bit - 6)) & 1) ? ~0ull : 0;
+		reset();
+		step(inputs, outputs);
+		fromLanes(outputs, &table[batch * LANES]);
+	}
+	return table;
+}
+
+/*
+ * trendezi a svonknti 16-bites szavakat bitenknti 64-bites szavakk.
+ */
+void BatchSimulator::toLanes(const std::uint16_t words[], std::uint64_t lanes[16]) {
+	std::fill(lanes, lanes + 16, 0);
+	for(unsigned int lane = 0; lane < LANES; lane++) {
+		for(std::uint16_t word = words[lane]; word != 0; word &= word - 1)
+			lanes[countTrailingZeros(word)] |= 1ull << lane;
+	}
+}
+
+/*
+ * trendezi a bitenknti 64-bites szavakat svonknti 16-bites szavakk.
+ */
+void BatchSimulator::fromLanes(const std::uint64_t lanes[16], std::uint16_t words[]) {
+	std::fill(words, words + LANES, 0);
+	for(unsigned int bit = 0; bit < 16; bit++) {
+		for(std::uint64_t word = lanes[bit]; word != 0; word &= word - 1)
+			words[countTrailingZeros(word)] |= static_cast<std::uint16_t>(1 << bit);
+	}
+}
+
+/*
+ * Az egyszerre kirtkelt forgatknyvek szmnak inicializlsa.
+ */
+const unsigned int BatchSimulator::LANES = 64;
+
+/*
+ * A kimert bejrs bemeneti llapotai szmnak inicializlsa.
+ */
+const std::size_t BatchSimulator::INPUT_COMBINATIONS = 65536;
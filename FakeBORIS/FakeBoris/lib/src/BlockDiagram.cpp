@@ -0,0 +1,424 @@
+#include <inc\BlockDiagram.h>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+/*
+ * Beolvas egy idtartamot.
+ */
+std::chrono::nanoseconds BlockDiagram::parseDuration(const std::string& token) {
+	std::size_t digits = 0;
+	while(digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits])))
+		digits++;
+	std::string unit = token.substr(digits);
+	if(digits == 0 || digits > 9 || (unit != "MS" && unit != "US" && unit != "S"))
+		throw std::invalid_argument("rvnytelen idtartam: " + token);
+	unsigned long int value = std::stoul(token.substr(0, digits));
+	if(unit == "US")
+		return std::chrono::microseconds(value);
+	if(unit == "S")
+		return std::chrono::seconds(value);
+	return std::chrono::milliseconds(value);
+}
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+BlockDiagram::BlockDiagram() :
+	values(FIRST_BLOCK, 0),
+	outputMask(0),
+	feedbackCount(0) {
+	values[CONSTANT_ZERO + 1] = 1;
+	std::fill(outputSources, outputSources + 16, 0);
+}
+
+/*
+ * Betlti s lefordtja a kapcsolst a blokklistbl.
+ */
+void BlockDiagram::load(std::istream& input) {
+	/* Egy beolvasott, de mg le nem fordtott blokk. */
+	struct Block {
+		std::string name;
+		Opcode opcode;
+		std::vector<std::string> operands;
+		std::chrono::nanoseconds duration;
+		std::uint32_t preset;
+		std::size_t line;
+	};
+	static const std::map<std::string, Opcode> opcodes = {
+		{ "AND", Opcode::AND }, { "OR", Opcode::OR }, { "XOR", Opcode::XOR }, { "NAND", Opcode::NAND }, { "NOR", Opcode::NOR },
+		{ "NOT", Opcode::NOT }, { "RS", Opcode::RS }, { "SR", Opcode::SR }, { "D", Opcode::D }, { "T", Opcode::T },
+		{ "TON", Opcode::TON }, { "TOF", Opcode::TOF }, { "TP", Opcode::TP }, { "CTU", Opcode::CTU }
+	};
+	auto isPin = [](const std::string& name, char prefix) {
+		return name.size() >= 2 && name.size() <= 3 && name[0] == prefix &&
+			std::all_of(name.begin() + 1, name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+	};
+
+	/* A blokklista soronknti beolvassa. A kulcsszavak s a nevek nagybetsek lesznek, az egyenlsgjel szkzk nlkl is llhat. */
+	std::vector<Block> blocks;
+	std::map<std::string, std::size_t> names;
+	std::string line;
+	for(std::size_t lineNumber = 1; std::getline(input, line); lineNumber++) {
+		std::string text;
+		for(char c : line.substr(0, line.find('#'))) {
+			if(c == '=')
+				text += " = ";
+			else
+				text += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+		}
+		std::istringstream stream(text);
+		std::vector<std::string> tokens;
+		std::string token;
+		while(stream >> token)
+			tokens.push_back(token);
+		if(tokens.empty())
+			continue;
+
+		try {
+			if(tokens.size() < 3 || tokens[1] != "=")
+				throw std::invalid_argument("hinyos blokk: " + line);
+
+			/* A blokk neve: egy kimenet, vagy betvel kezdd nv, amely nem tkzik a bemenetekkel s a tbbi blokkal. */
+			Block block;
+			block.name = tokens[0];
+			block.line = lineNumber;
+			if(isPin(block.name, 'Q') && std::stoul(block.name.substr(1)) > 15)
+				throw std::invalid_argument("rvnytelen kimenet: " + block.name);
+			if(!std::isalpha(static_cast<unsigned char>(block.name[0])) || isPin(block.name, 'I') || opcodes.count(block.name) != 0 ||
+				!std::all_of(block.name.begin(), block.name.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }))
+				throw std::invalid_argument("rvnytelen nv: " + block.name);
+			if(names.count(block.name) != 0)
+				throw std::invalid_argument("mr ltez nv: " + block.name);
+
+			/* A blokk fajtja s operandusai. Kulcssz nlkl a blokk egyetlen rtk tvtele. */
+			auto opcode = opcodes.find(tokens[2]);
+			if(opcode == opcodes.end()) {
+				if(tokens.size() != 3)
+					throw std::invalid_argument("ismeretlen blokk: " + tokens[2]);
+				block.opcode = Opcode::COPY;
+				block.operands.push_back(tokens[2]);
+			}
+			else {
+				block.opcode = opcode->second;
+				block.operands.assign(tokens.begin() + 3, tokens.end());
+			}
+
+			/* Az idztk utols operandusa az idtartam, a szmllk az elrt rtk. */
+			block.duration = std::chrono::nanoseconds::zero();
+			block.preset = 0;
+			if((block.opcode == Opcode::TON || block.opcode == Opcode::TOF || block.opcode == Opcode::TP) && !block.operands.empty()) {
+				block.duration = parseDuration(block.operands.back());
+				block.operands.pop_back();
+			}
+			else if(block.opcode == Opcode::CTU && !block.operands.empty()) {
+				const std::string& preset = block.operands.back();
+				if(preset.empty() || preset.size() > 9 ||
+					!std::all_of(preset.begin(), preset.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }))
+					throw std::invalid_argument("rvnytelen elrt rtk: " + preset);
+				block.preset = static_cast<std::uint32_t>(std::stoul(preset));
+				block.operands.pop_back();
+			}
+
+			/* Az operandusok szmnak ellenrzse. */
+			std::size_t minimum = 1, maximum = 1;
+			switch(block.opcode) {
+			case Opcode::AND:
+			case Opcode::OR:
+			case Opcode::XOR:
+			case Opcode::NAND:
+			case Opcode::NOR:
+				minimum = 2;
+				maximum = (std::numeric_limits<std::size_t>::max)();
+				break;
+			case Opcode::RS:
+			case Opcode::SR:
+			case Opcode::D:
+			case Opcode::CTU:
+				minimum = maximum = 2;
+				break;
+			default:
+				break;
+			}
+			if(block.operands.size() < minimum || block.operands.size() > maximum)
+				throw std::invalid_argument("a(z) " + tokens[2] + " blokknak " + (minimum == maximum ? "" : "legalbb ") +
+					std::to_string(minimum) + " bemenete van: " + line);
+
+			names[block.name] = blocks.size();
+			blocks.push_back(block);
+		}
+		catch(std::invalid_argument& e) {
+			throw std::invalid_argument(std::to_string(lineNumber) + ". sor: " + e.what());
+		}
+	}
+
+	/* Az operandusok feloldsa az rtktmb indexeire. A blokkokra egyelre a blokklistabeli sorszmukkal hivatkozik. */
+	std::vector<std::vector<std::uint32_t>> resolved(blocks.size());
+	for(std::size_t i = 0; i < blocks.size(); i++) {
+		for(const std::string& operand : blocks[i].operands) {
+			auto block = names.find(operand);
+			if(operand == "0" || operand == "1")
+				resolved[i].push_back(CONSTANT_ZERO + (operand == "1" ? 1 : 0));
+			else if(isPin(operand, 'I') && std::stoul(operand.substr(1)) <= 15)
+				resolved[i].push_back(FIRST_INPUT + static_cast<std::uint32_t>(std::stoul(operand.substr(1))));
+			else if(block != names.end())
+				resolved[i].push_back(FIRST_BLOCK + static_cast<std::uint32_t>(block->second));
+			else
+				throw std::invalid_argument(std::to_string(blocks[i].line) + ". sor: ismeretlen operandus: " + operand);
+		}
+	}
+
+	/* A blokkok topologikus rendezse mlysgi bejrssal, a blokklista sorrendjben indtva, gy fggsg hinyban a sorrend
+	megmarad. A bejrs alatt ll blokkra mutat l visszacsatols: ezt az operandust a rendezs nem kveti, gy az a blokk elz
+	ciklusbeli rtkt olvassa. */
+	std::vector<int> marks(blocks.size(), 0);
+	std::vector<std::uint32_t> position(blocks.size());
+	std::vector<std::size_t> order;
+	std::size_t feedbacks = 0;
+	for(std::size_t root = 0; root < blocks.size(); root++) {
+		if(marks[root] != 0)
+			continue;
+		std::vector<std::pair<std::size_t, std::size_t>> stack(1, std::make_pair(root, 0));
+		marks[root] = 1;
+		while(!stack.empty()) {
+			std::size_t current = stack.back().first, next = stack.back().second;
+			if(next == resolved[current].size()) {
+				marks[current] = 2;
+				position[current] = static_cast<std::uint32_t>(order.size());
+				order.push_back(current);
+				stack.pop_back();
+				continue;
+			}
+			stack.back().second++;
+			std::uint32_t operand = resolved[current][next];
+			if(operand < FIRST_BLOCK)
+				continue;
+			std::size_t dependency = operand - FIRST_BLOCK;
+			if(marks[dependency] == 0) {
+				marks[dependency] = 1;
+				stack.push_back(std::make_pair(dependency, 0));
+			}
+			else if(marks[dependency] == 1) {
+				feedbacks++;
+			}
+		}
+	}
+
+	/* A lapos utaststmb sszelltsa a rendezs sorrendjben. A blokkok rtkei is ebben a sorrendben kvetik egymst, gy egy
+	ciklus az rtktmbt is elrefel haladva rja. */
+	std::vector<Instruction> compiledProgram;
+	std::vector<std::uint32_t> compiledOperands;
+	std::uint32_t sources[16] = { 0 };
+	std::uint16_t mask = 0;
+	for(std::size_t index : order) {
+		const Block& block = blocks[index];
+		Instruction instruction;
+		instruction.opcode = block.opcode;
+		instruction.result = FIRST_BLOCK + position[index];
+		instruction.firstOperand = static_cast<std::uint32_t>(compiledOperands.size());
+		instruction.operandCount = static_cast<std::uint32_t>(resolved[index].size());
+		instruction.duration = block.duration;
+		instruction.preset = block.preset;
+		for(std::uint32_t operand : resolved[index])
+			compiledOperands.push_back(operand < FIRST_BLOCK ? operand : FIRST_BLOCK + position[operand - FIRST_BLOCK]);
+		compiledProgram.push_back(instruction);
+
+		if(isPin(block.name, 'Q')) {
+			unsigned int output = static_cast<unsigned int>(std::stoul(block.name.substr(1)));
+			sources[output] = instruction.result;
+			mask |= static_cast<std::uint16_t>(1 << output);
+		}
+	}
+
+	/* A lefordtott kapcsols tvtele, csak hibtlan blokklista esetn. */
+	program.swap(compiledProgram);
+	operands.swap(compiledOperands);
+	std::copy(sources, sources + 16, outputSources);
+	outputMask = mask;
+	feedbackCount = feedbacks;
+	states.resize(program.size());
+	values.resize(FIRST_BLOCK + program.size());
+	reset();
+}
+
+/*
+ * Alaphelyzetbe lltja a trolkat, az idztket s a szmllkat.
+ */
+void BlockDiagram::reset() {
+	for(BlockState& state : states) {
+		state.previous = false;
+		state.q = false;
+		state.since = std::chrono::steady_clock::time_point();
+		state.count = 0;
+	}
+	std::fill(values.begin() + FIRST_INPUT, values.end(), 0);
+}
+
+/*
+ * Lefuttat egy ciklust a megadott bemeneti llapottal.
+ */
+std::uint16_t BlockDiagram::run(std::uint16_t input, std::chrono::steady_clock::time_point now) {
+	for(std::uint32_t i = 0; i < 16; i++)
+		values[FIRST_INPUT + i] = static_cast<std::uint8_t>((input >> i) & 1);
+
+	/* Az utastsok vgrehajtsa sorban. Minden utasts csak az operandusai rtkt olvassa s a sajt rtkt rja, a sorrend
+	miatt az operandusok ebben a ciklusban mr kiszmolt rtkek, a visszacsatolsok kivtelvel. */
+	for(std::size_t i = 0; i < program.size(); i++) {
+		const Instruction& instruction = program[i];
+		const std::uint32_t* operand = &operands[instruction.firstOperand];
+		BlockState& state = states[i];
+		bool a = values[operand[0]] != 0;
+		bool b = instruction.operandCount > 1 && values[operand[1]] != 0;
+		bool result;
+		switch(instruction.opcode) {
+		case Opcode::AND:
+		case Opcode::NAND:
+			result = true;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result = result && values[operand[k]] != 0;
+			result = result != (instruction.opcode == Opcode::NAND);
+			break;
+		case Opcode::OR:
+		case Opcode::NOR:
+			result = false;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result = result || values[operand[k]] != 0;
+			result = result != (instruction.opcode == Opcode::NOR);
+			break;
+		case Opcode::XOR:
+			result = false;
+			for(std::uint32_t k = 0; k < instruction.operandCount; k++)
+				result = result != (values[operand[k]] != 0);
+			break;
+		case Opcode::NOT:
+			result = !a;
+			break;
+		case Opcode::COPY:
+			result = a;
+			break;
+		case Opcode::RS:
+			result = state.q = !b && (a || state.q);
+			break;
+		case Opcode::SR:
+			result = state.q = a || (!b && state.q);
+			break;
+		case Opcode::D:
+			if(b && !state.previous)
+				state.q = a;
+			state.previous = b;
+			result = state.q;
+			break;
+		case Opcode::T:
+			if(a && !state.previous)
+				state.q = !state.q;
+			state.previous = a;
+			result = state.q;
+			break;
+		case Opcode::TON:
+			/* Bekapcsolsi ksleltets: a kimenet akkor kapcsol be, ha a bemenet a megadott ideje folyamatosan igaz. */
+			if(a && !state.previous)
+				state.since = now;
+			state.previous = a;
+			result = a && now - state.since >= instruction.duration;
+			break;
+		case Opcode::TOF:
+			/* Kikapcsolsi ksleltets: a kimenet a bemenet kikapcsolsa utn mg a megadott ideig bekapcsolva marad. */
+			if(!a && state.previous)
+				state.since = now;
+			state.previous = a;
+			result = state.q = a || (state.q && now - state.since < instruction.duration);
+			break;
+		case Opcode::TP:
+			/* Impulzus: a bemenet felfut lnl a kimenet a megadott ideig bekapcsol, s kzben nem indthat jra. */
+			if(a && !state.previous && !state.q) {
+				state.q = true;
+				state.since = now;
+			}
+			state.previous = a;
+			if(state.q && now - state.since >= instruction.duration)
+				state.q = false;
+			result = state.q;
+			break;
+		default:
+			/* Szmll: a szmll bemenet felfut leit az elrt rtkig szmolja, a trls bemenet lenullzza. */
+			if(b)
+				state.count = 0;
+			else if(a && !state.previous && state.count < instruction.preset)
+				state.count++;
+			state.previous = a;
+			result = state.count >= instruction.preset;
+			break;
+		}
+		values[instruction.result] = result ? 1 : 0;
+	}
+
+	/* A meghajtott kimenetek sszegyjtse. */
+	std::uint16_t output = 0;
+	for(std::uint32_t i = 0; i < 16; i++) {
+		if(outputSources[i] != 0 && values[outputSources[i]] != 0)
+			output |= static_cast<std::uint16_t>(1 << i);
+	}
+	return output;
+}
+
+/*
+ * Visszaadja a kapcsols ltal meghajtott kimenetek maszkjt.
+ */
+std::uint16_t BlockDiagram::getOutputMask() const {
+	return outputMask;
+}
+
+/*
+ * Visszaadja a lefordtott utastsok szmt.
+ */
+std::size_t BlockDiagram::getInstructionCount() const {
+	return program.size();
+}
+
+/*
+ * Visszaadja a visszacsatolsok szmt.
+ */
+std::size_t BlockDiagram::getFeedbackCount() const {
+	return feedbackCount;
+}
+
+/*
+ * Visszaadja a topologikusan rendezett utastsokat.
+ */
+const std::vector<BlockDiagram::Instruction>& BlockDiagram::getProgram() const {
+	return program;
+}
+
+/*
+ * Visszaadja az utastsok operandusainak indexeit.
+ */
+const std::vector<std::uint32_t>& BlockDiagram::getOperands() const {
+	return operands;
+}
+
+/*
+ * Visszaadja a kimenetet meghajt rtk indext.
+ */
+std::uint32_t BlockDiagram::getOutputSource(unsigned int output) const {
+	return output < 16 ? outputSources[output] : 0;
+}
+
+/*
+ * A 0 konstans indexnek inicializlsa.
+ */
+const std::uint32_t BlockDiagram::CONSTANT_ZERO = 0;
+
+/*
+ * Az I00 bemenet indexnek inicializlsa.
+ */
+const std::uint32_t BlockDiagram::FIRST_INPUT = 2;
+
+/*
+ * Az els blokk indexnek inicializlsa.
+ */
+const std::uint32_t BlockDiagram::FIRST_BLOCK = 18;
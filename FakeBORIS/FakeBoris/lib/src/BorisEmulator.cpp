@@ -0,0 +1,299 @@
+#include <inc\BorisEmulator.h>
+
+#include <algorithm>
+
+/*
+ * Az osztly konstruktora.
+ */
+BorisEmulator::BorisEmulator(std::unique_ptr<AbstractTransport> transport_layer) :
+	transport(std::move(transport_layer)),
+	latency(std::chrono::nanoseconds::zero()),
+	jitter(std::chrono::nanoseconds::zero()),
+	fragmentSize(0),
+	fragmentGap(std::chrono::nanoseconds::zero()),
+	byteTime(std::chrono::nanoseconds::zero()),
+	scriptLength(std::chrono::nanoseconds::zero()),
+	constantInput(0),
+	commandLength(0),
+	output(0),
+	running(false),
+	random(std::random_device()()),
+	writeCount(0),
+	readCount(0),
+	unknownCount(0) {}
+
+/*
+ * Az osztly destruktora.
+ */
+BorisEmulator::~BorisEmulator() {
+	stop();
+}
+
+/*
+ * Belltja a lekrdezsek megvlaszolsnak ksleltetst.
+ */
+void BorisEmulator::setLatency(std::chrono::nanoseconds reply_latency, std::chrono::nanoseconds reply_jitter) {
+	latency = (std::max)(std::chrono::nanoseconds::zero(), reply_latency);
+	jitter = (std::max)(std::chrono::nanoseconds::zero(), reply_jitter);
+}
+
+/*
+ * Belltja a vlaszok darabolst.
+ */
+void BorisEmulator::setFragmentation(std::size_t fragment_size, std::chrono::nanoseconds fragment_gap) {
+	fragmentSize = fragment_size;
+	fragmentGap = (std::max)(std::chrono::nanoseconds::zero(), fragment_gap);
+}
+
+/*
+ * Belltja a szimullt soros vonal adattviteli sebessgt.
+ */
+void BorisEmulator::setLineRate(unsigned int baud_rate) {
+	byteTime = baud_rate > 0 ? std::chrono::nanoseconds(10000000000LL / baud_rate) : std::chrono::nanoseconds::zero();
+}
+
+/*
+ * lland bemeneti llapotot llt be.
+ */
+void BorisEmulator::setInput(std::uint16_t value) {
+	constantInput = value;
+	inputScript.clear();
+	scriptLength = std::chrono::nanoseconds::zero();
+}
+
+/*
+ * Belltja a bemenetek ismtld jelalakjt.
+ */
+void BorisEmulator::setInputScript(const std::vector<InputStep>& script) {
+	inputScript = script;
+	scriptLength = std::chrono::nanoseconds::zero();
+	for(const InputStep& step : inputScript)
+		scriptLength += step.duration;
+}
+
+/*
+ * Belltja a kimenetek megvltozsakor meghvott fggvnyt.
+ */
+void BorisEmulator::setOutputHandler(const OutputHandler& handler) {
+	outputHandler = handler;
+}
+
+/*
+ * Ltrehozza az eszkzoldali kapcsolatot s elindtja az utastsok fogadst.
+ */
+void BorisEmulator::start() {
+	commandLength = 0;
+	replies.clear();
+	startTime = std::chrono::steady_clock::now();
+	lastDeadline = startTime;
+	receiveClock = startTime;
+
+	transport->open(serialPort);
+	serialPort.setCallback(boost::bind(&BorisEmulator::receive, this, _1, _2));
+
+	/* A vlaszokat idztetten kikld szl indtsa. Ksleltets s darabols nlkl a vlaszok kzvetlenl a berkezett bjtokat
+	feldolgoz szlrl indulnak, de a szl ekkor is fut, hogy a belltsok egysgesen kezelhetk maradjanak. */
+	running = true;
+	replyThread = std::thread(&BorisEmulator::sendReplies, this);
+}
+
+/*
+ * Lelltja az utastsok fogadst s bontja a kapcsolatot.
+ */
+void BorisEmulator::stop() {
+	{
+		std::lock_guard<std::mutex> guard(replyMutex);
+		running = false;
+	}
+	replyCondition.notify_one();
+	if(replyThread.joinable())
+		replyThread.join();
+
+	/* A kapcsolat bontsa. Ha a msik fl mr bontotta a kapcsolatot, akkor a port hiballapotban van s a lezrs kivtelt dob, ami
+	itt nem hiba, a destruktorbl pedig nem is juthat ki. */
+	serialPort.clearCallback();
+	try {
+		if(serialPort.isOpen())
+			serialPort.close();
+	}
+	catch(boost::system::system_error&) {}
+}
+
+/*
+ * Visszaadja az tvitel rvid lerst.
+ */
+std::string BorisEmulator::describe() const {
+	return transport->describe();
+}
+
+/*
+ * Visszaadja a legutbb belltott 16-bites kimeneti llapotot.
+ */
+std::uint16_t BorisEmulator::getOutput() const {
+	return output.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a fogadott kimenetbellt utastsok szmt.
+ */
+unsigned long long int BorisEmulator::getWriteCount() const {
+	return writeCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a fogadott bemenet-lekrdezsek szmt.
+ */
+unsigned long long int BorisEmulator::getReadCount() const {
+	return readCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja az ismeretlen utastsknt eldobott bjtok szmt.
+ */
+unsigned long long int BorisEmulator::getUnknownCount() const {
+	return unknownCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Feldolgozza a berkezett bjtokat.
+ */
+void BorisEmulator::receive(const char* data, std::size_t size) {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	for(std::size_t i = 0; i < size; i++) {
+		unsigned char byte = static_cast<unsigned char>(data[i]);
+
+		/* Szimullt vonal esetn a bjt csak az elz bjt utn, a vonal sebessgnek megfelel id elteltvel rkezik meg. */
+		if(byteTime > std::chrono::nanoseconds::zero()) {
+			receiveClock = (std::max)(now, receiveClock) + byteTime;
+			now = receiveClock;
+		}
+
+		/* Egy j utasts els bjtja: a lekrdezs azonnal megvlaszolsra kerl, a kimenetbellt utasts a kt adatbjtra vr,
+		minden ms bjt ismeretlen utastsknt eldobsra kerl. */
+		if(commandLength == 0) {
+			if(byte == CMD_READ_INPUT) {
+				readCount.fetch_add(1, std::memory_order_relaxed);
+				reply(now);
+			}
+			else if(byte == CMD_WRITE_OUTPUT)
+				command[commandLength++] = byte;
+			else
+				unknownCount.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		/* A kimenetbellt utasts adatbjtjainak gyjtse, majd a teljes utasts vgrehajtsa. */
+		command[commandLength++] = byte;
+		if(commandLength == 3) {
+			commandLength = 0;
+			std::uint16_t value = static_cast<std::uint16_t>((command[1] << 8) | command[2]);
+			writeCount.fetch_add(1, std::memory_order_relaxed);
+			if(output.exchange(value, std::memory_order_relaxed) != value && outputHandler)
+				outputHandler(value);
+		}
+	}
+}
+
+/*
+ * sszelltja s temezi a bemenet-lekrdezsre adott vlaszt.
+ */
+void BorisEmulator::reply(std::chrono::steady_clock::time_point now) {
+	std::uint16_t value = inputAt(now);
+	PendingReply pending;
+	pending.data[0] = static_cast<char>(value >> 8);
+	pending.data[1] = static_cast<char>(value & 0xff);
+	pending.size = 2;
+
+	std::unique_lock<std::mutex> lock(replyMutex);
+
+	/* Ksleltets s darabols nlkl, res sor esetn a vlasz azonnal, a sorrend megsrtse nlkl kikldhet. */
+	bool fragmented = fragmentSize > 0 && fragmentSize < pending.size;
+	bool immediate = latency == std::chrono::nanoseconds::zero() && jitter == std::chrono::nanoseconds::zero();
+	if(immediate && byteTime == std::chrono::nanoseconds::zero() && !fragmented && replies.empty()) {
+		lock.unlock();
+		serialPort.write(pending.data, pending.size);
+		return;
+	}
+
+	/* A kiklds idpontjnak meghatrozsa. A vlasz nem elzheti meg a korbbi vlaszokat, ahogy a valdi eszkz is sorban vlaszol.
+	Szimullt vonal esetn a vlasz a bjtjai tvitele utn, a korbbi vlaszok tvitelnek vgt megvrva rkezik meg. */
+	std::chrono::nanoseconds delay = latency;
+	if(jitter > std::chrono::nanoseconds::zero())
+		delay += std::chrono::nanoseconds(std::uniform_int_distribution<long long int>(0, jitter.count())(random));
+	std::chrono::steady_clock::time_point deadline = (std::max)(now + delay, lastDeadline) + byteTime * pending.size;
+
+	/* A vlasz darabokra bontsa, a darabok kztt a belltott sznettel. */
+	if(fragmented) {
+		for(std::size_t offset = 0; offset < pending.size; offset += fragmentSize) {
+			PendingReply fragment;
+			fragment.deadline = deadline;
+			fragment.size = (std::min)(fragmentSize, pending.size - offset);
+			std::copy(pending.data + offset, pending.data + offset + fragment.size, fragment.data);
+			replies.push_back(fragment);
+			deadline += fragmentGap;
+		}
+		deadline -= fragmentGap;
+	}
+	else {
+		pending.deadline = deadline;
+		replies.push_back(pending);
+	}
+	lastDeadline = deadline;
+
+	lock.unlock();
+	replyCondition.notify_one();
+}
+
+/*
+ * A vlaszokat kikld szl trzse.
+ */
+void BorisEmulator::sendReplies() {
+	std::unique_lock<std::mutex> lock(replyMutex);
+	while(running) {
+		if(replies.empty()) {
+			replyCondition.wait(lock);
+			continue;
+		}
+
+		/* Vrakozs a legkorbbi vlasz kikldsi idpontjig. Az id eltti breds s az j vlasz rkezse is jraellenrzst okoz. */
+		PendingReply next = replies.front();
+		if(std::chrono::steady_clock::now() < next.deadline) {
+			replyCondition.wait_until(lock, next.deadline);
+			continue;
+		}
+
+		/* A vlasz kikldse a zrols feloldsa mellett, hogy a berkezett bjtok feldolgozsa kzben ne akadjon meg. */
+		replies.pop_front();
+		lock.unlock();
+		serialPort.write(next.data, next.size);
+		lock.lock();
+	}
+}
+
+/*
+ * Meghatrozza a bemenetek llapott a megadott idpontban.
+ */
+std::uint16_t BorisEmulator::inputAt(std::chrono::steady_clock::time_point now) const {
+	if(scriptLength <= std::chrono::nanoseconds::zero())
+		return constantInput;
+
+	/* A jelalak ismtldik, gy a keresett szakasz az indts ta eltelt id jelalakhosszal vett maradka alapjn tallhat meg. */
+	std::chrono::nanoseconds offset = (now - startTime) % scriptLength;
+	for(const InputStep& step : inputScript) {
+		if(offset < step.duration)
+			return step.value;
+		offset -= step.duration;
+	}
+	return inputScript.back().value;
+}
+
+/*
+ * Az I/O interfsz kimeneteit bellt utasts inicializlsa.
+ */
+const unsigned char BorisEmulator::CMD_WRITE_OUTPUT = 0xba;
+
+/*
+ * Az I/O interfsz bemeneteit beolvas utasts inicializlsa.
+ */
+const unsigned char BorisEmulator::CMD_READ_INPUT = 0xb9;
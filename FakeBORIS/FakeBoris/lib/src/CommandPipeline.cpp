@@ -0,0 +1,245 @@
+#include <inc\CommandPipeline.h>
+
+#include <algorithm>
+
+/*
+ * Az osztly konstruktora.
+ */
+CommandPipeline::CommandPipeline(CallbackAsyncSerial& port) :
+	serialPort(port),
+	decoder(std::chrono::milliseconds(125)),
+	head(0),
+	tail(0),
+	expiredPending(0),
+	lastLateReply(),
+	depth(1),
+	timeout(std::chrono::milliseconds(100)),
+	recorder(nullptr),
+	requestCount(0),
+	completedCount(0),
+	timeoutCount(0),
+	lateCount(0) {}
+
+/*
+ * Belltja az egyszerre vlaszra vr lekrdezsek legnagyobb szmt.
+ */
+void CommandPipeline::setDepth(unsigned int pipeline_depth) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	depth = (std::max)(1u, (std::min)(static_cast<unsigned int>(MAX_DEPTH), pipeline_depth));
+}
+
+/*
+ * Visszaadja az egyszerre vlaszra vr lekrdezsek legnagyobb szmt.
+ */
+unsigned int CommandPipeline::getDepth() const {
+	return depth;
+}
+
+/*
+ * Belltja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a rteg lejrtnak tekint.
+ */
+void CommandPipeline::setTimeout(std::chrono::nanoseconds request_timeout) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	timeout = request_timeout;
+}
+
+/*
+ * Visszaadja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a rteg lejrtnak tekint.
+ */
+std::chrono::nanoseconds CommandPipeline::getTimeout() {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	return timeout;
+}
+
+/*
+ * Belltja azt az idtartamot, amelynl rgebbi befejezetlen vlaszt a dekdol eldob.
+ */
+void CommandPipeline::setFrameGap(std::chrono::nanoseconds frame_gap) {
+	decoder.setFrameGap(frame_gap);
+}
+
+/*
+ * Belltja a dekdolt vlaszokat feldolgoz fggvnyt.
+ */
+void CommandPipeline::setReplyHandler(const ReplyHandler& handler) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	replyHandler = handler;
+}
+
+/*
+ * Belltja a kikldtt s a berkezett bjtokat rgzt objektumot.
+ */
+void CommandPipeline::setRecorder(TrafficRecorder* traffic_recorder) {
+	/* A kikldtt bjtok a soros port kimeneti sorbl kerlnek rgztsre, amikor a port tadja ket az eszkznek, gy a korltos
+	sor ltal eldobott s az llapotbellt utasts ltal fellrt bjtok nem kerlnek a rgztsbe. */
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	recorder = traffic_recorder;
+	if(traffic_recorder != nullptr) {
+		serialPort.setWriteCallback([traffic_recorder](const char* data, std::size_t size) {
+			traffic_recorder->record(TrafficRecorder::Direction::SENT, data, size);
+		});
+	}
+	else {
+		serialPort.setWriteCallback(boost::function<void (const char*, std::size_t)>());
+	}
+}
+
+/*
+ * Elkld egy utastssorozatot a soros porton.
+ */
+bool CommandPipeline::send(const char* data, std::size_t size, bool expects_reply) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+
+	/* A bemenet-lekrdezs visszatartsa, ha mr a belltott szm lekrdezs vr vlaszra. */
+	if(expects_reply && tail - head >= depth)
+		return false;
+
+	/* A lekrdezs elkldsi idpontjnak rgztse s az utastssorozat kikldse. A kiklds a zrols alatt trtnik, gy a
+	nyilvntarts sorrendje mindig megegyezik a vonalon lv sorrenddel. A lekrdezs csak akkor kerl a vlaszra vr lekrdezsek
+	kz, ha a korltos kimeneti sor nem dobta el, gy egy eldobott lekrdezs nem foglal helyet a lejratig. */
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if(!serialPort.write(data, size))
+		return false;
+	if(expects_reply) {
+		outstanding[tail++ % MAX_DEPTH] = now;
+		requestCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+/*
+ * Elkld egy llapotbellt utastst a soros porton, amelynek csak a legjabb rtke szmt.
+ */
+bool CommandPipeline::sendState(const char* data, std::size_t size) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	return serialPort.writeLatest(data, size);
+}
+
+/*
+ * Feldolgozza a soros porton berkezett bjtokat, a teljes vlaszokat prostja a vlaszra vr lekrdezsekhez s tadja ket a
+ * feldolgoz fggvnynek.
+ */
+void CommandPipeline::receive(const char* data, std::size_t size) {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::uint16_t replies[REPLY_BATCH_SIZE];
+	std::chrono::nanoseconds roundTrips[REPLY_BATCH_SIZE];
+	ReplyHandler handler;
+	if(recorder != nullptr)
+		recorder->record(TrafficRecorder::Direction::RECEIVED, data, size);
+
+	bool fed = false;
+	std::size_t count;
+	do {
+		/* A vlaszok dekdolsa s prostsa a legrgebbi vlaszra vr lekrdezsekhez a zrols alatt. A vonal megrzi a
+		sorrendet, ezrt a lejrt lekrdezsek ksett vlaszai rkeznek elszr, ezek nem prosthatk a ksbbi lekrdezsekhez. A
+		lekrdezshez nem prosthat vlasz is rvnyes bemeneti llapot, ezrt az is tovbbtsra kerl, de krlfordulsi id nlkl. */
+		count = 0;
+		{
+			std::lock_guard<std::mutex> guard(pipelineMutex);
+			if(!fed) {
+				decoder.feed(data, size, now);
+				fed = true;
+			}
+
+			while(count < REPLY_BATCH_SIZE && decoder.next(replies[count])) {
+				if(expiredPending > 0) {
+					expiredPending--;
+					lastLateReply = now;
+					roundTrips[count] = std::chrono::nanoseconds::zero();
+					lateCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				else if(head != tail) {
+					roundTrips[count] = now - outstanding[head++ % MAX_DEPTH];
+					completedCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				else {
+					roundTrips[count] = std::chrono::nanoseconds::zero();
+					lateCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				count++;
+			}
+			handler = replyHandler;
+		}
+
+		/* A vlaszok tadsa a feldolgoz fggvnynek a zrols feloldsa utn, hogy a feldolgozs ne tartsa fel a kldst. */
+		if(handler) {
+			for(std::size_t i = 0; i < count; i++)
+				handler(replies[i], now, roundTrips[i]);
+		}
+	} while(count == REPLY_BATCH_SIZE);
+}
+
+/*
+ * Lejrtnak tekinti s eltvoltja a nyilvntartsbl a tl rgta vlaszra vr lekrdezseket.
+ */
+void CommandPipeline::expire(std::chrono::steady_clock::time_point now) {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+
+	/* A lejrt lekrdezsek eltvoltsa. Egy lejrt lekrdezs vlasznak esetleges tredke a dekdolban maradhatott, ezrt az
+	eldobsra kerl. A lejrt lekrdezs ksett vlasza mg megrkezhet, ezrt az nyilvntartsba kerl. Ha azonban a lekrdezs
+	elkldse utn mr rkezett ksett vlasz, akkor az valsznleg ennek a lekrdezsnek a vlasza volt, s egy korbbi lekrdezs
+	vlasza elveszett. Ekkor erre a lekrdezsre nem vrhat jabb vlasz, gy egyetlen elveszett vlasz nem teszi lejrtt az sszes
+	tovbbi lekrdezst. */
+	bool expired = false;
+	while(head != tail && now - outstanding[head % MAX_DEPTH] > timeout) {
+		if(lastLateReply < outstanding[head % MAX_DEPTH])
+			expiredPending++;
+		head++;
+		expired = true;
+		timeoutCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	if(expired)
+		decoder.resync();
+}
+
+/*
+ * Trli a vlaszra vr lekrdezsek nyilvntartst.
+ */
+void CommandPipeline::reset() {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	head = tail;
+	expiredPending = 0;
+}
+
+/*
+ * Visszaadja a vlaszra vr lekrdezsek szmt.
+ */
+unsigned int CommandPipeline::getOutstanding() {
+	std::lock_guard<std::mutex> guard(pipelineMutex);
+	return static_cast<unsigned int>(tail - head);
+}
+
+/*
+ * Visszaadja az elkldtt lekrdezsek szmt.
+ */
+unsigned long long int CommandPipeline::getRequestCount() const {
+	return requestCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a megvlaszolt lekrdezsek szmt.
+ */
+unsigned long long int CommandPipeline::getCompletedCount() const {
+	return completedCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a lejrt lekrdezsek szmt.
+ */
+unsigned long long int CommandPipeline::getTimeoutCount() const {
+	return timeoutCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a lekrdezshez nem prosthat, ksve rkezett vlaszok szmt.
+ */
+unsigned long long int CommandPipeline::getLateCount() const {
+	return lateCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a vlaszok dekdoljt a dekdolsi statisztikk lekrdezshez.
+ */
+const ReplyDecoder& CommandPipeline::getDecoder() const {
+	return decoder;
+}
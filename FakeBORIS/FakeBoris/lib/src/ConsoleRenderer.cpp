@@ -0,0 +1,163 @@
+#include <inc\ConsoleRenderer.h>
+
+#include <algorithm>
+
+/*
+ * Kirajzolja a kpkockt, ha az rnykpuffer megvltozott.
+ */
+void ConsoleRenderer::performScheduledAction() {
+	render();
+}
+
+/*
+ * Az osztly konstruktora.
+ */
+ConsoleRenderer::ConsoleRenderer(std::unique_ptr<AbstractConsole> console_output, std::recursive_mutex& print_locker) :
+	AbstractScheduler(),
+	console(std::move(console_output)),
+	printLocker(print_locker),
+	originX(0),
+	originY(0),
+	width(0),
+	height(0),
+	dirty(false),
+	framePeriod(std::chrono::nanoseconds(std::chrono::seconds(1)) / DEFAULT_FRAME_RATE) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+ConsoleRenderer::~ConsoleRenderer() {
+	AbstractScheduler::stop();
+	join();
+}
+
+/*
+ * Belltja a frisstett terletet s trli az rnykpuffert.
+ */
+void ConsoleRenderer::setRegion(int x, int y, int region_width, int region_height) {
+	std::lock_guard<std::mutex> renderGuard(renderMutex);
+	std::lock_guard<std::mutex> frameGuard(frameMutex);
+	originX = x;
+	originY = y;
+	width = (std::max)(0, region_width);
+	height = (std::max)(0, region_height);
+	desired.assign(width * height, 0);
+	shown.assign(width * height, 0);
+	frame.assign(width * height, 0);
+	runs.clear();
+	runs.reserve(height);
+	dirty = false;
+}
+
+/*
+ * Belltja a kpkockasebessget.
+ */
+void ConsoleRenderer::setFrameRate(unsigned int frames_per_second) {
+	framePeriod = std::chrono::nanoseconds(std::chrono::seconds(1)) / (std::max)(1u, frames_per_second);
+}
+
+/*
+ * Rgzti, hogy a megadott szveg mr a kpernyn van.
+ */
+void ConsoleRenderer::assume(int x, int y, const std::string& text) {
+	std::lock_guard<std::mutex> renderGuard(renderMutex);
+	std::lock_guard<std::mutex> frameGuard(frameMutex);
+	for(std::size_t i = 0; i < text.size(); i++) {
+		int column = x + static_cast<int>(i) - originX, row = y - originY;
+		if(column < 0 || column >= width || row < 0 || row >= height)
+			continue;
+		desired[row * width + column] = shown[row * width + column] = text[i];
+	}
+}
+
+/*
+ * Belltja egy karakter megjelentend rtkt.
+ */
+void ConsoleRenderer::setCell(int x, int y, char character) {
+	int column = x - originX, row = y - originY;
+	std::lock_guard<std::mutex> frameGuard(frameMutex);
+	if(column < 0 || column >= width || row < 0 || row >= height)
+		return;
+	char& cell = desired[row * width + column];
+	if(cell != character) {
+		cell = character;
+		dirty = true;
+	}
+}
+
+/*
+ * Kirajzolja a kpkockt, ha az rnykpuffer megvltozott.
+ */
+void ConsoleRenderer::render() {
+	std::lock_guard<std::mutex> renderGuard(renderMutex);
+
+	/* Az rnykpuffer lemsolsa a zrols alatt, hogy az rk a konzolrs idejre se vrakozzanak. A msols nem foglal memrit,
+	mert a kpkocka mrete megegyezik az rnykpuffervel. */
+	{
+		std::lock_guard<std::mutex> frameGuard(frameMutex);
+		if(!dirty)
+			return;
+		dirty = false;
+		std::copy(desired.begin(), desired.end(), frame.begin());
+	}
+
+	/* A kpkocka sszevetse a kpernyn lv tartalommal soronknt. Egy karaktersorozat a megvltozott karakternl kezddik, s
+	addig tart, amg a kvetkez megvltozott karakterig legfeljebb MAX_RUN_GAP ismert, vltozatlan karakter ll. */
+	runs.clear();
+	for(int row = 0; row < height; row++) {
+		std::size_t base = static_cast<std::size_t>(row) * width;
+		int column = 0;
+		while(column < width) {
+			if(frame[base + column] == shown[base + column]) {
+				column++;
+				continue;
+			}
+
+			int first = column, end = column + 1;
+			for(int scan = end; scan < width; scan++) {
+				if(frame[base + scan] != shown[base + scan])
+					end = scan + 1;
+				else if(scan - end >= MAX_RUN_GAP || frame[base + scan] == 0)
+					break;
+			}
+
+			AbstractConsole::Run run = { originX + first, originY + row, &frame[base + first], static_cast<std::size_t>(end - first) };
+			runs.push_back(run);
+			std::copy(frame.begin() + base + first, frame.begin() + base + end, shown.begin() + base + first);
+			column = end;
+		}
+	}
+
+	/* A megvltozott karaktersorozatok kirsa egyetlen konzolrssal. */
+	if(!runs.empty()) {
+		std::lock_guard<std::recursive_mutex> printGuard(printLocker);
+		console->write(runs);
+	}
+}
+
+/*
+ * Elindtja a kpkockk kirajzolst a belltott kpkockasebessggel.
+ */
+void ConsoleRenderer::start() {
+	setPeriod(framePeriod);
+	AbstractScheduler::start();
+}
+
+/*
+ * Lelltja a kpkockk kirajzolst, majd kirajzolja az utols kpkockt.
+ */
+void ConsoleRenderer::stop() {
+	AbstractScheduler::stop();
+	join();
+	render();
+}
+
+/*
+ * A karaktersorozatokat elvlaszt vltozatlan karakterek legnagyobb szmnak inicializlsa.
+ */
+const int ConsoleRenderer::MAX_RUN_GAP = 4;
+
+/*
+ * Az alaprtelmezett kpkockasebessg inicializlsa.
+ */
+const unsigned int ConsoleRenderer::DEFAULT_FRAME_RATE = 30;
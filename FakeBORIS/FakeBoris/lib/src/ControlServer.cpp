@@ -0,0 +1,105 @@
+#include <inc\ControlServer.h>
+
+#include <istream>
+#include <boost\bind.hpp>
+#include <boost\make_shared.hpp>
+
+/*
+ * Egy vezrl kapcsolat llapota.
+ */
+struct ControlServer::Session {
+	/**
+	 * A kapcsolat.
+	 */
+	boost::asio::ip::tcp::socket socket;
+
+	/**
+	 * A berkezett, mg fel nem dolgozott bjtok.
+	 */
+	boost::asio::streambuf input;
+
+	/**
+	 * A kapcsolat llapotnak konstruktora.
+	 *
+	 * @param io Az aszinkron mveleteket futtat objektum.
+	 */
+	explicit Session(boost::asio::io_service& io) : socket(io) {}
+};
+
+/*
+ * Elindtja a kvetkez kapcsolat fogadst.
+ */
+void ControlServer::accept() {
+	boost::shared_ptr<Session> session = boost::make_shared<Session>(boost::ref(io));
+	acceptor.async_accept(session->socket, [this, session](const boost::system::error_code& error) {
+		if(error)
+			return;
+		read(session);
+		accept();
+	});
+}
+
+/*
+ * Elindtja a kvetkez parancssor olvasst a kapcsolatrl.
+ */
+void ControlServer::read(boost::shared_ptr<Session> session) {
+	boost::asio::async_read_until(session->socket, session->input, '\n',
+		[this, session](const boost::system::error_code& error, std::size_t) {
+		/* A kapcsolat bontsa vagy hibja esetn a kapcsolat llapota az utols r mutat hivatkozssal egytt megsznik. */
+		if(error)
+			return;
+
+		/* A parancs vgrehajtsa s a vlasz visszakldse. A vlasz szinkron rsa a rvid vlaszok miatt nem tartja fel a szlat, s
+		biztostja, hogy egy kapcsolat vlaszai a parancsok sorrendjben rkezzenek. */
+		std::istream stream(&session->input);
+		std::string line;
+		std::getline(stream, line);
+		std::string reply = handler(line);
+		boost::system::error_code writeError;
+		if(!reply.empty())
+			boost::asio::write(session->socket, boost::asio::buffer(reply), writeError);
+		if(!writeError)
+			read(session);
+	});
+}
+
+/*
+ * Az osztly konstruktora.
+ */
+ControlServer::ControlServer(unsigned short port_number, const CommandHandler& command_handler) :
+	acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port_number)),
+	handler(command_handler) {}
+
+/*
+ * Az osztly destruktora.
+ */
+ControlServer::~ControlServer() {
+	stop();
+}
+
+/*
+ * Visszaadja a figyelt TCP portot.
+ */
+unsigned short ControlServer::getPort() const {
+	return acceptor.local_endpoint().port();
+}
+
+/*
+ * Elindtja a kapcsolatok fogadst a kiszolgl sajt szln.
+ */
+void ControlServer::start() {
+	if(serviceThread.joinable())
+		return;
+	accept();
+	serviceThread = std::thread([this]() { io.run(); });
+}
+
+/*
+ * Lelltja a kiszolglt s bontja a kapcsolatokat.
+ */
+void ControlServer::stop() {
+	/* A szl lelltsa utn a mg fgg mveletek a kapcsolatokkal egytt az objektum megsznsekor szabadulnak fel. */
+	io.stop();
+	if(serviceThread.joinable())
+		serviceThread.join();
+}
@@ -0,0 +1,89 @@
+#include <inc\DaemonControl.h>
+#include <inc\OutputCommand.h>
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+/*
+ * Az osztly konstruktora.
+ */
+DaemonControl::DaemonControl(PollEngine& poll_engine) :
+	engine(poll_engine),
+	quitRequested(false) {}
+
+/*
+ * Vgrehajt egy vezrlparancsot.
+ */
+std::string DaemonControl::execute(const std::string& line) {
+	/* A parancs szavnak s paramternek sztvlasztsa. A sor vgi kocsivissza a Windows sorvgekbl maradhat ott. */
+	std::istringstream fields(line);
+	std::string verb, argument;
+	fields >> verb;
+	std::getline(fields >> std::ws, argument);
+	if(!argument.empty() && argument.back() == '\r')
+		argument.pop_back();
+	if(verb.empty())
+		return "";
+
+	std::ostringstream reply;
+	if(verb == "set") {
+		/* A kimenetek mdostsa. A parancs sszes bitje egyetlen atomi lpsben, vltozs esetn azonnal kerl kikldsre. */
+		try {
+			OutputCommand command = OutputCommand::parse(argument);
+			engine.setOutputBits(command.getMask(), command.getBits());
+			reply << "ok " << std::hex << std::setw(4) << std::setfill('0') << engine.getOutput() << std::endl;
+		}
+		catch(std::invalid_argument& e) {
+			reply << "error " << e.what() << std::endl;
+		}
+	}
+	else if(verb == "get") {
+		reply << "ok input " << std::hex << std::setw(4) << std::setfill('0') << engine.getInput() << " output " << std::setw(4);
+		reply << engine.getOutput() << std::endl;
+	}
+	else if(verb == "stats") {
+		/* A statisztika tbb sort egyetlen vlaszsorba vonja ssze, hogy a vlasz soronknt feldolgozhat maradjon. */
+		std::ostringstream statistics;
+		engine.printStatistics(statistics, false);
+		std::string text = statistics.str();
+		for(std::size_t pos = text.find('\n'); pos != std::string::npos && pos + 1 < text.size(); pos = text.find('\n', pos))
+			text.replace(pos, 1, "; ");
+		reply << "ok " << text;
+	}
+	else if(verb == "quit") {
+		requestQuit();
+		reply << "ok" << std::endl;
+	}
+	else
+		reply << "error ismeretlen parancs: " << verb << " (set, get, stats, quit)" << std::endl;
+	return reply.str();
+}
+
+/*
+ * Visszaadja, hogy valamelyik vezrl lelltst krt-e.
+ */
+bool DaemonControl::isQuitRequested() {
+	std::lock_guard<std::mutex> guard(quitMutex);
+	return quitRequested;
+}
+
+/*
+ * Megvrja, hogy valamelyik vezrl lelltst krjen.
+ */
+void DaemonControl::waitForQuit() {
+	std::unique_lock<std::mutex> lock(quitMutex);
+	while(!quitRequested)
+		quitCondition.wait(lock);
+}
+
+/*
+ * Lelltst kr.
+ */
+void DaemonControl::requestQuit() {
+	{
+		std::lock_guard<std::mutex> guard(quitMutex);
+		quitRequested = true;
+	}
+	quitCondition.notify_all();
+}
@@ -1,4 +1,5 @@
 #include <inc\FakeBoris.h>
+#include <inc\SerialTransport.h>
 
 /*
  * Kirajzolja a konzolkpernyre az I/O interfszt brzol karakterkpet.
@@ -29,107 +30,120 @@ inline void FakeBoris::drawIODisplay() {
 }
 
 /*
- * Beolvassa a kimenet sorszmt s a belltani kvnt rtket a felhasznltl.
+ * Beolvas egy, a kimenetek llapotait mdost parancsot a felhasznltl.
  */
 std::string FakeBoris::getNewSetting(char stop_char) {
 	std::string setting;
 
-	/* A lenyomott billentyk beolvassa, amg a feltteleknek megfelel rtkek bevitele meg nem trtnik. */
-	while(setting.size() < 3) {
+	/* A lenyomott billentyk beolvassa a sortrs vagy a szkz billenty lenyomsig. */
+	for(;;) {
 		int c = _getch();
 
-		/* A kimenet betjelnek s az egyenlsgjel automatikus kiratsa, amg a bevitt szmrtkek a kimenet sorszmt jelentik. */
-		if(std::isdigit(c) && setting.size() < 2) {
+		/* Az aktulis elem, vagyis a legutbbi vessz utni rsz s annak llapota: a kimenettartomny vagy mr az rtk bevitele
+		tart, s hny szmjegy ll a tartomny utols sorszmban. */
+		std::string item = setting.substr(setting.rfind(',') == std::string::npos ? 0 : setting.rfind(',') + 1);
+		bool inValue = item.find('=') != std::string::npos;
+		std::size_t fieldStart = item.find('-') != std::string::npos ? item.find('-') + 1 : 1;
+		std::size_t fieldDigits = item.size() > fieldStart ? item.size() - fieldStart : 0;
+		bool rangeComplete = !inValue && !item.empty() && (item.back() == '*' || fieldDigits == 2);
+
+		/* A bevitel megszaktsa s az alkalmazs lelltst jelz eredmny visszaadsa a megadott megszakt billenty lenyomsra.
+		A megszakt billenty csak res sorban szmt, a parancsban a kimenetek Q betjele is szerepelhet. */
+		if(setting.empty() && (c == std::tolower(stop_char) || c == std::toupper(stop_char))) {
+			return "exit";
+		}
+		/* A bevitt parancs visszaadsa a sortrs vagy a szkz billentyk lenyomsra. */
+		else if(std::isspace(c)) {
+			if(!setting.empty())
+				return setting;
+		}
+		/* A teljes bevitel trlse az Escape billenty lenyomsra. */
+		else if(c == 27) {
+			return "";
+		}
+		/* Az utols karakter trlse a trls billentyk lenyomsra, az automatikusan kirt Q betjellel egytt. */
+		else if(c == 127 || c == 8) {
+			std::size_t erased = 0;
+			do {
+				if(setting.empty())
+					break;
+				setting.pop_back();
+				erased++;
+			} while(!setting.empty() && setting.back() == 'Q');
+			std::cout << repeat("\b \b", static_cast<unsigned int>(erased));
+		}
+		/* Egy j elem kezdetn a kimenet betjelnek automatikus kiratsa, majd a kimenet sorszmnak vagy a teljes szt jell
+		csillagnak a bevitele. */
+		else if(item.empty() && (std::isdigit(c) || c == '*')) {
+			setting.push_back('Q');
 			setting.push_back(static_cast<char>(c));
-			std::cout << (setting.size() == 1 ? "Q" : "") << static_cast<char>(c) << (setting.size() == 2 ? " = " : "");
+			std::cout << 'Q' << static_cast<char>(c);
 		}
-		/* A kimenetre kerl j rtk kiratsa, ha a kimenet sorszma mr meg lett adva. */
-		else if(setting.size() == 2 && (c == '0' || c == '1')) {
+		else if(!inValue && !rangeComplete && item.size() > 1 && item.back() != '*' && std::isdigit(c)) {
 			setting.push_back(static_cast<char>(c));
 			std::cout << static_cast<char>(c);
 		}
-		/* A bevitel megszaktsa s az alkalmazs lelltst jelz eredmny visszaadsa a megadott megszakt billenyt lenyomsra. */
-		else if(c == std::tolower(stop_char) || c == std::toupper(stop_char)) {
-			return "exit";
+		/* A tartomny msodik sorszmnak kezdete egy teljes els sorszm utn. */
+		else if(!inValue && rangeComplete && c == '-' && item.find('-') == std::string::npos && item.back() != '*') {
+			setting.push_back('-');
+			std::cout << '-';
 		}
-		/* A bevitel megszaktsa s res eredmny visszaadsa a trls billentyk valamelyiknek lenyomsra. */
-		else if(c == 127 || c == 8) {
-			return "";
+		/* Az egyenlsgjel kiratsa a tartomny utn. Egyetlen kimenet esetn a korbbi beviteli mdnak megfelelen a 0 s az 1 is
+		azonnal rtkknt kerl bevitelre, az egyenlsgjel automatikusan jelenik meg. */
+		else if(rangeComplete && (c == '=' || c == '0' || c == '1')) {
+			setting.push_back('=');
+			std::cout << '=';
+			if(c != '=') {
+				setting.push_back(static_cast<char>(c));
+				std::cout << static_cast<char>(c);
+			}
+		}
+		/* Az rtk szmjegyeinek, a tizenhatos szmrendszer eltagjnak s a kvetkez elemet kezd vessznek a bevitele. */
+		else if(inValue && (std::isxdigit(c) || c == 'x' || c == 'X' || (c == ',' && item.back() != '='))) {
+			setting.push_back(static_cast<char>(c));
+			std::cout << static_cast<char>(c);
 		}
 	}
-
-	/* A bevitel felfggesztse a sortrs vagy a szkz billenyk lenyomsig, illetve a trls billentyk valamelyiknek lenyomsra
-	res eredmny visszaadsa. */
-	int key_code = _getch();
-	while(!std::isspace(key_code)) {
-		if(key_code == 127 || key_code == 8)
-			return "";
-		key_code = _getch();
-	} 
-	return setting;
 }
 
 /*
- * Kir egy karaktert a megadott pozcival a konzolkpernyre.
+ * Belltja a megjelentsben egy 16-bites llapot sszes bitjt.
  */
-void FakeBoris::printCharAt(SHORT x, SHORT y, wchar_t character) {
-	std::unique_lock<std::recursive_mutex> guard(printLocker);
-	COORD pos = { x, y };
-	DWORD dwBytesWritten = 0;
-	WriteConsoleOutputCharacter(GetStdHandle(STD_OUTPUT_HANDLE), &character, 1, pos, &dwBytesWritten);
+void FakeBoris::showBits(SHORT y, std::uint16_t value, std::uint16_t mask) {
+	for(int i = 0; i < 16; i++) {
+		if((mask >> i) & 1)
+			renderer.setCell((15 - i) * 4 + ((i < 8) ? 2 : 1), y, (value >> i) & 1 ? '1' : '0');
+	}
 }
 
 /*
- * Ismtld idkznknt elkldi az I/O interfsznek a belltott kimenetet s lekrdezi a bemenet llapott.
+ * Megjelenti a megvltozott bemeneti llapotot.
  */
-void FakeBoris::performScheduledAction() {
-	/* A kimenetet brzol 16-bites bitmez felbontsa kt 8-bites egszre. */
-	unsigned char outputHighByte, outputLowByte;
-	{
-		std::unique_lock<std::recursive_mutex> guard(rwLocker);
-
-		unsigned int outputValue = output.to_ulong();
-		outputHighByte = outputValue >> 8;
-		outputLowByte = outputValue;
-	}
-
-	/* Az I/O interfsz kimenett a 16-bites bitmez rtkre mdost s a bemenett lekrdez utastssorozat sszelltsa s kikldse
-	a soros kommunikcis porton. */
-	try {
-		unsigned char command[] = { CMD_WRITE_OUTPUT, outputHighByte, outputLowByte, CMD_READ_INPUT };
-		serialPort.write(reinterpret_cast<char*>(command), 4);
-	}
-	catch(boost::system::system_error& e) {
-		std::cout << "Az ismtld zenetklds kzben hiba lpett fel." << e.what() << std::endl;
-	}
+void FakeBoris::inputChanged(std::uint16_t value) {
+	showBits(inputLine, value, 0xffff);
 }
 
 /*
- * Fogadja a soros kommunikcis porton rkez zenetet az I/O interfsztl s a feldolgozst kveten mdostja a konzolkpernyn a
- * bemenetek llapotait.
+ * Megjelenti a reflexszablyok ltal megvltoztatott kimeneti llapotot.
  */
-void FakeBoris::readIODevice(const char* input, size_t data_size) {
-	const unsigned char* uchar_ptr = reinterpret_cast<const unsigned char*>(input);
-
-	/* A fogadott vlasz talaktsa bitmezv s konzolkpernyn szerepl rtkek mdostsa a fogadott vlasznak megfelelen, amennyiben
-	annak hossza pontosan kt bjt. */
-	if(data_size == 2) {
-		std::bitset<16> inputBits((uchar_ptr[0] << 8) + uchar_ptr[1]);
-
-		for(int i = 0; i < 16; i++)
-			printCharAt((15 - i) * 4 + ((i < 8) ? 2 : 1), inputLine, inputBits.test(i) ? '1' : '0');
-	}
+void FakeBoris::outputChanged(std::uint16_t value) {
+	showBits(outputLine, value, 0xffff);
 }
 
 /*
- * Az osztly konstruktora.
+ * Az osztly konstruktora, amelyik fizikai soros porton keresztl kommunikl az I/O interfsszel.
  */
 FakeBoris::FakeBoris(const std::string& device, unsigned int baud_rate) :
-	AbstractScheduler(),
+	FakeBoris(std::unique_ptr<AbstractTransport>(new SerialTransport(device, baud_rate)), baud_rate) {}
+
+/*
+ * Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+ */
+FakeBoris::FakeBoris(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate) :
+	PollEngine(std::move(transport_layer), baud_rate),
 	inputLine(0),
 	outputLine(0),
-	serialPortName(device),
-	serialPortBaudRate(baud_rate) {}
+	renderer(std::unique_ptr<AbstractConsole>(new Win32Console()), printLocker) {}
 
 /*
  * Az osztly virtulis destruktora.
@@ -144,11 +158,21 @@ FakeBoris::~FakeBoris() {
 	}
 }
 
+/*
+ * Belltja a bemenetek s a kimenetek megjelentsnek legnagyobb kpkockasebessgt.
+ */
+void FakeBoris::setFrameRate(unsigned int frames_per_second) {
+	renderer.setFrameRate(frames_per_second);
+}
+
 /*
  * Kirajzolja a konzolkpernyre az I/O interfszt brzol karakterkpet, inicializlja a soros kommunikcis portot s elindtja az I/O
  * interfsszel trtn ismtld adatcsert.
  */
-void FakeBoris::start() {
+bool FakeBoris::start() {
+	/* A vals idej temezsi profil folyamatszint belltsainak alkalmazsa, mg az I/O interfsz kirajzolsa eltt. */
+	applyProcessProfile();
+
 	/* A konzolkperny aktulis belltsainak eltrolsa a ksbbi visszalltshoz. */
 	CONSOLE_SCREEN_BUFFER_INFO csbi;
 	GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
@@ -162,29 +186,26 @@ void FakeBoris::start() {
 	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), csbi.wAttributes);
 	std::cout << std::endl;
 
-	/* A soros kommunikcis port megnyitsa, a fogadott vlaszokat feldolgoz visszahv fggvny belltsa s az ismtld adatcsere
-	elindtsa. */
-	try {
-		serialPort.open(serialPortName, serialPortBaudRate);
-		serialPort.setCallback(boost::bind(&FakeBoris::readIODevice, this, _1, _2));
-		
-		setPeriod(250);
-		AbstractScheduler::start();
-	}
-	catch(boost::system::system_error& e) {
-		std::cout << "A soros kommunikcis port inicializlsa kzben hiba lpett fel: " << e.what() << std::endl;
-	}
+	/* A bemenetek s a kimenetek sorai kztti terlet tadsa a megjelentsnek a mr kirajzolt llapotsorokkal egytt, hogy egy
+	llapotsor vltozsai egyetlen karaktersorozatba olvadhassanak, majd a kpkockk kirajzolsnak elindtsa. */
+	std::string signalRow;
+	for(int i = 0; i < 16; i++)
+		signalRow += std::string(i == 8 ? " " : "") + "(0)" + (i < 15 ? " " : "");
+	renderer.setRegion(0, inputLine, static_cast<int>(signalRow.size()), outputLine - inputLine + 1);
+	renderer.assume(0, inputLine, signalRow);
+	renderer.assume(0, outputLine, signalRow);
+	renderer.start();
+
+	/* A soros kommunikcis port megnyitsa s az ismtld adatcsere elindtsa. */
+	return connect();
 }
 
 /*
- * Lelltja a soros ponton keresztli ismtld adatcsert s lezrja a soros kommunikcis portot.
+ * Lelltja a soros ponton keresztli ismtld adatcsert, lezrja a soros kommunikcis portot s a megjelentst.
  */
 void FakeBoris::stop() {
-	AbstractScheduler::stop();
-
-	serialPort.clearCallback();
-	if(serialPort.isOpen())
-		serialPort.close();
+	PollEngine::stop();
+	renderer.stop();
 }
 
 /*
@@ -194,7 +215,7 @@ void FakeBoris::readUntil(char stop_char) {
 	std::string setting;
 	do {
 		/* A korbban bevitt adatok trlse a konzolkperny beviteli sorbl. */
-		std::cout << '\r' << std::string(10, ' ') << "\r> ";
+		std::cout << '\r' << std::string(79, ' ') << "\r> ";
 		
 		/* j paramterek bekrse s a mvelet megszaktsa, ha a felhasznl a megszakt billentyt ttte le. */
 		setting = getNewSetting(stop_char);
@@ -203,29 +224,26 @@ void FakeBoris::readUntil(char stop_char) {
 		else if(setting == "")
 			continue;
 
-		/* A bekrt paramterek megjelentse s eltrolsa a kimenet bitmezjben. */
-		SHORT x = boost::lexical_cast<SHORT>(setting.substr(0, 2));
-		if(x <= 15) {
-			printCharAt((15 - x) * 4 + ((x < 8) ? 2 : 1), outputLine, setting.at(2));
-			{
-				std::unique_lock<std::recursive_mutex> guard(rwLocker);
-				output.set(x, setting.at(2) == '1');
-			}
+		/* A parancs rtelmezse. Hibs parancs esetn a hiba megjelentse utn j parancs bekrse kvetkezik. */
+		std::uint16_t mask, bits;
+		try {
+			OutputCommand command = OutputCommand::parse(setting);
+			mask = command.getMask();
+			bits = command.getBits();
 		}
+		catch(std::invalid_argument& e) {
+			std::cout << "  # Hibs parancs, " << e.what() << std::endl;
+			continue;
+		}
+
+		/* A parancs sszes bitjnek eltrolsa egyetlen atomi lpsben, gy azok ugyanabban az utastsban, vltozs esetn azonnal
+		kerlnek kikldsre, majd a mdostott kimenetek megjelentse. */
+		setOutputBits(mask, bits);
+		showBits(outputLine, bits, mask);
 	} while(setting != "exit");
 	std::cout << std::endl;
 }
 
-/*
- * Az I/O interfsz kimeneteit bellt utasts inicializlsa.
- */
-const unsigned char FakeBoris::CMD_WRITE_OUTPUT = 0xba;
-
-/*
- * Az I/O interfsz bemeneteit beolvas utasts inicializlsa.
- */
-const unsigned char FakeBoris::CMD_READ_INPUT = 0xb9;
-
 /*
  * Az I/O interfsz testt brzol karakterkp sznnek inicializlsa.
  */
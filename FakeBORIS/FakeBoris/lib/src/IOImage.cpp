@@ -0,0 +1,97 @@
+#include <inc\IOImage.h>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+IOImage::IOImage() :
+	output(0),
+	outputVersion(0),
+	input(0),
+	inputVersion(0) {}
+
+/*
+ * Atomi mvelettel belltja vagy trli a kimenet egy bitjt.
+ */
+bool IOImage::setOutputBit(unsigned int index, bool value) {
+	std::uint16_t mask = static_cast<std::uint16_t>(1u << (index & 15));
+	return setOutputBits(mask, value ? mask : 0);
+}
+
+/*
+ * Egyetlen atomi lpsben mdostja a kimenet maszkkal kijellt bitjeit.
+ */
+bool IOImage::setOutputBits(std::uint16_t mask, std::uint16_t bits) {
+	bits &= mask;
+
+	/* A bitek belltsa, trlse vagy vegyes mdostsa. Vegyes esetben egy VAGY s egy S mvelet kztt az adatcsere szla egy
+	flksz llapotot kldhetne ki, ezrt ott az j llapot sszehasonlt cservel, egy lpsben kerl a helyre. */
+	std::uint16_t previous, next;
+	if(bits == mask) {
+		previous = output.fetch_or(mask, std::memory_order_acq_rel);
+		next = previous | mask;
+	}
+	else if(bits == 0) {
+		previous = output.fetch_and(static_cast<std::uint16_t>(~mask), std::memory_order_acq_rel);
+		next = previous & ~mask;
+	}
+	else {
+		previous = output.load(std::memory_order_relaxed);
+		do
+			next = static_cast<std::uint16_t>((previous & ~mask) | bits);
+		while(!output.compare_exchange_weak(previous, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+	}
+
+	/* A verziszm nvelse, ha az llapot tnylegesen megvltozott. */
+	if(previous == next)
+		return false;
+	outputVersion.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+/*
+ * Atomi mvelettel belltja a teljes kimeneti llapotot.
+ */
+bool IOImage::setOutput(std::uint16_t value) {
+	if(output.exchange(value, std::memory_order_acq_rel) == value)
+		return false;
+	outputVersion.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+/*
+ * Visszaadja a 16-bites kimeneti llapotot.
+ */
+std::uint16_t IOImage::getOutput() const {
+	return output.load(std::memory_order_acquire);
+}
+
+/*
+ * Visszaadja a kimeneti llapot verziszmt.
+ */
+std::uint32_t IOImage::getOutputVersion() const {
+	return outputVersion.load(std::memory_order_acquire);
+}
+
+/*
+ * Eltrolja a beolvasott bemeneti llapotot.
+ */
+bool IOImage::setInput(std::uint16_t value) {
+	if(input.exchange(value, std::memory_order_acq_rel) == value)
+		return false;
+	inputVersion.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+/*
+ * Visszaadja a legutbb beolvasott 16-bites bemeneti llapotot.
+ */
+std::uint16_t IOImage::getInput() const {
+	return input.load(std::memory_order_acquire);
+}
+
+/*
+ * Visszaadja a bemeneti llapot verziszmt.
+ */
+std::uint32_t IOImage::getInputVersion() const {
+	return inputVersion.load(std::memory_order_acquire);
+}
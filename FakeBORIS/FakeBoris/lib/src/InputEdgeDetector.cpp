@@ -0,0 +1,140 @@
+#include <inc\InputEdgeDetector.h>
+
+#include <algorithm>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+InputEdgeDetector::InputEdgeDetector() :
+	nextId(1),
+	risingInterest(0),
+	fallingInterest(0),
+	initialized(false),
+	raw(0),
+	pending(0),
+	state(0) {
+	std::fill(debounce, debounce + 16, std::chrono::nanoseconds::zero());
+}
+
+/*
+ * jraszmolja a feliratkozk ltal figyelt lek maszkjait.
+ */
+void InputEdgeDetector::updateInterest() {
+	risingInterest = fallingInterest = 0;
+	for(const Subscription& subscription : subscriptions) {
+		risingInterest |= subscription.risingMask;
+		fallingInterest |= subscription.fallingMask;
+	}
+}
+
+/*
+ * Feliratkozik a megadott bemenetek megadott fajtj leire.
+ */
+unsigned int InputEdgeDetector::subscribe(std::uint16_t pins, Edge edges, const EdgeHandler& handler) {
+	Subscription subscription;
+	subscription.risingMask = (static_cast<int>(edges) & static_cast<int>(Edge::RISING)) ? pins : 0;
+	subscription.fallingMask = (static_cast<int>(edges) & static_cast<int>(Edge::FALLING)) ? pins : 0;
+	subscription.handler = handler;
+
+	std::lock_guard<std::mutex> guard(configMutex);
+	subscription.id = nextId++;
+	subscriptions.push_back(subscription);
+	updateInterest();
+	return subscription.id;
+}
+
+/*
+ * Megsznteti a megadott feliratkozst.
+ */
+void InputEdgeDetector::unsubscribe(unsigned int id) {
+	std::lock_guard<std::mutex> guard(configMutex);
+	subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+		[id](const Subscription& subscription) { return subscription.id == id; }), subscriptions.end());
+	updateInterest();
+}
+
+/*
+ * Belltja a megadott bemenetek pergsmentestsi idejt.
+ */
+void InputEdgeDetector::setDebounce(std::uint16_t pins, std::chrono::nanoseconds window) {
+	std::lock_guard<std::mutex> guard(configMutex);
+	for(unsigned int i = 0; i < 16; i++) {
+		if(pins & (1 << i))
+			debounce[i] = (std::max)(std::chrono::nanoseconds::zero(), window);
+	}
+}
+
+/*
+ * Elfelejti a korbbi mintkat.
+ */
+void InputEdgeDetector::reset() {
+	initialized = false;
+	pending = 0;
+}
+
+/*
+ * Feldolgoz egy beolvasott bemeneti llapotot.
+ */
+void InputEdgeDetector::sample(std::uint16_t value, std::chrono::steady_clock::time_point receive_time) {
+	/* Az els minta a kiindul llapot, amelyhez nem tartozik l. */
+	if(!initialized) {
+		raw = value;
+		pending = 0;
+		state.store(value, std::memory_order_relaxed);
+		initialized = true;
+		return;
+	}
+
+	/* A megvltozott bitek meghatrozsa az elz mintval vett kizr VAGY kapcsolattal. Vltozs s pergsmentestsre vr bit
+	hinyban a minta feldolgozsa itt vget r. */
+	std::uint16_t changed = value ^ raw;
+	if(changed == 0 && pending == 0)
+		return;
+
+	/* A megvltozott bitek vltozsi idejnek rgztse. A pergsmentestett llapotba visszatrt bitek mr nem vrakoznak. */
+	raw = value;
+	for(unsigned int i = 0; changed != 0; i++, changed >>= 1) {
+		if(changed & 1)
+			changeTime[i] = receive_time;
+	}
+	std::uint16_t stable = state.load(std::memory_order_relaxed);
+	pending = raw ^ stable;
+	if(pending == 0)
+		return;
+
+	/* Azoknak a biteknek a kivlasztsa, amelyek a pergsmentestsi idejknl rgebb ta vltozatlanok. */
+	std::lock_guard<std::mutex> guard(configMutex);
+	std::uint16_t accepted = 0;
+	for(unsigned int i = 0; i < 16; i++) {
+		if((pending & (1 << i)) && receive_time - changeTime[i] >= debounce[i])
+			accepted |= static_cast<std::uint16_t>(1 << i);
+	}
+	if(accepted == 0)
+		return;
+
+	/* A pergsmentestett llapot frisstse, majd a feliratkozk rtestse azokrl az lekrl, amelyekre feliratkoztak. */
+	pending &= ~accepted;
+	state.store(stable ^ accepted, std::memory_order_relaxed);
+	std::uint16_t rising = accepted & raw & risingInterest;
+	std::uint16_t falling = accepted & ~raw & fallingInterest;
+	if((rising | falling) == 0)
+		return;
+	for(unsigned int i = 0; i < 16; i++) {
+		std::uint16_t bit = static_cast<std::uint16_t>(1 << i);
+		if(!((rising | falling) & bit))
+			continue;
+		Edge edge = (rising & bit) ? Edge::RISING : Edge::FALLING;
+		for(const Subscription& subscription : subscriptions) {
+			std::uint16_t mask = (edge == Edge::RISING) ? subscription.risingMask : subscription.fallingMask;
+			if(mask & bit)
+				subscription.handler(i, edge, changeTime[i]);
+		}
+	}
+}
+
+/*
+ * Visszaadja a pergsmentestett bemeneti llapotot.
+ */
+std::uint16_t InputEdgeDetector::getState() const {
+	return state.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,134 @@
+#include <inc\LoopBenchmark.h>
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/*
+ * Elkldi az I/O interfsznek a kimenet belltst s a bemenet lekrdezst a PollEngine ismtld adatcserjvel.
+ */
+void LoopBenchmark::performScheduledAction() {
+	/* Zrt hurk mrs esetn a tranzakcis rteg mlysgnek kitltse, gy a vonal folyamatosan foglalt. Ha egy lekrdezs nem
+	kerl a vlaszra vr lekrdezsek kz, pldul mert a kimeneti sor eldobta, a kitlts abbamarad. */
+	unsigned int outstanding;
+	do {
+		outstanding = getOutstanding();
+		PollEngine::performScheduledAction();
+	} while(closedLoop && getOutstanding() > outstanding && getOutstanding() < getPipelineDepth());
+}
+
+/*
+ * Rgzti egy, a lekrdezshez prostott vlasz krlfordulsi idejt.
+ */
+void LoopBenchmark::roundTripSampled(std::chrono::nanoseconds round_trip) {
+	if(!measuring.load(std::memory_order_relaxed))
+		return;
+	if(round_trip > std::chrono::nanoseconds::zero())
+		samples.push_back(round_trip);
+
+	/* Zrt hurk mrs esetn a kvetkez lekrdezs azonnal, a vlasz berkezsekor indul. */
+	if(closedLoop)
+		trigger();
+}
+
+/*
+ * Visszaadja a folyamat ltal eddig felhasznlt processzoridt.
+ */
+std::chrono::nanoseconds LoopBenchmark::processCpuTime() {
+#ifdef _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+	unsigned long long int ticks = ((static_cast<unsigned long long int>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) +
+		((static_cast<unsigned long long int>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime);
+	return std::chrono::nanoseconds(ticks * 100);
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+		std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+}
+
+/*
+ * Az osztly konstruktora.
+ */
+LoopBenchmark::LoopBenchmark(std::unique_ptr<AbstractTransport> transport_layer) :
+	PollEngine(std::move(transport_layer), 0),
+	closedLoop(false),
+	measuring(false) {
+	/* A mrs sajt tblzatot r ki, ezrt a kapcsolat lersa s a lelltskori statisztika nem jelenik meg. */
+	quiet = true;
+}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+LoopBenchmark::~LoopBenchmark() {
+	/* Az adatcsere lelltsa mg a krlfordulsi idk troljnak megsznse eltt, mert a vlaszok azt rjk. */
+	try {
+		stop();
+	}
+	catch(...) {}
+}
+
+/*
+ * Belltja, hogy a lekrdezsek a vlaszok berkezsekor azonnal kvessk-e egymst.
+ */
+void LoopBenchmark::setClosedLoop(bool closed_loop) {
+	closedLoop = closed_loop;
+}
+
+/*
+ * Ltrehozza a kapcsolatot az I/O interfsszel s elindtja az ismtld adatcsert.
+ */
+bool LoopBenchmark::open() {
+	return connect();
+}
+
+/*
+ * Elvgzi a mrst a megadott ideig.
+ */
+LoopBenchmark::Result LoopBenchmark::run(std::chrono::nanoseconds duration) {
+	samples.clear();
+	samples.reserve(SAMPLE_RESERVE);
+
+	/* A mrs indtsa. Zrt hurk mrs esetn az els lekrdezs azonnal indul, a tovbbiakat a vlaszok vltjk ki. */
+	unsigned long long int timeoutsBefore = getTimeoutCount();
+	std::chrono::nanoseconds cpuBefore = processCpuTime();
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	measuring = true;
+	trigger();
+	std::this_thread::sleep_for(duration);
+
+	/* A mrs lelltsa. A soros port lezrsa utn mr nem rkezik vlasz, gy a rgztett krlfordulsi idk biztonsgosan
+	feldolgozhatk. */
+	measuring = false;
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - startTime;
+	std::chrono::nanoseconds cpuUsed = processCpuTime() - cpuBefore;
+	stop();
+
+	/* Az eredmnyek kiszmtsa. A percentilisek a rendezett mintkbl a legkzelebbi rang mdszervel addnak. */
+	Result result;
+	result.completed = samples.size();
+	result.timeouts = getTimeoutCount() - timeoutsBefore;
+	result.throughput = elapsed.count() > 0 ? result.completed * 1e9 / elapsed.count() : 0.0;
+	result.p50 = result.p99 = result.p999 = result.cpuPerTransaction = std::chrono::nanoseconds::zero();
+	if(!samples.empty()) {
+		std::sort(samples.begin(), samples.end());
+		result.p50 = samples[(samples.size() - 1) * 500 / 1000];
+		result.p99 = samples[(samples.size() - 1) * 990 / 1000];
+		result.p999 = samples[(samples.size() - 1) * 999 / 1000];
+		result.cpuPerTransaction = cpuUsed / static_cast<long long int>(samples.size());
+	}
+	return result;
+}
+
+/*
+ * A krlfordulsi idk szmra a mrs eltt lefoglalt hely inicializlsa.
+ */
+const std::size_t LoopBenchmark::SAMPLE_RESERVE = 1 << 20;
@@ -0,0 +1,26 @@
+#include <inc\LoopbackPeerTransport.h>
+
+#ifndef _WIN32
+
+/*
+ * Az osztly konstruktora.
+ */
+LoopbackPeerTransport::LoopbackPeerTransport(LoopbackTransport& loopback_transport) :
+	AbstractTransport(),
+	loopback(loopback_transport) {}
+
+/*
+ * A hurok msik vgt a soros kommunikcit megvalst objektumhoz rendeli.
+ */
+void LoopbackPeerTransport::open(CallbackAsyncSerial& port) {
+	loopback.openPeer(port);
+}
+
+/*
+ * Visszaadja a hurok lerst.
+ */
+std::string LoopbackPeerTransport::describe() const {
+	return loopback.describe();
+}
+
+#endif
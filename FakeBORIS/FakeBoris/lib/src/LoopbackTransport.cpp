@@ -0,0 +1,56 @@
+#include <inc\LoopbackTransport.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+LoopbackTransport::LoopbackTransport() :
+	AbstractTransport(),
+	peerDescriptor(-1) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+LoopbackTransport::~LoopbackTransport() {
+	if(peerDescriptor >= 0)
+		::close(peerDescriptor);
+}
+
+/*
+ * Ltrehozza a hurkot s az egyik vgt a soros kommunikcit megvalst objektumhoz rendeli.
+ */
+void LoopbackTransport::open(CallbackAsyncSerial& port) {
+	int descriptors[2];
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, descriptors) < 0)
+		throw boost::system::system_error(errno, boost::system::system_category(), "A hurok nem hozhat ltre");
+
+	/* Az elz hurok t nem adott vgnek lezrsa, ha volt ilyen. */
+	if(peerDescriptor >= 0)
+		::close(peerDescriptor);
+	peerDescriptor = descriptors[1];
+	port.assign(descriptors[0]);
+}
+
+/*
+ * A hurok msik vgt a msik fl soros kommunikcit megvalst objektumhoz rendeli.
+ */
+void LoopbackTransport::openPeer(CallbackAsyncSerial& peer_port) {
+	if(peerDescriptor < 0)
+		throw boost::system::system_error(boost::asio::error::not_connected, "A hurok msik vge nem rhet el");
+	int descriptor = peerDescriptor;
+	peerDescriptor = -1;
+	peer_port.assign(descriptor);
+}
+
+/*
+ * Visszaadja a hurok lerst.
+ */
+std::string LoopbackTransport::describe() const {
+	return "folyamaton belli hurok";
+}
+
+#endif
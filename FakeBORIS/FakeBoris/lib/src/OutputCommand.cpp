@@ -0,0 +1,110 @@
+#include <inc\OutputCommand.h>
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+/*
+ * Az osztly konstruktora.
+ */
+OutputCommand::OutputCommand(std::uint16_t command_mask, std::uint16_t command_bits) :
+	mask(command_mask),
+	bits(command_bits) {}
+
+/*
+ * rtelmez egy kimenetsorszmot a megadott pozcitl.
+ */
+unsigned int OutputCommand::parseIndex(const std::string& text, std::size_t& position) {
+	std::size_t start = position;
+	unsigned int index = 0;
+	while(position < text.size() && std::isdigit(static_cast<unsigned char>(text[position])) && position - start < 2)
+		index = index * 10 + (text[position++] - '0');
+	if(position == start || index > 15)
+		throw std::invalid_argument("rvnytelen kimenetsorszm: " + text);
+	return index;
+}
+
+/*
+ * rtelmez egy tzes vagy 0x eltag tizenhatos szmrendszerbeli rtket.
+ */
+unsigned long int OutputCommand::parseValue(const std::string& text) {
+	bool hexadecimal = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+	std::string digits = hexadecimal ? text.substr(2) : text;
+	if(digits.empty() || digits.size() > 5)
+		throw std::invalid_argument("rvnytelen rtk: " + text);
+
+	unsigned long int value = 0;
+	for(char digit : digits) {
+		unsigned char c = static_cast<unsigned char>(digit);
+		if(hexadecimal && std::isxdigit(c))
+			value = value * 16 + (std::isdigit(c) ? c - '0' : std::tolower(c) - 'a' + 10);
+		else if(!hexadecimal && std::isdigit(c))
+			value = value * 10 + (c - '0');
+		else
+			throw std::invalid_argument("rvnytelen rtk: " + text);
+	}
+	return value;
+}
+
+/*
+ * rtelmezi a parancs szvegt.
+ */
+OutputCommand OutputCommand::parse(const std::string& text) {
+	std::uint16_t commandMask = 0, commandBits = 0;
+
+	/* Az elemek egyenknti rtelmezse a szkzk elhagysa utn. */
+	std::istringstream items(text);
+	std::string item;
+	while(std::getline(items, item, ',')) {
+		item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }),
+			item.end());
+		std::size_t position = (!item.empty() && (item[0] == 'Q' || item[0] == 'q')) ? 1 : 0;
+
+		/* A kimenettartomny rtelmezse: a teljes sz, egyetlen kimenet, vagy kt kimenet kztti tartomny brmelyik irnyban. */
+		unsigned int low = 0, high = 15;
+		if(position < item.size() && item[position] == '*') {
+			position++;
+		}
+		else {
+			low = high = parseIndex(item, position);
+			if(position < item.size() && item[position] == '-') {
+				position++;
+				high = parseIndex(item, position);
+				if(low > high)
+					std::swap(low, high);
+			}
+		}
+		if(position >= item.size() || item[position] != '=')
+			throw std::invalid_argument("hinyz egyenlsgjel: " + item);
+
+		/* Az rtk rtelmezse s ellenrzse, hogy elfr-e a tartomny szlessgben. */
+		unsigned int width = high - low + 1;
+		unsigned long int value = parseValue(item.substr(position + 1));
+		if(value >> width != 0)
+			throw std::invalid_argument("az rtk nem fr el " + std::to_string(width) + " biten: " + item);
+
+		/* Az elem beolvasztsa a parancsba, tfeds esetn a ksbbi elem fellrja a korbbit. */
+		std::uint16_t itemMask = static_cast<std::uint16_t>(((1ul << width) - 1) << low);
+		commandMask |= itemMask;
+		commandBits = static_cast<std::uint16_t>((commandBits & ~itemMask) | (value << low));
+	}
+
+	if(commandMask == 0)
+		throw std::invalid_argument("res parancs");
+	return OutputCommand(commandMask, commandBits);
+}
+
+/*
+ * Visszaadja a parancs ltal mdostott kimenetek maszkjt.
+ */
+std::uint16_t OutputCommand::getMask() const {
+	return mask;
+}
+
+/*
+ * Visszaadja a mdostott kimenetek j rtkeit.
+ */
+std::uint16_t OutputCommand::getBits() const {
+	return bits;
+}
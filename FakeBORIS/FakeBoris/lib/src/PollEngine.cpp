@@ -0,0 +1,532 @@
+#include <inc\PollEngine.h>
+#include <inc\SerialTransport.h>
+
+/*
+ * Ismtld idkznknt elkldi az I/O interfsznek a belltott kimenetet s lekrdezi a bemenet llapott.
+ */
+void PollEngine::performScheduledAction() {
+	/* Fogadsi gyr hasznlata esetn a legutbbi lekrdezs ta berkezett vlaszok feldolgozsa, mg a lekrdezsek lejrtnak
+	tekintse eltt. */
+	if(receiveRingSize > 0)
+		pullReceivedData();
+
+	/* A tl rgta vlaszra vr lekrdezsek lejrtnak tekintse, hogy egy elveszett vlasz ne foglalja tovbb a vonalat. */
+	pipeline.expire(std::chrono::steady_clock::now());
+
+	/* Automatikus peridus esetn a kvetkez vrakozsi id igaztsa a legutbb mrt krlfordulsi idkhz s a vlaszra vr
+	lekrdezsek megengedett szmhoz. */
+	if(pollPeriod == std::chrono::nanoseconds::zero())
+		setPeriod(adaptivePeriod.period(pipeline.getDepth()));
+
+	/* A befejezetlen vlaszok eldobsi kszbnek igaztsa a peridushoz: egy fl peridusnl rgebbi tredk mr biztosan nem
+	tartozik a kvetkez vlaszhoz. Fogadsi gyr hasznlata esetn a bjtok csak peridusonknt kerlnek feldolgozsra, ezrt ott
+	a kszb msfl peridus. */
+	pipeline.setFrameGap(receiveRingSize > 0 ? getPeriod() + getPeriod() / 2 : getPeriod() / 2);
+
+	/* A blokkdiagram lefuttatsa a legutbb beolvasott bemeneti llapottal, hogy az ltala meghajtott kimenetek mg ebben a
+	peridusban kikldsre kerljenek. */
+	if(blockDiagram.getInstructionCount() > 0) {
+		std::uint16_t diagramOutput = blockDiagram.run(ioImage.getInput(), std::chrono::steady_clock::now());
+		if(ioImage.setOutputBits(blockDiagram.getOutputMask(), diagramOutput))
+			outputChanged(ioImage.getOutput());
+	}
+
+	/* Az I/O interfsz kimenett a 16-bites bitmez rtkre mdost s a bemenett lekrdez utastsok kikldse a soros
+	kommunikcis porton. Vltozsvezrelt rs esetn a kimenet csak akkor kerl kikldsre, ha a legutbbi kiklds ta megvltozott,
+	egybknt csak a bemenet lekrdezse trtnik meg. Ha mr a megengedett szm lekrdezs vr vlaszra, a lekrdezs elmarad, de a
+	megvltozott kimenet ekkor is kikldsre kerl. */
+	try {
+		const char command = static_cast<char>(CMD_READ_INPUT);
+		sendOutput(writeMode == WriteMode::ON_CHANGE);
+		pipeline.send(&command, 1, true);
+	}
+	catch(boost::system::system_error& e) {
+		std::cout << "Az ismtld zenetklds kzben hiba lpett fel." << e.what() << std::endl;
+	}
+}
+
+/*
+ * Kikldi az I/O interfsznek a kimenetek llapott.
+ */
+void PollEngine::sendOutput(bool changed_only) {
+	/* A kimeneti llapot s verziszmnak kiolvassa s kikldse a zrols alatt, hogy az ismtld adatcsere s a reflexszablyok
+	szla egy rgebbi llapotot ne kldhessen ki egy jabb utn. Az llapot egyetlen atomi olvassbl szrmazik, gy egy tbbbites
+	mdosts minden bitje ugyanabba az utastsba kerl. A kimenet belltsa llapotbellt utastsknt kerl a kimeneti sorba,
+	gy egy mg el nem kldtt korbbi rtket fellr. Ha a korltos kimeneti sor eldobja, az llapot nem szmt kikldttnek, gy
+	vltozsvezrelt rsnl a kvetkez peridus jra megprblja. */
+	std::lock_guard<std::mutex> guard(outputMutex);
+	std::uint32_t outputVersion = ioImage.getOutputVersion();
+	if(changed_only && outputSent && outputVersion == lastSentVersion)
+		return;
+	std::uint16_t outputValue = ioImage.getOutput();
+	unsigned char command[] = { CMD_WRITE_OUTPUT, static_cast<unsigned char>(outputValue >> 8),
+		static_cast<unsigned char>(outputValue & 0xff) };
+	if(!pipeline.sendState(reinterpret_cast<char*>(command), 3))
+		return;
+	lastSentVersion = outputVersion;
+	outputSent = true;
+}
+
+/*
+ * Alkalmazza a vals idej temezsi profilt az ismtld adatcsere szlra.
+ */
+void PollEngine::prepareThread() {
+	applyRealTimeProfile("az ismtld adatcsere");
+}
+
+/*
+ * Alkalmazza a vals idej temezsi profilt a hv szlra s figyelmeztetst r ki, ha az nem sikerlt.
+ */
+void PollEngine::applyRealTimeProfile(const char* thread_name) {
+	if(!realTimeProfile.applyToCurrentThread()) {
+		std::unique_lock<std::recursive_mutex> guard(printLocker);
+		std::cout << "A vals idej temezs belltsa nem sikerlt " << thread_name << " szln." << std::endl;
+	}
+}
+
+/*
+ * Fogadja a soros kommunikcis porton rkez zenetet az I/O interfsztl s a feldolgozst kveten eltrolja a bemenetek llapott.
+ */
+void PollEngine::readIODevice(const char* input, size_t data_size) {
+	/* A berkezett bjtok tadsa a tranzakcis rtegnek, amelyik a teljes vlaszokat a lekrdezsekhez prostva tovbbtja. Az
+	llapot eltrolshoz elegend az olvassbl dekdolt legfrissebb vlasz. */
+	latestInput = -1;
+	reflexMask = reflexBits = 0;
+	pipeline.receive(input, data_size);
+
+	/* A reflexszablyok ltal az olvass vlaszaibl kiszmolt kimenetek belltsa, s vltozs esetn azonnali kikldse errl a
+	szlrl, az ismtld adatcsere megvrsa nlkl, gy a bemenet vltozsa egy krlfordulsi idn bell megjelenik a kimeneten. */
+	if(reflexMask != 0 && ioImage.setOutputBits(reflexMask, reflexBits)) {
+		try {
+			sendOutput(false);
+		}
+		catch(boost::system::system_error&) {
+			/* A kiklds hibjt az ismtld adatcsere a kvetkez peridusban jelzi. */
+		}
+		outputChanged(ioImage.getOutput());
+	}
+	if(latestInput < 0)
+		return;
+
+	/* A fogadott vlasz eltrolsa, s a leszrmazott osztly rtestse, ha a bemeneti llapot megvltozott. */
+	std::uint16_t inputValue = static_cast<std::uint16_t>(latestInput);
+	if(ioImage.setInput(inputValue))
+		inputChanged(inputValue);
+}
+
+/*
+ * Feldolgoz egy, a lekrdezshez prostott vlaszt.
+ */
+void PollEngine::processReply(std::uint16_t reply, std::chrono::steady_clock::time_point receive_time,
+	std::chrono::nanoseconds round_trip) {
+	/* A krlfordulsi id rgztse, kivve fogadsi gyr hasznlata esetn, amikor a mrt rtk a peridust is tartalmazza, s
+	az automatikus peridust a vgtelensgig nveln. */
+	if(receiveRingSize == 0 && round_trip > std::chrono::nanoseconds::zero())
+		adaptivePeriod.addRoundTrip(round_trip);
+
+	/* Az ldetektls minden vlaszra lefut, nem csak az olvass legfrissebb vlaszra, hogy egy olvasson bell visszafordul
+	vltozs se vesszen el. Vltozatlan llapot esetn egyetlen sszehasonlts. */
+	edgeDetector.sample(reply, receive_time);
+	if(!reflexRules.empty())
+		reflexRules.evaluate(reply, ioImage.getOutput(), receive_time, reflexMask, reflexBits);
+	latestInput = reply;
+	roundTripSampled(round_trip);
+}
+
+/*
+ * Kiolvassa a soros port fogadsi gyrjbl a berkezett bjtokat s feldolgozza ket.
+ */
+void PollEngine::pullReceivedData() {
+	char buffer[64];
+	std::size_t size;
+	while((size = serialPort.pull(buffer, sizeof(buffer))) > 0)
+		readIODevice(buffer, size);
+}
+
+/*
+ * Szinkron lekrdezsek sorozatval megmri az I/O interfsz krlfordulsi idejt s elkszti az automatikus peridus szmtst.
+ */
+void PollEngine::probeRoundTrip(unsigned int samples) {
+	const char command = static_cast<char>(CMD_READ_INPUT);
+	char reply[2];
+	boost::posix_time::microseconds timeout(std::chrono::duration_cast<std::chrono::microseconds>(pipeline.getTimeout()).count());
+
+	/* A bemenet egyenknti lekrdezse s a vlaszok megvrsa. A vlasz kzvetlenl a helyi pufferbe kerl, gy a mrs nem
+	tartalmazza a dekdols s a szlak kztti tads idejt. */
+	std::chrono::nanoseconds minimum = std::chrono::nanoseconds::zero(), maximum = std::chrono::nanoseconds::zero();
+	std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+	unsigned int answered = 0;
+	for(unsigned int i = 0; i < samples; i++) {
+		try {
+			std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+			serialPort.transact(&command, 1, reply, 2, timeout);
+			std::chrono::nanoseconds roundTrip = std::chrono::steady_clock::now() - sent;
+
+			adaptivePeriod.addRoundTrip(roundTrip);
+			if(answered == 0 || roundTrip < minimum)
+				minimum = roundTrip;
+			if(roundTrip > maximum)
+				maximum = roundTrip;
+			total += roundTrip;
+			answered++;
+		}
+		catch(boost::system::system_error&) {
+			/* A meg nem rkezett vlasz nem hiba, az I/O interfsz lehet, hogy mg nincs bekapcsolva. */
+		}
+	}
+
+	/* A mrs eredmnynek megjelentse. */
+	if(answered == 0) {
+		std::cout << "Az I/O interfsz nem vlaszolt a krlfordulsi id mrse kzben." << std::endl;
+		return;
+	}
+	std::chrono::duration<double, std::micro> minimumUs = minimum, averageUs = total / answered, maximumUs = maximum;
+	std::cout << "Krlfordulsi id (us): min. " << minimumUs.count() << ", tlag " << averageUs.count() << ", max. ";
+	std::cout << maximumUs.count() << " (" << answered << "/" << samples << " vlasz, alacsony ksleltets md ";
+	std::cout << (serialPort.lowLatencyActive() ? "bekapcsolva" : "nem elrhet") << ")" << std::endl;
+}
+
+/*
+ * A bemeneti llapot megvltozsakor hvdik meg.
+ */
+void PollEngine::inputChanged(std::uint16_t /*value*/) {}
+
+/*
+ * A kimeneti llapot reflexszablyok vagy a blokkdiagram ltali megvltozsakor hvdik meg.
+ */
+void PollEngine::outputChanged(std::uint16_t /*value*/) {}
+
+/*
+ * Minden feldolgozott vlasznl meghvdik a lekrdezs krlfordulsi idejvel.
+ */
+void PollEngine::roundTripSampled(std::chrono::nanoseconds /*round_trip*/) {}
+
+/*
+ * Alkalmazza a vals idej temezsi profil folyamatszint belltsait s megjelenti az bredsi ksleltetst.
+ */
+void PollEngine::applyProcessProfile() {
+	/* A vals idej temezsi profil folyamatszint belltsainak alkalmazsa s az bredsi ksleltets megmrse, amelybl
+	eldnthet, hogy a szmtgp alkalmas-e a szigor ciklusidk betartsra. */
+	if(realTimeProfile.isEnabled()) {
+		if(!realTimeProfile.applyToProcess())
+			std::cout << "A vals idej profil folyamatszint belltsai nem alkalmazhatk (jogosultsg hinyzik?)." << std::endl;
+
+		RealTimeProfile::WakeupLatency latency = realTimeProfile.measureWakeupLatency(1000, std::chrono::microseconds(1000));
+		std::cout << "bredsi ksleltets 1 ms-os peridussal (us): min. " << latency.minimum << ", tlag " << latency.average;
+		std::cout << ", 99% " << latency.percentile99 << ", max. " << latency.maximum << std::endl << std::endl;
+	}
+}
+
+/*
+ * Ltrehozza a kapcsolatot az I/O interfsszel s elindtja az ismtld adatcsert.
+ */
+bool PollEngine::connect() {
+	/* A soros kommunikcis port megnyitsa, a fogadott vlaszokat feldolgoz visszahv fggvny belltsa s az ismtld adatcsere
+	elindtsa. */
+	try {
+		if(realTimeProfile.isEnabled())
+			serialPort.setThreadInitializer(boost::bind(&PollEngine::applyRealTimeProfile, this, "a soros port olvassnak"));
+		serialPort.setReceiveRing(receiveRingSize);
+		transport->open(serialPort);
+		if(!quiet)
+			std::cout << "Kapcsolat: " << transport->describe() << std::endl;
+		/* Automatikus peridus esetn a krlfordulsi id elzetes mrse, hogy az els lekrdezsek se a legrosszabb esetre becslt
+		peridussal trtnjenek. Krsre a mrs rgztett peridus mellett is megtrtnik. */
+		if(pollPeriod == std::chrono::nanoseconds::zero() || probeSamples > 0)
+			probeRoundTrip(probeSamples > 0 ? probeSamples : ROUND_TRIP_PROBE_SAMPLES);
+
+		pipeline.reset();
+		edgeDetector.reset();
+		reflexRules.reset();
+		blockDiagram.reset();
+		pipeline.setReplyHandler(boost::bind(&PollEngine::processReply, this, _1, _2, _3));
+		serialPort.setCallback(boost::bind(&PollEngine::readIODevice, this, _1, _2));
+		
+		setPeriod(pollPeriod > std::chrono::nanoseconds::zero() ? pollPeriod : adaptivePeriod.period(pipeline.getDepth()));
+		AbstractScheduler::start();
+	}
+	catch(boost::system::system_error& e) {
+		std::cout << "A soros kommunikcis port inicializlsa kzben hiba lpett fel: " << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Az osztly konstruktora, amelyik fizikai soros porton keresztl kommunikl az I/O interfsszel.
+ */
+PollEngine::PollEngine(const std::string& device, unsigned int baud_rate) :
+	PollEngine(std::unique_ptr<AbstractTransport>(new SerialTransport(device, baud_rate)), baud_rate) {}
+
+/*
+ * Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+ */
+PollEngine::PollEngine(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate) :
+	AbstractScheduler(),
+	transport(std::move(transport_layer)),
+	pollPeriod(std::chrono::milliseconds(250)),
+	adaptivePeriod(baud_rate),
+	pipeline(serialPort),
+	latestInput(-1),
+	reflexMask(0),
+	reflexBits(0),
+	writeMode(WriteMode::PERIODIC),
+	lastSentVersion(0),
+	outputSent(false),
+	receiveRingSize(0),
+	probeSamples(0),
+	quiet(false) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+PollEngine::~PollEngine() {
+	/* A soros ponton keresztli ismtld adatcsere lelltsa s a soros kommunikcis port lezrsa.*/
+	try {
+		PollEngine::stop();
+	}
+	catch(...) {
+		std::cout << "A soros kommunikci lezrsa kzben hiba lpett fel." << std::endl;
+	}
+}
+
+/*
+ * Belltja az ismtld adatcsere s a soros port olvassnak szlaira alkalmazand vals idej temezsi profilt.
+ */
+void PollEngine::setRealTimeProfile(const RealTimeProfile& profile) {
+	realTimeProfile = profile;
+}
+
+/*
+ * Belltja az I/O interfsszel trtn ismtld adatcsere idztsnek mdjt.
+ */
+void PollEngine::setSchedulingMode(SchedulingMode scheduling_mode, std::chrono::nanoseconds spin_window, double cpu_budget) {
+	AbstractScheduler::setSchedulingMode(scheduling_mode, spin_window, cpu_budget);
+}
+
+/*
+ * Belltja az I/O interfsz lekrdezsnek peridust.
+ */
+void PollEngine::setPollPeriod(std::chrono::nanoseconds poll_period) {
+	pollPeriod = poll_period;
+}
+
+/*
+ * Belltja a kimenetek I/O interfszre rsnak mdjt.
+ */
+void PollEngine::setWriteMode(WriteMode write_mode) {
+	writeMode = write_mode;
+}
+
+/*
+ * Belltja az egyszerre vlaszra vr bemenet-lekrdezsek legnagyobb szmt.
+ */
+void PollEngine::setPipelineDepth(unsigned int pipeline_depth) {
+	pipeline.setDepth(pipeline_depth);
+}
+
+/*
+ * Visszaadja az egyszerre vlaszra vr bemenet-lekrdezsek legnagyobb szmt.
+ */
+unsigned int PollEngine::getPipelineDepth() const {
+	return pipeline.getDepth();
+}
+
+/*
+ * Visszaadja a vlaszra vr bemenet-lekrdezsek szmt.
+ */
+unsigned int PollEngine::getOutstanding() {
+	return pipeline.getOutstanding();
+}
+
+/*
+ * Visszaadja a lejrt bemenet-lekrdezsek szmt.
+ */
+unsigned long long int PollEngine::getTimeoutCount() const {
+	return pipeline.getTimeoutCount();
+}
+
+/*
+ * Belltja azt az idtartamot, amelynl rgebben vlaszra vr lekrdezst a program lejrtnak tekint.
+ */
+void PollEngine::setRequestTimeout(std::chrono::nanoseconds request_timeout) {
+	pipeline.setTimeout(request_timeout);
+}
+
+/*
+ * Belltja a soros port kimeneti sorban egyszerre vrakoz bjtok legnagyobb szmt.
+ */
+void PollEngine::setWriteQueueLimit(std::size_t bytes) {
+	serialPort.setWriteQueueLimit(bytes);
+}
+
+/*
+ * Belltja a soros port fogadsi gyrjnek mrett.
+ */
+void PollEngine::setReceiveRing(std::size_t bytes) {
+	receiveRingSize = bytes;
+}
+
+/*
+ * Belltja a soros port ksleltetst befolysol belltsait.
+ */
+void PollEngine::setLatencyOptions(const AsyncSerial::LatencyOptions& options) {
+	serialPort.setLatencyOptions(options);
+}
+
+/*
+ * Belltja, hogy indtskor hny szinkron lekrdezssel mrje meg a program az I/O interfsz krlfordulsi idejt.
+ */
+void PollEngine::setProbeSamples(unsigned int samples) {
+	probeSamples = samples;
+}
+
+/*
+ * Mdostja a kimenetek megadott bitjeit s vltozs esetn azonnal kikldi az j llapotot.
+ */
+bool PollEngine::setOutputBits(std::uint16_t mask, std::uint16_t bits) {
+	bool changed = ioImage.setOutputBits(mask, bits);
+	if(changed)
+		trigger();
+	return changed;
+}
+
+/*
+ * Feliratkozik a megadott bemenetek megadott fajtj leire.
+ */
+unsigned int PollEngine::subscribeEdges(std::uint16_t pins, InputEdgeDetector::Edge edges,
+	const InputEdgeDetector::EdgeHandler& handler) {
+	return edgeDetector.subscribe(pins, edges, handler);
+}
+
+/*
+ * Megsznteti a megadott lfeliratkozst.
+ */
+void PollEngine::unsubscribeEdges(unsigned int id) {
+	edgeDetector.unsubscribe(id);
+}
+
+/*
+ * Belltja a megadott bemenetek pergsmentestsi idejt.
+ */
+void PollEngine::setDebounce(std::uint16_t pins, std::chrono::nanoseconds window) {
+	edgeDetector.setDebounce(pins, window);
+}
+
+/*
+ * Lefordt s hozzad egy reflexszablyt.
+ */
+void PollEngine::addReflexRule(const std::string& rule) {
+	reflexRules.add(rule);
+}
+
+/*
+ * Betlti a blokkdiagramot.
+ */
+std::size_t PollEngine::loadBlockDiagram(std::istream& input) {
+	blockDiagram.load(input);
+	return blockDiagram.getInstructionCount();
+}
+
+/*
+ * Belltja a kikldtt s a berkezett bjtokat rgzt objektumot.
+ */
+void PollEngine::setTrafficRecorder(std::unique_ptr<TrafficRecorder> traffic_recorder) {
+	pipeline.setRecorder(traffic_recorder.get());
+	trafficRecorder = std::move(traffic_recorder);
+}
+
+/*
+ * Visszaadja a 16-bites kimeneti llapotot.
+ */
+std::uint16_t PollEngine::getOutput() const {
+	return ioImage.getOutput();
+}
+
+/*
+ * Visszaadja a legutbb beolvasott 16-bites bemeneti llapotot.
+ */
+std::uint16_t PollEngine::getInput() const {
+	return ioImage.getInput();
+}
+
+/*
+ * Visszaadja a pergsmentestett bemeneti llapotot.
+ */
+std::uint16_t PollEngine::getDebouncedInput() const {
+	return edgeDetector.getState();
+}
+
+/*
+ * Visszaadja az tvitel rvid lerst.
+ */
+std::string PollEngine::describe() const {
+	return transport->describe();
+}
+
+/*
+ * Kirja a lekrdezsek, a fogadsi gyr s a kimeneti sor statisztikjt.
+ */
+void PollEngine::printStatistics(std::ostream& out, bool problems_only) {
+	/* A lekrdezsek statisztikjnak megjelentse, amennyiben lejrt lekrdezs, ksve rkezett vlasz vagy eldobott bjt volt. */
+	const ReplyDecoder& decoder = pipeline.getDecoder();
+	if(!problems_only || pipeline.getTimeoutCount() > 0 || pipeline.getLateCount() > 0 || decoder.getDroppedBytes() > 0) {
+		out << "Lekrdezsek: " << pipeline.getRequestCount() << ", megvlaszolt: " << pipeline.getCompletedCount();
+		out << ", lejrt: " << pipeline.getTimeoutCount() << ", ksve rkezett vlasz: " << pipeline.getLateCount() << std::endl;
+		out << "Dekdolt vlaszok: " << decoder.getFrameCount() << ", eldobott bjtok: " << decoder.getDroppedBytes();
+		out << ", jraszinkronizlsok: " << decoder.getResyncCount() << std::endl;
+	}
+
+	/* A fogadsi gyr tlcsordulsainak megjelentse, amennyiben volt ilyen. */
+	if(!problems_only || serialPort.receiveOverflows() > 0) {
+		out << "Fogadsi gyr tlcsordulsai: " << serialPort.receiveOverflows() << " (" << serialPort.receiveOverflowBytes();
+		out << " elveszett bjt)" << std::endl;
+	}
+
+	/* A kimeneti sor statisztikjnak megjelentse, amennyiben a vonal nem gyzte a kldst. */
+	AsyncSerial::WriteQueueStats queueStats = serialPort.writeQueueStats();
+	if(!problems_only || queueStats.droppedWrites > 0 || queueStats.coalescedWrites > 0) {
+		out << "Kimeneti sor: legnagyobb teltettsg " << queueStats.highWatermark << " bjt, sszevont rsok: ";
+		out << queueStats.coalescedWrites << ", eldobott rsok: " << queueStats.droppedWrites << " (" << queueStats.droppedBytes;
+		out << " bjt)" << std::endl;
+	}
+}
+
+/*
+ * Ltrehozza a kapcsolatot az I/O interfsszel s elindtja az ismtld adatcsert.
+ */
+bool PollEngine::start() {
+	applyProcessProfile();
+	return connect();
+}
+
+/*
+ * Lelltja az ismtld adatcsert, lezrja a kapcsolatot s megjelenti a statisztikt.
+ */
+void PollEngine::stop() {
+	AbstractScheduler::stop();
+	join();
+
+	/* A statisztika csak az els lelltskor, a nyitott kapcsolat lezrsa utn jelenik meg. */
+	serialPort.clearCallback();
+	if(serialPort.isOpen()) {
+		serialPort.close();
+		if(!quiet)
+			printStatistics(std::cout, true);
+	}
+}
+
+/*
+ * Az I/O interfsz kimeneteit bellt utasts inicializlsa.
+ */
+const unsigned char PollEngine::CMD_WRITE_OUTPUT = 0xba;
+
+/*
+ * Az I/O interfsz bemeneteit beolvas utasts inicializlsa.
+ */
+const unsigned char PollEngine::CMD_READ_INPUT = 0xb9;
+
+/*
+ * Az automatikus peridus elksztshez indtskor vgzett szinkron lekrdezsek szmnak inicializlsa.
+ */
+const unsigned int PollEngine::ROUND_TRIP_PROBE_SAMPLES = 8;
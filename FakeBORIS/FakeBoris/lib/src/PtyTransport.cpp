@@ -0,0 +1,73 @@
+#include <inc\PtyTransport.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+PtyTransport::PtyTransport() :
+	AbstractTransport(),
+	slaveDescriptor(-1) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+PtyTransport::~PtyTransport() {
+	if(slaveDescriptor >= 0)
+		::close(slaveDescriptor);
+}
+
+/*
+ * Ltrehoz egy j pszeudoterminlt s a mester oldalt a soros kommunikcit megvalst objektumhoz rendeli.
+ */
+void PtyTransport::open(CallbackAsyncSerial& port) {
+	/* Az elz pszeudoterminl szolga oldalnak lezrsa, ha volt ilyen. */
+	if(slaveDescriptor >= 0) {
+		::close(slaveDescriptor);
+		slaveDescriptor = -1;
+		slaveName.clear();
+	}
+
+	/* A mester oldal ltrehozsa s a szolga oldal hozzfrhetv ttele. */
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master < 0)
+		throw boost::system::system_error(errno, boost::system::system_category(), "A pszeudoterminl nem hozhat ltre");
+	if(grantpt(master) < 0 || unlockpt(master) < 0 || ptsname(master) == nullptr) {
+		int error = errno;
+		::close(master);
+		throw boost::system::system_error(error, boost::system::system_category(), "A pszeudoterminl nem hozhat ltre");
+	}
+	std::string name = ptsname(master);
+
+	/* A szolga oldal megnyitsa s nyers mdba lltsa, hogy a vonali fegyelem ne alaktsa t s ne visszhangozza a binris
+	utastsokat. */
+	int slave = ::open(name.c_str(), O_RDWR | O_NOCTTY);
+	struct termios attributes;
+	if(slave < 0 || tcgetattr(slave, &attributes) < 0) {
+		int error = errno;
+		if(slave >= 0)
+			::close(slave);
+		::close(master);
+		throw boost::system::system_error(error, boost::system::system_category(), "A pszeudoterminl nem nyithat meg");
+	}
+	cfmakeraw(&attributes);
+	tcsetattr(slave, TCSANOW, &attributes);
+
+	port.assign(master);
+	slaveDescriptor = slave;
+	slaveName = name;
+}
+
+/*
+ * Visszaadja a pszeudoterminl szolga oldalnak elrsi tjt.
+ */
+std::string PtyTransport::describe() const {
+	return slaveName;
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include <inc\RealTimeProfile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#pragma comment(lib, "winmm.lib")
+#include <mmsystem.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+/*
+ * Elzetesen vgigrinti a hv szl vermnek a megadott mret rszt, hogy a ksbbi fggvnyhvsok ne okozzanak laphibt az
+ * idkritikus szakaszokban.
+ */
+void RealTimeProfile::prefaultStack() {
+	volatile unsigned char stack[STACK_PREFAULT_SIZE];
+	for(std::size_t i = 0; i < STACK_PREFAULT_SIZE; i += 256)
+		stack[i] = 0;
+
+	/* A tmb visszaolvassa, hogy a fordt az rsokat hasznlatnak tekintse. Az illkony olvass nem hagyhat el. */
+	static_cast<void>(stack[0]);
+}
+
+/*
+ * Az osztly alaprtelmezett konstruktora, amelyik kikapcsolt profilt hoz ltre.
+ */
+RealTimeProfile::RealTimeProfile() :
+	enabled(false),
+	priority(DEFAULT_PRIORITY),
+	cpu(-1) {}
+
+/*
+ * Az osztly konstruktora, amelyik bekapcsolt profilt hoz ltre.
+ */
+RealTimeProfile::RealTimeProfile(int rt_priority, int cpu_index) :
+	enabled(true),
+	priority(rt_priority),
+	cpu(cpu_index) {
+	if(rt_priority < MIN_PRIORITY || rt_priority > MAX_PRIORITY) {
+		throw std::invalid_argument("a prioritsnak " + std::to_string(MIN_PRIORITY) + " s " + std::to_string(MAX_PRIORITY) +
+			" kztt kell lennie");
+	}
+	if(cpu_index > MAX_CPU_INDEX)
+		throw std::invalid_argument("a processzormag sorszma legfeljebb " + std::to_string(MAX_CPU_INDEX) + " lehet");
+}
+
+/*
+ * Lekrdezi, hogy a profil be van-e kapcsolva.
+ */
+bool RealTimeProfile::isEnabled() const {
+	return enabled;
+}
+
+/*
+ * Alkalmazza a profil folyamatszint belltsait.
+ */
+bool RealTimeProfile::applyToProcess() const {
+	if(!enabled)
+		return true;
+
+#ifdef _WIN32
+	/* Windows rendszeren nincs mlockall megfelel, ezrt a munkakszlet minimlis mretnek megnvelsvel cskkenthet a lapok
+	kirsnak eslye, a rendszeridzt felbontsnak 1 ms-ra lltsa pedig az bredsek pontossgt javtja. A folyamat magas
+	prioritsi osztlyba kerl; a vals idej osztly a rendszer szlait is kiszorthatja, ezrt csak a legmagasabb priorits kri. */
+	bool success = SetProcessWorkingSetSize(GetCurrentProcess(), 16 * 1024 * 1024, 64 * 1024 * 1024) != 0;
+	DWORD priorityClass = priority == MAX_PRIORITY ? REALTIME_PRIORITY_CLASS : HIGH_PRIORITY_CLASS;
+	success = SetPriorityClass(GetCurrentProcess(), priorityClass) != 0 && success;
+	return timeBeginPeriod(1) == TIMERR_NOERROR && success;
+#else
+	/* A folyamat jelenlegi s jvbeli lapjainak rgztse a fizikai memriban. */
+	return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+}
+
+/*
+ * Alkalmazza a profil szlszint belltsait a hv szlra.
+ */
+bool RealTimeProfile::applyToCurrentThread() const {
+	if(!enabled)
+		return true;
+
+	bool success = true;
+#ifdef _WIN32
+	/* A priorits lekpezse a Windows szlprioritsi szintjeire, egyenl svokban, majd a szl hozzktse a megadott
+	processzormaghoz. */
+	int threadPriority = THREAD_PRIORITY_NORMAL;
+	if(priority >= 75)
+		threadPriority = THREAD_PRIORITY_TIME_CRITICAL;
+	else if(priority >= 50)
+		threadPriority = THREAD_PRIORITY_HIGHEST;
+	else if(priority >= 25)
+		threadPriority = THREAD_PRIORITY_ABOVE_NORMAL;
+	success = SetThreadPriority(GetCurrentThread(), threadPriority) != 0;
+	if(cpu >= 0)
+		success = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0 && success;
+#else
+	/* A SCHED_FIFO temezsi osztly s a priorits belltsa, majd a szl hozzktse a megadott processzormaghoz. */
+	sched_param param;
+	std::memset(&param, 0, sizeof(param));
+	param.sched_priority = priority;
+	success = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+
+	if(cpu >= 0) {
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+		success = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0 && success;
+	}
+#endif
+
+	/* A verem lapjainak elzetes betltse, hogy az idkritikus szakaszban mr ne legyen szksg laphiba kezelsre. */
+	prefaultStack();
+	return success;
+}
+
+/*
+ * Megmri egy, a profil belltsaival fut szl bredsi ksleltetst a megadott peridus vrakozsok sorozatval.
+ */
+RealTimeProfile::WakeupLatency RealTimeProfile::measureWakeupLatency(unsigned int samples, std::chrono::microseconds period) const {
+	std::vector<double> latencies;
+	latencies.reserve(samples);
+
+	/* A mrs kln szlon trtnik, hogy a hv szl belltsai ne vltozzanak meg. */
+	std::thread probe([&]() {
+		applyToCurrentThread();
+
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+		for(unsigned int i = 0; i < samples; i++) {
+			deadline += period;
+			std::this_thread::sleep_until(deadline);
+			std::chrono::duration<double, std::micro> late = std::chrono::steady_clock::now() - deadline;
+			latencies.push_back(late.count());
+		}
+	});
+	probe.join();
+
+	/* A mrt ksleltetsek statisztikjnak sszelltsa. */
+	WakeupLatency result = { 0.0, 0.0, 0.0, 0.0 };
+	if(!latencies.empty()) {
+		std::sort(latencies.begin(), latencies.end());
+		result.minimum = latencies.front();
+		result.average = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+		result.percentile99 = latencies[(latencies.size() - 1) * 99 / 100];
+		result.maximum = latencies.back();
+	}
+	return result;
+}
+
+/*
+ * A szlak alaprtelmezett vals idej temezsi prioritsnak inicializlsa.
+ */
+const int RealTimeProfile::DEFAULT_PRIORITY = 80;
+
+/*
+ * A szlak legkisebb vals idej temezsi prioritsnak inicializlsa.
+ */
+const int RealTimeProfile::MIN_PRIORITY = 1;
+
+/*
+ * A szlak legnagyobb vals idej temezsi prioritsnak inicializlsa.
+ */
+const int RealTimeProfile::MAX_PRIORITY = 99;
+
+/*
+ * A szlak hozzktshez megadhat legnagyobb processzormag-sorszm inicializlsa.
+ */
+#ifdef _WIN32
+const int RealTimeProfile::MAX_CPU_INDEX = static_cast<int>(sizeof(DWORD_PTR) * 8) - 1;
+#else
+const int RealTimeProfile::MAX_CPU_INDEX = CPU_SETSIZE - 1;
+#endif
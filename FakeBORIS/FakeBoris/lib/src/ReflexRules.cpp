@@ -0,0 +1,218 @@
+#include <inc\ReflexRules.h>
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+/*
+ * Beolvas egy Inn vagy Qnn alak ki- vagy bemenetnevet.
+ */
+std::uint16_t ReflexRules::parsePin(const std::string& token, char prefix) {
+	if(token.size() < 2 || token.size() > 3 || token[0] != prefix ||
+		!std::all_of(token.begin() + 1, token.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }))
+		throw std::invalid_argument(std::string("rvnytelen ") + (prefix == 'Q' ? "kimenet: " : "bemenet: ") + token);
+	unsigned int index = std::stoul(token.substr(1));
+	if(index > 15)
+		throw std::invalid_argument(std::string("rvnytelen ") + (prefix == 'Q' ? "kimenet: " : "bemenet: ") + token);
+	return static_cast<std::uint16_t>(1 << index);
+}
+
+/*
+ * Beolvas egy idtartamot.
+ */
+std::chrono::nanoseconds ReflexRules::parseDuration(const std::string& token) {
+	std::size_t digits = 0;
+	while(digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits])))
+		digits++;
+	std::string unit = token.substr(digits);
+	if(digits == 0 || digits > 9 || (unit != "" && unit != "MS" && unit != "US"))
+		throw std::invalid_argument("rvnytelen idtartam: " + token);
+	unsigned long int value = std::stoul(token.substr(0, digits));
+	if(unit == "US")
+		return std::chrono::microseconds(value);
+	return std::chrono::milliseconds(value);
+}
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+ReflexRules::ReflexRules() :
+	initialized(false),
+	previousInput(0) {}
+
+/*
+ * Lefordt s a tblzat vgre fz egy szablyt.
+ */
+void ReflexRules::add(const std::string& line) {
+	/* A szably szavakra bontsa. A kulcsszavak s a nevek nagybetsek lesznek, az egyenlsgjel szkzk nlkl is llhat. */
+	std::string text;
+	for(char c : line) {
+		if(c == '=')
+			text += " = ";
+		else
+			text += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	}
+	std::istringstream stream(text);
+	std::vector<std::string> tokens;
+	std::string token;
+	while(stream >> token)
+		tokens.push_back(token);
+	if(tokens.size() < 3)
+		throw std::invalid_argument("hinyos szably: " + line);
+
+	/* A kimenet s a mvelet. */
+	Rule rule;
+	rule.output = parsePin(tokens[0], 'Q');
+	if(tokens[1] == "=")
+		rule.action = Action::ASSIGN;
+	else if(tokens[1] == "SET")
+		rule.action = Action::SET;
+	else if(tokens[1] == "RESET")
+		rule.action = Action::RESET;
+	else if(tokens[1] == "TOGGLE")
+		rule.action = Action::TOGGLE;
+	else
+		throw std::invalid_argument("ismeretlen mvelet: " + tokens[1] + " (=, SET, RESET, TOGGLE)");
+
+	/* A kifejezs fordtsa S-tagokra. Minden tnyez egy bitet llt be a tag valamelyik maszkjban, az OR j tagot kezd. */
+	std::vector<Term> compiled(1, Term { 0, 0, 0, 0 });
+	std::size_t i = 2;
+	bool expectFactor = true;
+	for(; i < tokens.size() && tokens[i] != "AFTER" && tokens[i] != "FOR"; i++) {
+		if(!expectFactor) {
+			if(tokens[i] == "OR")
+				compiled.push_back(Term { 0, 0, 0, 0 });
+			else if(tokens[i] != "AND")
+				throw std::invalid_argument("AND vagy OR hinyzik ez eltt: " + tokens[i]);
+			expectFactor = true;
+			continue;
+		}
+
+		Term& term = compiled.back();
+		std::string keyword = tokens[i];
+		if((keyword == "NOT" || keyword == "RISE" || keyword == "FALL") && ++i == tokens.size())
+			throw std::invalid_argument("hinyz bemenet ez utn: " + keyword);
+		std::uint16_t pin = parsePin(tokens[i], 'I');
+		if(keyword == "NOT")
+			term.zeros |= pin;
+		else if(keyword == "RISE")
+			term.rising |= pin;
+		else if(keyword == "FALL")
+			term.falling |= pin;
+		else
+			term.ones |= pin;
+		expectFactor = false;
+	}
+	if(expectFactor)
+		throw std::invalid_argument("hinyos kifejezs: " + line);
+
+	/* Az idztsek. */
+	rule.after = rule.hold = std::chrono::nanoseconds::zero();
+	while(i < tokens.size()) {
+		if(i + 1 == tokens.size())
+			throw std::invalid_argument("hinyz idtartam ez utn: " + tokens[i]);
+		if(rule.action != Action::ASSIGN)
+			throw std::invalid_argument("idzts csak = mvelettel hasznlhat: " + line);
+		if(tokens[i] == "AFTER")
+			rule.after = parseDuration(tokens[i + 1]);
+		else if(tokens[i] == "FOR")
+			rule.hold = parseDuration(tokens[i + 1]);
+		else
+			throw std::invalid_argument("ismeretlen idzts: " + tokens[i] + " (AFTER, FOR)");
+		i += 2;
+	}
+
+	/* A lefordtott szably hozzfzse a tblzatokhoz. */
+	rule.firstTerm = terms.size();
+	rule.termCount = compiled.size();
+	rule.active = false;
+	terms.insert(terms.end(), compiled.begin(), compiled.end());
+	rules.push_back(rule);
+}
+
+/*
+ * Visszaadja, hogy nincs-e egyetlen szably sem.
+ */
+bool ReflexRules::empty() const {
+	return rules.empty();
+}
+
+/*
+ * Visszaadja a szablyok szmt.
+ */
+std::size_t ReflexRules::size() const {
+	return rules.size();
+}
+
+/*
+ * Elfelejti az elz bemeneti llapotot s az idztsek llapott.
+ */
+void ReflexRules::reset() {
+	initialized = false;
+	for(Rule& rule : rules) {
+		rule.active = false;
+		rule.until = std::chrono::steady_clock::time_point();
+	}
+}
+
+/*
+ * Kirtkeli a szablyokat egy beolvasott bemeneti llapotra.
+ */
+void ReflexRules::evaluate(std::uint16_t input, std::uint16_t output, std::chrono::steady_clock::time_point receive_time,
+	std::uint16_t& mask, std::uint16_t& bits) {
+	/* Az lek meghatrozsa az elz llapottal. Az els llapotnl nincs l. */
+	std::uint16_t changed = initialized ? static_cast<std::uint16_t>(input ^ previousInput) : 0;
+	std::uint16_t rising = changed & input, falling = changed & ~input;
+	std::uint16_t notInput = static_cast<std::uint16_t>(~input);
+	previousInput = input;
+	initialized = true;
+
+	for(Rule& rule : rules) {
+		/* A kifejezs rtke: igaz, ha brmelyik S-tagjnak minden maszkja teljesl. */
+		bool value = false;
+		for(const Term* term = &terms[rule.firstTerm]; !value && term != &terms[rule.firstTerm] + rule.termCount; term++) {
+			value = (input & term->ones) == term->ones && (notInput & term->zeros) == term->zeros &&
+				(rising & term->rising) == term->rising && (falling & term->falling) == term->falling;
+		}
+
+		/* Az idztsek: bekapcsolsi ksleltetsnl a kifejezsnek a megadott ideje folyamatosan igaznak kell lennie, impulzusnl a
+		kimenet a kifejezs utols teljeslse utn mg a megadott ideig bekapcsolva marad. */
+		if(value && !rule.active)
+			rule.since = receive_time;
+		rule.active = value;
+		if(rule.after > std::chrono::nanoseconds::zero())
+			value = value && receive_time - rule.since >= rule.after;
+		if(rule.hold > std::chrono::nanoseconds::zero()) {
+			if(value)
+				rule.until = receive_time + rule.hold;
+			value = value || receive_time < rule.until;
+		}
+
+		/* A mvelet elvgzse. A kimenet jelenlegi rtke a korbbi szablyok eredmnyvel egytt szmt az tvltshoz. */
+		std::uint16_t current = static_cast<std::uint16_t>((output & ~mask) | (bits & mask));
+		bool result;
+		switch(rule.action) {
+		case Action::ASSIGN:
+			result = value;
+			break;
+		case Action::SET:
+			if(!value)
+				continue;
+			result = true;
+			break;
+		case Action::RESET:
+			if(!value)
+				continue;
+			result = false;
+			break;
+		default:
+			if(!value)
+				continue;
+			result = (current & rule.output) == 0;
+			break;
+		}
+		mask |= rule.output;
+		bits = static_cast<std::uint16_t>(result ? bits | rule.output : bits & ~rule.output);
+	}
+}
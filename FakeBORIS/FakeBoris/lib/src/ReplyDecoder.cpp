@@ -0,0 +1,92 @@
+#include <inc\ReplyDecoder.h>
+
+/*
+ * Az osztly konstruktora.
+ */
+ReplyDecoder::ReplyDecoder(std::chrono::nanoseconds frame_gap) :
+	head(0),
+	tail(0),
+	lastByteTime(),
+	frameGap(frame_gap.count()),
+	droppedBytes(0),
+	resyncCount(0),
+	frameCount(0) {}
+
+/*
+ * Belltja azt az idtartamot, amelynl rgebbi befejezetlen vlaszt a dekdol eldob.
+ */
+void ReplyDecoder::setFrameGap(std::chrono::nanoseconds frame_gap) {
+	frameGap.store(frame_gap.count(), std::memory_order_relaxed);
+}
+
+/*
+ * Hozzadja a soros porton berkezett bjtokat a dekdoland adatfolyamhoz.
+ */
+void ReplyDecoder::feed(const char* data, std::size_t size, std::chrono::steady_clock::time_point timestamp) {
+	if(size == 0)
+		return;
+
+	/* Ha a pufferben egy befejezetlen vlasz tl rgta vrakozik, akkor annak a folytatsa mr nem fog megrkezni, ezrt az eldobsra
+	kerl, s az j bjtok egy j vlasz elejt jelentik. */
+	std::chrono::nanoseconds gap(frameGap.load(std::memory_order_relaxed));
+	if((tail - head) % FRAME_SIZE != 0 && timestamp - lastByteTime > gap)
+		resync();
+	lastByteTime = timestamp;
+
+	/* A bjtok elhelyezse a gyrpufferben. Betelt puffer esetn a legrgebbi teljes vlasz eldobsra kerl, gy a keretezs nem
+	srl. */
+	for(std::size_t i = 0; i < size; i++) {
+		if(tail - head == RING_SIZE) {
+			head += FRAME_SIZE;
+			droppedBytes.fetch_add(FRAME_SIZE, std::memory_order_relaxed);
+		}
+		ring[tail++ & (RING_SIZE - 1)] = static_cast<unsigned char>(data[i]);
+	}
+}
+
+/*
+ * Kiveszi az adatfolyambl a kvetkez teljes vlaszt, amennyiben van ilyen.
+ */
+bool ReplyDecoder::next(std::uint16_t& reply) {
+	if(tail - head < FRAME_SIZE)
+		return false;
+
+	reply = static_cast<std::uint16_t>((ring[head & (RING_SIZE - 1)] << 8) | ring[(head + 1) & (RING_SIZE - 1)]);
+	head += FRAME_SIZE;
+	frameCount.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+/*
+ * Eldobja a befejezetlen vlaszt, s az jraszinkronizlsok kz szmtja.
+ */
+void ReplyDecoder::resync() {
+	std::size_t partial = (tail - head) % FRAME_SIZE;
+	if(partial == 0)
+		return;
+
+	tail -= partial;
+	droppedBytes.fetch_add(partial, std::memory_order_relaxed);
+	resyncCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja az sszes eldobott bjt szmt.
+ */
+unsigned long long int ReplyDecoder::getDroppedBytes() const {
+	return droppedBytes.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja az jraszinkronizlsok szmt.
+ */
+unsigned long long int ReplyDecoder::getResyncCount() const {
+	return resyncCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja az sszes sikeresen dekdolt vlasz szmt.
+ */
+unsigned long long int ReplyDecoder::getFrameCount() const {
+	return frameCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,23 @@
+#include <inc\SerialTransport.h>
+
+/*
+ * Az osztly konstruktora.
+ */
+SerialTransport::SerialTransport(const std::string& port_name, unsigned int baud_rate) :
+	AbstractTransport(),
+	portName(port_name),
+	baudRate(baud_rate) {}
+
+/*
+ * Megnyitja a soros portot a belltott adattviteli sebessggel.
+ */
+void SerialTransport::open(CallbackAsyncSerial& port) {
+	port.open(portName, baudRate);
+}
+
+/*
+ * Visszaadja a soros port nevt.
+ */
+std::string SerialTransport::describe() const {
+	return portName;
+}
@@ -0,0 +1,40 @@
+#include <inc\TcpTransport.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <unistd.h>
+
+/*
+ * Az osztly konstruktora.
+ */
+TcpTransport::TcpTransport(const std::string& host_name, const std::string& port_number) :
+	AbstractTransport(),
+	host(host_name),
+	service(port_number) {}
+
+/*
+ * Kapcsoldik a msik flhez s a kapcsolatot a soros kommunikcit megvalst objektumhoz rendeli.
+ */
+void TcpTransport::open(CallbackAsyncSerial& port) {
+	/* Kapcsolds a cm els elrhet vltozathoz. */
+	boost::asio::io_service io;
+	boost::asio::ip::tcp::resolver resolver(io);
+	boost::asio::ip::tcp::socket socket(io);
+	boost::asio::connect(socket, resolver.resolve(boost::asio::ip::tcp::resolver::query(host, service)));
+	socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+	/* A kapcsolat lerjnak tadsa a soros kommunikcit megvalst objektumnak. A helyi socket objektum a sajt lerjt zrja le. */
+	int descriptor = ::dup(socket.native_handle());
+	if(descriptor < 0)
+		throw boost::system::system_error(errno, boost::system::system_category(), "A kapcsolat nem adhat t");
+	port.assign(descriptor);
+}
+
+/*
+ * Visszaadja a msik fl cmt s portjt.
+ */
+std::string TcpTransport::describe() const {
+	return host + ":" + service;
+}
+
+#endif
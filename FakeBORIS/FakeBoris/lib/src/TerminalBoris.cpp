@@ -0,0 +1,193 @@
+#include <inc\TerminalBoris.h>
+
+#include <cctype>
+
+/*
+ * Kirajzolja a terminl kpernyjre az I/O interfszt brzol karakterkpet.
+ */
+void TerminalBoris::drawIODisplay() {
+	/* Az llapotokat jelz karaktersor. A jeleket a megjelents szn nlkl rja fell, ezrt azok az alaprtelmezett sznnel
+	jelennek meg. */
+	std::string signalRow;
+	for(int i = 0; i < 16; i++)
+		signalRow += std::string(i == 8 ? " " : "") + "(" + DEFAULT_COLOR + "0" + PIN_COLOR + ")" + (i < 15 ? " " : "");
+
+	/* A csatlakozkat a nevekkel sszekt karaktersor. */
+	std::string pinRow;
+	for(int i = 0; i < 16; i++)
+		pinRow += std::string(i == 8 ? " " : "") + " |  ";
+
+	/* A bemenetek, az I/O interfsz teste s a kimenetek kiratsa, a FakeBoris osztly karakterkpvel egyez elrendezsben. */
+	std::cout << PIN_COLOR << signalRow << "\n" << pinRow << "\n";
+	std::cout << IO_NAMES_COLOR << "I15 I14 I13 I12 I11 I10 I09 I08  I07 I06 I05 I04 I03 I02 I01 I00" << "\n";
+	std::cout << BODY_COLOR << std::string(64, '-') << "\n" << "|" << std::string(24, ' ');
+	std::cout << "Fake BORIS 1.0" << std::string(24, ' ') << "|" << "\n" << std::string(64, '-') << "\n";
+	std::cout << IO_NAMES_COLOR << "Q15 Q14 Q13 Q12 Q11 Q10 Q09 Q08  Q07 Q06 Q05 Q04 Q03 Q02 Q01 Q00" << "\n";
+	std::cout << PIN_COLOR << pinRow << "\n" << signalRow << DEFAULT_COLOR << std::endl;
+}
+
+/*
+ * Kirja a beviteli sor alatti sorba a megadott zenetet, majd a kurzort a trlt beviteli sor elejre mozgatja.
+ */
+void TerminalBoris::showPrompt(const std::string& message) {
+	std::lock_guard<std::recursive_mutex> guard(printLocker);
+	std::cout << "\r\x1b[K" << message << "\x1b[1A\r\x1b[K> " << std::flush;
+}
+
+/*
+ * Belltja a megjelentsben egy 16-bites llapot sszes bitjt.
+ */
+void TerminalBoris::showBits(int y, std::uint16_t value, std::uint16_t mask) {
+	for(int i = 0; i < 16; i++) {
+		if((mask >> i) & 1)
+			renderer.setCell((15 - i) * 4 + ((i < 8) ? 2 : 1), y, (value >> i) & 1 ? '1' : '0');
+	}
+}
+
+/*
+ * Megjelenti a megvltozott bemeneti llapotot.
+ */
+void TerminalBoris::inputChanged(std::uint16_t value) {
+	showBits(inputLine, value, 0xffff);
+}
+
+/*
+ * Megjelenti a reflexszablyok ltal megvltoztatott kimeneti llapotot.
+ */
+void TerminalBoris::outputChanged(std::uint16_t value) {
+	showBits(outputLine, value, 0xffff);
+}
+
+/*
+ * Az osztly konstruktora, amelyik a megadott tvitelen keresztl kommunikl az I/O interfsszel.
+ */
+TerminalBoris::TerminalBoris(std::unique_ptr<AbstractTransport> transport_layer, unsigned int baud_rate) :
+	PollEngine(std::move(transport_layer), baud_rate),
+	inputLine(0),
+	outputLine(8),
+	console(new AnsiConsole()),
+	renderer(std::unique_ptr<AbstractConsole>(console), printLocker) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+TerminalBoris::~TerminalBoris() {
+	/* Az ismtld adatcsere lelltsa s a kapcsolat lezrsa.*/
+	try {
+		stop();
+	}
+	catch(...) {
+		std::cout << "A soros kommunikci lezrsa kzben hiba lpett fel." << std::endl;
+	}
+}
+
+/*
+ * Belltja a bemenetek s a kimenetek megjelentsnek legnagyobb kpkockasebessgt.
+ */
+void TerminalBoris::setFrameRate(unsigned int frames_per_second) {
+	renderer.setFrameRate(frames_per_second);
+}
+
+/*
+ * Trli a terminl kpernyjt, kirajzolja az I/O interfszt brzol karakterkpet s a sgt, majd elindtja az I/O interfsszel
+ * trtn ismtld adatcsert.
+ */
+bool TerminalBoris::start() {
+	/* A vals idej temezsi profil folyamatszint belltsainak alkalmazsa, mg az I/O interfsz kirajzolsa eltt. */
+	applyProcessProfile();
+
+	/* A kperny trlse, mert a terminl koordinti a lthat terlet bal fels sarkhoz viszonytottak, majd a karakterkp s a
+	sg kirajzolsa. A sg utni res sor a beviteli sor, amely alatt a hibazenetek jelennek meg. */
+	console->clear();
+	drawIODisplay();
+	std::cout << std::endl;
+	std::cout << "j llapot belltsa: Q[00-15]=[0|1] # A \"Q\" elhagyhat." << std::endl;
+	std::cout << "Tbb kimenet egyszerre: Q00-07=0xA5, Q*=0xBEEF, Q03=1,Q05=0 # Egy lpsben kerlnek kikldsre." << std::endl;
+	std::cout << "Bevitel: [Enter]" << std::endl;
+	std::cout << "Kilps: [q|Q] # Egyedl a sorban." << std::endl << std::endl;
+
+	/* A bemenetek s a kimenetek sorai kztti terlet tadsa a megjelentsnek a mr kirajzolt llapotsorokkal egytt, majd a
+	kpkockk kirajzolsnak elindtsa. */
+	std::string signalRow;
+	for(int i = 0; i < 16; i++)
+		signalRow += std::string(i == 8 ? " " : "") + "(0)" + (i < 15 ? " " : "");
+	renderer.setRegion(0, inputLine, static_cast<int>(signalRow.size()), outputLine - inputLine + 1);
+	renderer.assume(0, inputLine, signalRow);
+	renderer.assume(0, outputLine, signalRow);
+	renderer.start();
+
+	/* A kapcsolat ltrehozsa s az ismtld adatcsere elindtsa. */
+	return connect();
+}
+
+/*
+ * Lelltja az ismtld adatcsert, lezrja a kapcsolatot s a megjelentst.
+ */
+void TerminalBoris::stop() {
+	PollEngine::stop();
+	renderer.stop();
+}
+
+/*
+ * Soronknt bekri a felhasznltl a kimenetek llapotainak megvltoztatst elidz parancsokat a megllt karakterig.
+ */
+void TerminalBoris::readUntil(char stop_char) {
+	{
+		std::lock_guard<std::recursive_mutex> guard(printLocker);
+		std::cout << "> " << std::flush;
+	}
+	std::string line;
+	while(std::getline(std::cin, line)) {
+		/* A sor elejn s vgn ll szkzk levgsa. res sor esetn j parancs bekrse kvetkezik. */
+		std::size_t first = line.find_first_not_of(" \t\r");
+		if(first == std::string::npos) {
+			showPrompt("");
+			continue;
+		}
+		std::string setting = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+		if(setting.size() == 1 && std::tolower(setting[0]) == std::tolower(stop_char))
+			break;
+
+		/* A kimenetek Q betjele a FakeBoris bevitelhez hasonlan elhagyhat. */
+		if(std::isdigit(static_cast<unsigned char>(setting[0])) || setting[0] == '*')
+			setting.insert(0, "Q");
+
+		/* A parancs rtelmezse. Hibs parancs esetn a hiba megjelentse utn j parancs bekrse kvetkezik. */
+		std::uint16_t mask, bits;
+		try {
+			OutputCommand command = OutputCommand::parse(setting);
+			mask = command.getMask();
+			bits = command.getBits();
+		}
+		catch(std::invalid_argument& e) {
+			showPrompt(std::string("  # Hibs parancs, ") + e.what());
+			continue;
+		}
+
+		/* A parancs sszes bitjnek eltrolsa egyetlen atomi lpsben, majd a mdostott kimenetek megjelentse. */
+		setOutputBits(mask, bits);
+		showBits(outputLine, bits, mask);
+		showPrompt("");
+	}
+	std::cout << std::endl;
+}
+
+/*
+ * Az I/O interfsz testt brzol karakterkp sznt bellt vezrlszekvencia inicializlsa.
+ */
+const char* const TerminalBoris::BODY_COLOR = "\x1b[37m";
+
+/*
+ * Az I/O interfsz csatlakozit brzol karakterkp sznt bellt vezrlszekvencia inicializlsa.
+ */
+const char* const TerminalBoris::PIN_COLOR = "\x1b[36m";
+
+/*
+ * Az I/O interfsz csatlakozinak a neveit brzol karakterkp sznt bellt vezrlszekvencia inicializlsa.
+ */
+const char* const TerminalBoris::IO_NAMES_COLOR = "\x1b[33m";
+
+/*
+ * A terminl alaprtelmezett szneit visszallt vezrlszekvencia inicializlsa.
+ */
+const char* const TerminalBoris::DEFAULT_COLOR = "\x1b[0m";
@@ -0,0 +1,114 @@
+#include <inc\TrafficRecorder.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+/*
+ * Az osztly konstruktora, amelyik ltrehozza vagy fellrja a fjlt s a memriba kpezi.
+ */
+TrafficRecorder::TrafficRecorder(const std::string& file_name, std::size_t record_count) :
+	header(nullptr),
+	records(nullptr),
+	capacity((std::max)(record_count, static_cast<std::size_t>(1))),
+	nextRecord(0),
+	startTime(std::chrono::steady_clock::now()),
+	fileName(file_name) {
+	/* A fjl ltrehozsa a teljes mretvel, mivel csak ltez tartomny kpezhet a memriba. */
+	std::uint64_t fileSize = sizeof(Header) + capacity * sizeof(Record);
+	{
+		std::filebuf file;
+		if(!file.open(file_name, std::ios_base::in | std::ios_base::out | std::ios_base::trunc | std::ios_base::binary))
+			throw std::runtime_error("a rgzts fjlja nem hozhat ltre: " + file_name);
+		file.pubseekoff(static_cast<std::streamoff>(fileSize - 1), std::ios_base::beg);
+		file.sputc(0);
+	}
+	mapping = boost::interprocess::file_mapping(file_name.c_str(), boost::interprocess::read_write);
+	region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_write, 0, static_cast<std::size_t>(fileSize));
+
+	/* A fejlc kitltse. A rekordok a ltrehozott fjlban nullk, gy mind resek. */
+	header = static_cast<Header*>(region.get_address());
+	records = reinterpret_cast<Record*>(header + 1);
+	std::memset(header, 0, sizeof(Header));
+	std::memcpy(header->magic, MAGIC, sizeof(header->magic));
+	header->version = VERSION;
+	header->recordSize = sizeof(Record);
+	header->capacity = capacity;
+	header->startTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Az osztly destruktora.
+ */
+TrafficRecorder::~TrafficRecorder() {
+	header->written = nextRecord.load(std::memory_order_relaxed);
+	region.flush();
+}
+
+/*
+ * Rgzt egy kikldtt vagy fogadott bjtsorozatot.
+ */
+void TrafficRecorder::record(Direction direction, const char* data, std::size_t size) {
+	if(size == 0)
+		return;
+
+	/* A sorozat sszes rekordjnak lefoglalsa egyetlen atomi mvelettel, gy a sorozat rekordjai akkor is egymst kvetik, ha
+	kzben egy msik szl is rgzt. */
+	std::uint64_t count = (size + RECORD_DATA_SIZE - 1) / RECORD_DATA_SIZE;
+	std::uint64_t first = nextRecord.fetch_add(count, std::memory_order_relaxed);
+	std::uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - startTime).count();
+
+	/* A rekordok kitltse. Egy rekord elbb ress vlik, s a sorszma csak a tartalma utn rdik be, gy egy flbemaradt rekord
+	olvasskor resnek vagy rginek ltszik, de sosem keveredik ssze egy jabbal. */
+	for(std::uint64_t i = 0; i < count; i++) {
+		Record& record = records[(first + i) % capacity];
+		record.sequence = 0;
+		std::atomic_thread_fence(std::memory_order_release);
+		std::size_t offset = static_cast<std::size_t>(i) * RECORD_DATA_SIZE;
+		std::size_t chunk = (std::min)(size - offset, RECORD_DATA_SIZE);
+		record.timestamp = timestamp;
+		record.flags = static_cast<std::uint8_t>(static_cast<std::uint8_t>(direction) | (i > 0 ? CONTINUATION : 0));
+		record.size = static_cast<std::uint8_t>(chunk);
+		std::memcpy(record.data, data + offset, chunk);
+		std::atomic_thread_fence(std::memory_order_release);
+		record.sequence = first + i + 1;
+	}
+}
+
+/*
+ * Visszaadja a kirt rekordok szmt.
+ */
+std::uint64_t TrafficRecorder::getRecordCount() const {
+	return nextRecord.load(std::memory_order_relaxed);
+}
+
+/*
+ * Visszaadja a rgzts rvid lerst.
+ */
+std::string TrafficRecorder::describe() const {
+	return fileName + " (" + std::to_string(capacity) + " rekord, " + std::to_string(sizeof(Header) + capacity * sizeof(Record)) +
+		" bjt)";
+}
+
+/*
+ * A rekordba fr bjtok legnagyobb szmnak inicializlsa.
+ */
+const std::size_t TrafficRecorder::RECORD_DATA_SIZE = sizeof(TrafficRecorder::Record::data);
+
+/*
+ * A folytatst jelz bit inicializlsa.
+ */
+const std::uint8_t TrafficRecorder::CONTINUATION = 0x80;
+
+/*
+ * A fjl azonostjnak inicializlsa.
+ */
+const char TrafficRecorder::MAGIC[8] = { 'B', 'O', 'R', 'I', 'S', 'R', 'E', 'C' };
+
+/*
+ * A fjlformtum verziszmnak inicializlsa.
+ */
+const std::uint32_t TrafficRecorder::VERSION = 1;
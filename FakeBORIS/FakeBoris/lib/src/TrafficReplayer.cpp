@@ -0,0 +1,93 @@
+#include <inc\TrafficReplayer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+/*
+ * Az osztly konstruktora, amelyik beolvassa a rgzts fjljt.
+ */
+TrafficReplayer::TrafficReplayer(const std::string& file_name) {
+	/* A fejlc beolvassa s ellenrzse. */
+	std::ifstream file(file_name, std::ios_base::binary);
+	if(!file)
+		throw std::runtime_error("a rgzts fjlja nem nyithat meg: " + file_name);
+	TrafficRecorder::Header header;
+	if(!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, TrafficRecorder::MAGIC, sizeof(header.magic)) != 0)
+		throw std::runtime_error("nem rgzts fjl: " + file_name);
+	if(header.version != TrafficRecorder::VERSION || header.recordSize != sizeof(TrafficRecorder::Record))
+		throw std::runtime_error("nem tmogatott rgztsformtum: " + file_name);
+	startTime = std::chrono::system_clock::time_point(
+		std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(header.startTime)));
+
+	/* Az rvnyes rekordok beolvassa s sorszm szerinti rendezse. A gyr krberse utn a legrgebbi rekord a fjl kzepn ll. */
+	std::vector<TrafficRecorder::Record> records;
+	TrafficRecorder::Record record;
+	for(std::uint64_t i = 0; i < header.capacity && file.read(reinterpret_cast<char*>(&record), sizeof(record)); i++) {
+		if(record.sequence != 0 && record.size <= TrafficRecorder::RECORD_DATA_SIZE)
+			records.push_back(record);
+	}
+	std::sort(records.begin(), records.end(),
+		[](const TrafficRecorder::Record& a, const TrafficRecorder::Record& b) { return a.sequence < b.sequence; });
+
+	/* A bjtsorozatok sszelltsa. A folytatsknt megjellt rekord az elz sorszm rekord sorozathoz fzdik; ha az nincs meg,
+	mert a gyrben mr fellrdott, a folytats kimarad. */
+	bool joinable = false;
+	std::uint64_t previous = 0;
+	for(const TrafficRecorder::Record& current : records) {
+		if(current.flags & TrafficRecorder::CONTINUATION) {
+			joinable = joinable && current.sequence == previous + 1;
+			if(joinable)
+				entries.back().data.append(reinterpret_cast<const char*>(current.data), current.size);
+		}
+		else {
+			Entry entry;
+			entry.time = std::chrono::nanoseconds(current.timestamp);
+			entry.direction = static_cast<TrafficRecorder::Direction>(current.flags);
+			entry.data.assign(reinterpret_cast<const char*>(current.data), current.size);
+			entries.push_back(entry);
+			joinable = true;
+		}
+		previous = current.sequence;
+	}
+}
+
+/*
+ * Visszaadja a rgztett bjtsorozatokat.
+ */
+const std::vector<TrafficReplayer::Entry>& TrafficReplayer::getEntries() const {
+	return entries;
+}
+
+/*
+ * Visszaadja a rgzts kezdetnek idpontjt.
+ */
+std::chrono::system_clock::time_point TrafficReplayer::getStartTime() const {
+	return startTime;
+}
+
+/*
+ * Visszajtssza a megadott irny bjtsorozatokat a soros porton.
+ */
+std::size_t TrafficReplayer::replay(CallbackAsyncSerial& port, TrafficRecorder::Direction direction, double speed) const {
+	/* Az temezs az els visszajtszott sorozathoz kpest abszolt hatridkkel trtnik, gy a kldsek ksse nem halmozdik. */
+	std::size_t count = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds origin = std::chrono::nanoseconds::zero();
+	for(const Entry& entry : entries) {
+		if(entry.direction != direction)
+			continue;
+		if(count == 0)
+			origin = entry.time;
+		if(speed > 0.0) {
+			std::chrono::nanoseconds offset(static_cast<std::chrono::nanoseconds::rep>((entry.time - origin).count() / speed));
+			std::this_thread::sleep_until(start + offset);
+		}
+		port.write(entry.data.data(), entry.data.size());
+		count++;
+	}
+	return count;
+}
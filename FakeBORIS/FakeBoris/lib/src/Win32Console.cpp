@@ -0,0 +1,28 @@
+#include <inc\Win32Console.h>
+
+#ifdef _WIN32
+
+/*
+ * Az osztly alaprtelmezett konstruktora.
+ */
+Win32Console::Win32Console() :
+	AbstractConsole(),
+	handle(GetStdHandle(STD_OUTPUT_HANDLE)) {}
+
+/*
+ * Az osztly virtulis destruktora.
+ */
+Win32Console::~Win32Console() {}
+
+/*
+ * Kirja a megadott karaktersorozatokat a konzolkpernyre, karaktersorozatonknt egy hvssal.
+ */
+void Win32Console::write(const std::vector<Run>& runs) {
+	for(const Run& run : runs) {
+		COORD pos = { static_cast<SHORT>(run.x), static_cast<SHORT>(run.y) };
+		DWORD dwCharsWritten = 0;
+		WriteConsoleOutputCharacterA(handle, run.text, static_cast<DWORD>(run.length), pos, &dwCharsWritten);
+	}
+}
+
+#endif
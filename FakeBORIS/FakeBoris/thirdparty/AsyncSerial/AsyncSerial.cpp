@@ -31,41 +31,488 @@
 #include <algorithm>
 #include <iostream>
 #include <boost/bind.hpp>
+#include <boost/aligned_storage.hpp>
 
 using namespace std;
 using namespace boost;
 
+//
+//Class SerialEventLoop
+//
+
+SerialEventLoop::SerialEventLoop(unsigned int threads,
+        const boost::function<void ()>& initializer)
+        : io(), work(new asio::io_service::work(io)), initializer(initializer)
+{
+    for(unsigned int i=0;i<max(threads,1u);i++)
+        this->threads.create_thread(boost::bind(&SerialEventLoop::run, this));
+}
+
+asio::io_service& SerialEventLoop::ioService()
+{
+    return io;
+}
+
+size_t SerialEventLoop::threadCount() const
+{
+    return threads.size();
+}
+
+SerialEventLoop::~SerialEventLoop()
+{
+    work.reset();
+    io.stop();
+    threads.join_all();
+}
+
+void SerialEventLoop::run()
+{
+    if(initializer) initializer();
+    io.run();
+}
+
+//
+//Struct AsyncSerial::LatencyOptions
+//
+
+AsyncSerial::LatencyOptions::LatencyOptions(): minBytes(1),
+        interByteTimeout(0), lowLatency(true), customBaudRate(true)
+{
+
+}
+
 //
 //Class AsyncSerial
 //
 
 #ifndef __APPLE__
 
+#ifndef _WIN32
+#include <termios.h>
+#include <sys/ioctl.h>
+#endif //_WIN32
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif //__linux__
+
+namespace {
+
+#ifndef _WIN32
+
+/**
+ * Set VMIN and VTIME of a serial device.
+ * \return false on error
+ */
+bool setReadTimeouts(int fd, unsigned char minBytes,
+        unsigned char interByteTimeout)
+{
+    struct termios attributes;
+    if(tcgetattr(fd,&attributes)<0) return false;
+    attributes.c_cc[VMIN]=minBytes;
+    attributes.c_cc[VTIME]=interByteTimeout;
+    return tcsetattr(fd,TCSANOW,&attributes)==0;
+}
+
+#endif //_WIN32
+
+#ifdef __linux__
+
+/**
+ * Layout of the struct termios2 of the kernel. Declared here because
+ * <asm/termbits.h>, that defines it, clashes with <termios.h>
+ */
+struct KernelTermios2
+{
+    tcflag_t c_iflag;
+    tcflag_t c_oflag;
+    tcflag_t c_cflag;
+    tcflag_t c_lflag;
+    cc_t c_line;
+    cc_t c_cc[19];
+    speed_t c_ispeed;
+    speed_t c_ospeed;
+};
+
+#ifndef BOTHER
+#define BOTHER 0010000
+#endif //BOTHER
+#ifndef IBSHIFT
+#define IBSHIFT 16
+#endif //IBSHIFT
+
+/**
+ * Set a baud rate that has no Bxxx constant, through termios2 and BOTHER.
+ * The input speed follows the output speed.
+ * \return false on error
+ */
+bool setCustomBaudRate(int fd, unsigned int baud_rate)
+{
+    KernelTermios2 attributes;
+    if(ioctl(fd,_IOR('T',0x2A,KernelTermios2),&attributes)<0) return false;
+    attributes.c_cflag&=~(CBAUD | (CBAUD<<IBSHIFT));
+    attributes.c_cflag|=BOTHER;
+    attributes.c_ispeed=baud_rate;
+    attributes.c_ospeed=baud_rate;
+    return ioctl(fd,_IOW('T',0x2B,KernelTermios2),&attributes)==0;
+}
+
+/**
+ * Set or clear ASYNC_LOW_LATENCY on a serial device.
+ * \return false if the driver does not support it
+ */
+bool setLowLatency(int fd, bool enable)
+{
+    struct serial_struct serial;
+    if(ioctl(fd,TIOCGSERIAL,&serial)<0) return false;
+    if(enable) serial.flags|=ASYNC_LOW_LATENCY;
+    else serial.flags&=~ASYNC_LOW_LATENCY;
+    return ioctl(fd,TIOCSSERIAL,&serial)==0;
+}
+
+#endif //__linux__
+
+/**
+ * Fixed storage for the handler of an asynchronous operation, so that an
+ * operation repeated again and again does not allocate. Only one handler at a
+ * time can use the storage, the others fall back to the heap.
+ */
+class HandlerMemory: private boost::noncopyable
+{
+public:
+    HandlerMemory(): inUse(false) {}
+
+    void *allocate(size_t size)
+    {
+        if(!inUse && size<=sizeof(storage))
+        {
+            inUse=true;
+            return storage.address();
+        }
+        return ::operator new(size);
+    }
+
+    void deallocate(void *pointer)
+    {
+        if(pointer==storage.address()) inUse=false;
+        else ::operator delete(pointer);
+    }
+
+private:
+    boost::aligned_storage<256> storage; ///< Storage for one handler
+    bool inUse; ///< True if the storage holds a handler
+};
+
+/**
+ * Wraps a handler so that asio allocates its operation from a HandlerMemory.
+ */
+template<typename Handler>
+class AllocHandler
+{
+public:
+    AllocHandler(HandlerMemory& m, Handler h): memory(m), handler(h) {}
+
+    void operator()() { handler(); }
+
+    template<typename Arg1>
+    void operator()(Arg1 arg1) { handler(arg1); }
+
+    template<typename Arg1, typename Arg2>
+    void operator()(Arg1 arg1, Arg2 arg2) { handler(arg1,arg2); }
+
+    friend void *asio_handler_allocate(size_t size, AllocHandler *h)
+    {
+        return h->memory.allocate(size);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, size_t /*size*/,
+            AllocHandler *h)
+    {
+        h->memory.deallocate(pointer);
+    }
+
+private:
+    HandlerMemory& memory;
+    Handler handler;
+};
+
+template<typename Handler>
+inline AllocHandler<Handler> makeAllocHandler(HandlerMemory& memory,
+        Handler handler)
+{
+    return AllocHandler<Handler>(memory,handler);
+}
+
+} //namespace
+
 class AsyncSerialImpl: private boost::noncopyable
 {
 public:
-    AsyncSerialImpl(): io(), port(io), backgroundThread(), open(false),
-            error(false) {}
+    /**
+     * \param loop io_service of the event loop, or 0 to use an own one
+     */
+    explicit AsyncSerialImpl(asio::io_service *loop): ownIo(),
+            io(loop ? *loop : ownIo), shared(loop!=0), strand(io), port(io),
+            backgroundThread(), pendingOps(0), open(false),
+            error(false), lowLatency(false), writeActive(false), writeQueueLimit(0),
+            latestCount(0), writeQueued(0), writeDone(0), coReadBuffer(0),
+            coReadSize(0), coReadReceived(0), coReadActive(false),
+            coReadGeneration(0), coReadTimer(io), coWriteTarget(0),
+            coWriteSize(0)
+    {
+        AsyncSerial::WriteQueueStats empty={0,0,0,0,0};
+        stats=empty;
+    }
+
+    /**
+     * Append data to writeQueue, unless it would exceed the limit.
+     * Call with writeQueueMutex locked.
+     * \return false if the data was dropped
+     */
+    bool enqueue(const char *data, size_t size)
+    {
+        if(writeQueueLimit>0 && writeQueue.size()+size>writeQueueLimit)
+        {
+            stats.droppedWrites++;
+            stats.droppedBytes+=size;
+            return false;
+        }
+        writeQueue.insert(writeQueue.end(),data,data+size);
+        writeQueued+=size;
+        stats.highWatermark=max(stats.highWatermark,writeQueue.size());
+        return true;
+    }
 
-    boost::asio::io_service io; ///< Io service object
+    /**
+     * Overwrite a queued state command with the same first byte and size,
+     * or append it to writeQueue. Call with writeQueueMutex locked.
+     * \return false if the data was dropped
+     */
+    bool enqueueLatest(const char *data, size_t size)
+    {
+        if(size==0) return true;
+        for(size_t i=0;i<latestCount;i++)
+        {
+            if(writeQueue[latest[i].offset]!=data[0] || latest[i].size!=size)
+                continue;
+            copy(data,data+size,writeQueue.begin()+latest[i].offset);
+            stats.coalescedWrites++;
+            return true;
+        }
+        size_t offset=writeQueue.size();
+        if(!enqueue(data,size)) return false;
+        if(latestCount<maxLatest)
+        {
+            latest[latestCount].offset=offset;
+            latest[latestCount].size=size;
+            latestCount++;
+        }
+        return true;
+    }
+
+    /**
+     * Count a handler that refers to the device, before it is handed to
+     * the io_service.
+     */
+    void beginOp()
+    {
+        lock_guard<mutex> l(opMutex);
+        pendingOps++;
+    }
+
+    /**
+     * Count a handler that refers to the device as run.
+     */
+    void endOp()
+    {
+        lock_guard<mutex> l(opMutex);
+        if(--pendingOps==0) opsDone.notify_all();
+    }
+
+    /**
+     * Wait until all the handlers that refer to the device have run.
+     */
+    void waitOps()
+    {
+        unique_lock<mutex> l(opMutex);
+        while(pendingOps>0) opsDone.wait(l);
+    }
+
+    /**
+     * Move the queued data to writeBuffer, that must be empty. No copy, the
+     * buffers are swapped and keep their capacity.
+     * Call with writeQueueMutex locked.
+     */
+    void takeQueue()
+    {
+        writeBuffer.swap(writeQueue);
+        latestCount=0; //State commands being written can't be replaced
+        if(writeCallback && !writeBuffer.empty())
+            writeCallback(&writeBuffer[0],writeBuffer.size());
+    }
+
+    boost::asio::io_service ownIo; ///< Io service, if not shared
+    boost::asio::io_service& io; ///< Io service that services the port
+    bool shared; ///< True if io belongs to an event loop
+    /// Serializes the handlers, the io_service of an event loop may be run
+    /// by many threads
+    boost::asio::io_service::strand strand;
     boost::asio::serial_port port; ///< Serial port object
     boost::thread backgroundThread; ///< Thread that runs read/write operations
+    /// Handlers referring to the device not run yet. With an event loop there
+    /// is no thread to join, close() waits for these instead
+    unsigned int pendingOps;
+    boost::mutex opMutex; ///< Mutex for access to pendingOps
+    boost::condition_variable opsDone; ///< Signaled when pendingOps is zero
     bool open; ///< True if port open
     bool error; ///< Error flag
     mutable boost::mutex errorMutex; ///< Mutex for access to error
+    AsyncSerial::LatencyOptions latency; ///< Applied by open()
+    bool lowLatency; ///< True if open() could set ASYNC_LOW_LATENCY
 
-    /// Data are queued here before they go in writeBuffer
+    /// Data are queued here, then swapped with writeBuffer. The two vectors
+    /// keep their capacity, so a steady stream of writes does not allocate
     std::vector<char> writeQueue;
-    boost::shared_array<char> writeBuffer; ///< Data being written
-    size_t writeBufferSize; ///< Size of writeBuffer
-    boost::mutex writeQueueMutex; ///< Mutex for access to writeQueue
+    std::vector<char> writeBuffer; ///< Data being written
+    bool writeActive; ///< True while a write is posted or in progress
+    mutable boost::mutex writeQueueMutex; ///< Mutex for access to writeQueue
+    HandlerMemory writeHandlerMemory; ///< Storage for the write handlers
+    size_t writeQueueLimit; ///< Most bytes in writeQueue, 0 if no limit
+    AsyncSerial::WriteQueueStats stats; ///< Write queue statistics
+    /// Called with the bytes handed to the device, writeQueueMutex locked
+    boost::function<void (const char*, size_t)> writeCallback;
+
+    /// A state command in writeQueue, that a newer one can replace
+    struct LatestCommand
+    {
+        size_t offset; ///< Position in writeQueue
+        size_t size; ///< Size of the command
+    };
+    static const size_t maxLatest=4; ///< Most state commands tracked
+    LatestCommand latest[maxLatest]; ///< State commands in writeQueue
+    size_t latestCount; ///< Number of valid elements in latest
     char readBuffer[AsyncSerial::readBufferSize]; ///< data being read
+    HandlerMemory readHandlerMemory; ///< Storage for the read handler
 
     /// Read complete callback
     boost::function<void (const char*, size_t)> callback;
+
+    /// Called from the background thread before it services the device
+    boost::function<void ()> threadInitializer;
+
+    unsigned long long writeQueued; ///< Bytes ever put in writeQueue
+    unsigned long long writeDone; ///< Bytes ever written to the device
+
+    char *coReadBuffer; ///< Buffer of the coroutine read in progress
+    size_t coReadSize; ///< Size of the coroutine read
+    size_t coReadReceived; ///< Bytes of the coroutine read received so far
+    bool coReadActive; ///< True while the coroutine read is not complete
+    unsigned int coReadGeneration; ///< Tells apart stale timeouts
+    boost::asio::deadline_timer coReadTimer; ///< Coroutine read timeout
+    boost::system::error_code coReadError; ///< Result of the coroutine read
+    /// Resumes the coroutine waiting for the read, if any
+    boost::function<void (const boost::system::error_code&, size_t)>
+            coReadHandler;
+
+    unsigned long long coWriteTarget; ///< writeDone ending the coroutine write
+    size_t coWriteSize; ///< Size of the coroutine write
+    /// Resumes the coroutine waiting for the write, if any
+    boost::function<void (const boost::system::error_code&, size_t)>
+            coWriteHandler;
 };
 
-AsyncSerial::AsyncSerial(): pimpl(new AsyncSerialImpl)
+namespace {
+
+/**
+ * Wraps a handler that refers to the device, so that close() can tell when
+ * it has run. The handler is counted when wrapped, and must be handed to the
+ * io_service exactly once.
+ */
+template<typename Handler>
+class OpHandler
+{
+public:
+    OpHandler(AsyncSerialImpl& i, Handler h): impl(&i), handler(h) {}
+
+    void operator()() { handler(); impl->endOp(); }
+
+    template<typename Arg1>
+    void operator()(Arg1 arg1) { handler(arg1); impl->endOp(); }
+
+    template<typename Arg1, typename Arg2>
+    void operator()(Arg1 arg1, Arg2 arg2) { handler(arg1,arg2); impl->endOp(); }
+
+private:
+    AsyncSerialImpl *impl;
+    Handler handler;
+};
+
+template<typename Handler>
+inline OpHandler<Handler> makeOpHandler(AsyncSerialImpl& impl, Handler handler)
+{
+    impl.beginOp();
+    return OpHandler<Handler>(impl,handler);
+}
+
+/**
+ * Turns the yield context of a coroutine into a completion handler and the
+ * object that suspends the coroutine until the handler is called. Hides the
+ * change of the asio interface in boost 1.66.
+ */
+class YieldCompletion
+{
+public:
+#if BOOST_VERSION >= 106600
+    typedef asio::async_completion<asio::yield_context,
+            void (boost::system::error_code, size_t)> Completion;
+    typedef Completion::completion_handler_type Handler;
+
+    explicit YieldCompletion(asio::yield_context& yield): completion(yield) {}
+
+    Handler& handler() { return completion.completion_handler; }
+
+    size_t get() { return completion.result.get(); }
+
+private:
+    Completion completion;
+#else //BOOST_VERSION
+    typedef asio::handler_type<asio::yield_context,
+            void (boost::system::error_code, size_t)>::type Handler;
+
+    explicit YieldCompletion(asio::yield_context& yield): h(yield), result(h) {}
+
+    Handler& handler() { return h; }
+
+    size_t get() { return result.get(); }
+
+private:
+    Handler h;
+    asio::async_result<Handler> result;
+#endif //BOOST_VERSION
+};
+
+/**
+ * Body of the coroutines started by spawn(). Moves into the strand of the
+ * device first, so that the coroutine never runs concurrently with the
+ * handlers of the device, then runs the user's coroutine.
+ */
+void runInStrand(asio::io_service::strand *strand,
+        const boost::function<void (AsyncSerial::Yield)>& coroutine,
+        AsyncSerial::Yield yield)
+{
+    strand->post(yield);
+    coroutine(yield);
+}
+
+} //namespace
+
+AsyncSerial::AsyncSerial(): pimpl(new AsyncSerialImpl(0))
+{
+
+}
+
+AsyncSerial::AsyncSerial(SerialEventLoop& loop)
+        : pimpl(new AsyncSerialImpl(&loop.ioService()))
 {
 
 }
@@ -75,7 +522,7 @@ AsyncSerial::AsyncSerial(const std::string& devname, unsigned int baud_rate,
         asio::serial_port_base::character_size opt_csize,
         asio::serial_port_base::flow_control opt_flow,
         asio::serial_port_base::stop_bits opt_stop)
-        : pimpl(new AsyncSerialImpl)
+        : pimpl(new AsyncSerialImpl(0))
 {
     open(devname,baud_rate,opt_parity,opt_csize,opt_flow,opt_stop);
 }
@@ -90,17 +537,78 @@ void AsyncSerial::open(const std::string& devname, unsigned int baud_rate,
 
     setErrorStatus(true);//If an exception is thrown, error_ remains true
     pimpl->port.open(devname);
-    pimpl->port.set_option(asio::serial_port_base::baud_rate(baud_rate));
     pimpl->port.set_option(opt_parity);
     pimpl->port.set_option(opt_csize);
     pimpl->port.set_option(opt_flow);
     pimpl->port.set_option(opt_stop);
 
-    //This gives some work to the io_service before it is started
-    pimpl->io.post(boost::bind(&AsyncSerial::doRead, this));
+    #ifndef _WIN32
+    //Before the baud rate, tcsetattr() would not keep a BOTHER rate
+    setReadTimeouts(pimpl->port.native_handle(),pimpl->latency.minBytes,
+            pimpl->latency.interByteTimeout);
+    #endif //_WIN32
 
-    thread t(boost::bind(&asio::io_service::run, &pimpl->io));
-    pimpl->backgroundThread.swap(t);
+    boost::system::error_code ec;
+    pimpl->port.set_option(asio::serial_port_base::baud_rate(baud_rate),ec);
+    #ifdef __linux__
+    if(ec==asio::error::invalid_argument && pimpl->latency.customBaudRate &&
+            setCustomBaudRate(pimpl->port.native_handle(),baud_rate))
+        ec=boost::system::error_code();
+    #endif //__linux__
+    if(ec)
+    {
+        boost::system::error_code ignored;
+        pimpl->port.close(ignored); //So that open() can be retried
+        throw(boost::system::system_error(ec,"Unsupported baud rate"));
+    }
+
+    pimpl->lowLatency=false;
+    #ifdef __linux__
+    //Pseudo terminals and some drivers don't have the flag, not an error
+    pimpl->lowLatency=pimpl->latency.lowLatency &&
+            setLowLatency(pimpl->port.native_handle(),true);
+    #endif //__linux__
+
+    startService();
+}
+
+void AsyncSerial::assign(const asio::serial_port::native_handle_type& handle)
+{
+    if(isOpen()) close();
+
+    setErrorStatus(true);//If an exception is thrown, error_ remains true
+    pimpl->port.assign(handle);
+    pimpl->lowLatency=false;
+    startService();
+}
+
+void AsyncSerial::startService()
+{
+    //Data left from a previous session, if any, is not sent to a new device
+    {
+        lock_guard<mutex> l(pimpl->writeQueueMutex);
+        pimpl->writeQueue.clear();
+        pimpl->writeBuffer.clear();
+        pimpl->writeActive=false;
+        pimpl->latestCount=0;
+    }
+
+    if(pimpl->shared)
+    {
+        //The threads of the event loop start reading at once
+        pimpl->strand.post(makeOpHandler(*pimpl,
+                boost::bind(&AsyncSerial::doRead, this)));
+    } else {
+        //The initializer, if any, is the first thing the background thread runs
+        if(pimpl->threadInitializer) pimpl->io.post(pimpl->threadInitializer);
+
+        //This gives some work to the io_service before it is started
+        pimpl->strand.post(makeOpHandler(*pimpl,
+                boost::bind(&AsyncSerial::doRead, this)));
+
+        thread t(boost::bind(&asio::io_service::run, &pimpl->io));
+        pimpl->backgroundThread.swap(t);
+    }
     setErrorStatus(false);//If we get here, no error
     pimpl->open=true; //Port is now open
 }
@@ -121,9 +629,20 @@ void AsyncSerial::close()
     if(!isOpen()) return;
 
     pimpl->open=false;
-    pimpl->io.post(boost::bind(&AsyncSerial::doClose, this));
-    pimpl->backgroundThread.join();
-    pimpl->io.reset();
+    pimpl->strand.post(makeOpHandler(*pimpl,
+            boost::bind(&AsyncSerial::doClose, this)));
+    if(pimpl->shared)
+    {
+        //The event loop keeps running, wait for the last handler instead
+        pimpl->waitOps();
+    } else {
+        pimpl->backgroundThread.join();
+        //If the device failed, the loop ran out of work before the close
+        //was posted. Run it here, or it would close the next session's port
+        pimpl->io.reset();
+        pimpl->io.poll();
+        pimpl->io.reset();
+    }
     if(errorStatus())
     {
         throw(boost::system::system_error(boost::system::error_code(),
@@ -131,32 +650,57 @@ void AsyncSerial::close()
     }
 }
 
-void AsyncSerial::write(const char *data, size_t size)
+bool AsyncSerial::write(const char *data, size_t size)
 {
+    bool start;
     {
         lock_guard<mutex> l(pimpl->writeQueueMutex);
-        pimpl->writeQueue.insert(pimpl->writeQueue.end(),data,data+size);
+        if(!pimpl->enqueue(data,size)) return false;
+        start=!pimpl->writeActive;
+        pimpl->writeActive=true;
     }
-    pimpl->io.post(boost::bind(&AsyncSerial::doWrite, this));
+    //If a write is already posted or in progress, it will take the data too
+    if(start) pimpl->strand.post(makeAllocHandler(pimpl->writeHandlerMemory,
+            makeOpHandler(*pimpl,boost::bind(&AsyncSerial::doWrite, this))));
+    return true;
 }
 
 void AsyncSerial::write(const std::vector<char>& data)
 {
-    {
-        lock_guard<mutex> l(pimpl->writeQueueMutex);
-        pimpl->writeQueue.insert(pimpl->writeQueue.end(),data.begin(),
-                data.end());
-    }
-    pimpl->io.post(boost::bind(&AsyncSerial::doWrite, this));
+    if(!data.empty()) write(&data[0],data.size());
 }
 
 void AsyncSerial::writeString(const std::string& s)
 {
+    if(!s.empty()) write(s.data(),s.size());
+}
+
+bool AsyncSerial::writeLatest(const char *data, size_t size)
+{
+    bool start;
     {
         lock_guard<mutex> l(pimpl->writeQueueMutex);
-        pimpl->writeQueue.insert(pimpl->writeQueue.end(),s.begin(),s.end());
+        if(!pimpl->enqueueLatest(data,size)) return false;
+        start=!pimpl->writeActive;
+        pimpl->writeActive=true;
     }
-    pimpl->io.post(boost::bind(&AsyncSerial::doWrite, this));
+    if(start) pimpl->strand.post(makeAllocHandler(pimpl->writeHandlerMemory,
+            makeOpHandler(*pimpl,boost::bind(&AsyncSerial::doWrite, this))));
+    return true;
+}
+
+void AsyncSerial::setWriteQueueLimit(size_t bytes)
+{
+    lock_guard<mutex> l(pimpl->writeQueueMutex);
+    pimpl->writeQueueLimit=bytes;
+}
+
+AsyncSerial::WriteQueueStats AsyncSerial::writeQueueStats() const
+{
+    lock_guard<mutex> l(pimpl->writeQueueMutex);
+    WriteQueueStats result=pimpl->stats;
+    result.queued=pimpl->writeQueue.size();
+    return result;
 }
 
 AsyncSerial::~AsyncSerial()
@@ -175,10 +719,11 @@ AsyncSerial::~AsyncSerial()
 void AsyncSerial::doRead()
 {
     pimpl->port.async_read_some(asio::buffer(pimpl->readBuffer,readBufferSize),
-            boost::bind(&AsyncSerial::readEnd,
+            pimpl->strand.wrap(makeAllocHandler(pimpl->readHandlerMemory,
+            makeOpHandler(*pimpl,boost::bind(&AsyncSerial::readEnd,
             this,
             asio::placeholders::error,
-            asio::placeholders::bytes_transferred));
+            asio::placeholders::bytes_transferred)))));
 }
 
 void AsyncSerial::readEnd(const boost::system::error_code& error,
@@ -203,49 +748,67 @@ void AsyncSerial::readEnd(const boost::system::error_code& error,
             setErrorStatus(true);
         }
     } else {
-        if(pimpl->callback) pimpl->callback(pimpl->readBuffer,
-                bytes_transferred);
+        const char *data=pimpl->readBuffer;
+        size_t size=bytes_transferred;
+
+        //A coroutine read in progress takes the data first
+        if(pimpl->coReadActive)
+        {
+            size_t n=min(size,pimpl->coReadSize-pimpl->coReadReceived);
+            copy(data,data+n,pimpl->coReadBuffer+pimpl->coReadReceived);
+            pimpl->coReadReceived+=n;
+            data+=n;
+            size-=n;
+            if(pimpl->coReadReceived==pimpl->coReadSize)
+                completeCoRead(boost::system::error_code());
+        }
+
+        if(size>0 && pimpl->callback) pimpl->callback(data,size);
         doRead();
     }
 }
 
 void AsyncSerial::doWrite()
 {
+    lock_guard<mutex> l(pimpl->writeQueueMutex);
     //If a write operation is already in progress, do nothing
-    if(pimpl->writeBuffer==0)
+    if(!pimpl->writeBuffer.empty()) return;
+    if(pimpl->writeQueue.empty())
     {
-        lock_guard<mutex> l(pimpl->writeQueueMutex);
-        pimpl->writeBufferSize=pimpl->writeQueue.size();
-        pimpl->writeBuffer.reset(new char[pimpl->writeQueue.size()]);
-        copy(pimpl->writeQueue.begin(),pimpl->writeQueue.end(),
-                pimpl->writeBuffer.get());
-        pimpl->writeQueue.clear();
-        async_write(pimpl->port,asio::buffer(pimpl->writeBuffer.get(),
-                pimpl->writeBufferSize),
-                boost::bind(&AsyncSerial::writeEnd, this, asio::placeholders::error));
+        pimpl->writeActive=false;
+        return;
     }
+    pimpl->takeQueue();
+    async_write(pimpl->port,asio::buffer(pimpl->writeBuffer),
+            pimpl->strand.wrap(makeAllocHandler(pimpl->writeHandlerMemory,
+            makeOpHandler(*pimpl,boost::bind(&AsyncSerial::writeEnd, this,
+            asio::placeholders::error)))));
 }
 
 void AsyncSerial::writeEnd(const boost::system::error_code& error)
 {
     if(!error)
     {
-        lock_guard<mutex> l(pimpl->writeQueueMutex);
-        if(pimpl->writeQueue.empty())
         {
-            pimpl->writeBuffer.reset();
-            pimpl->writeBufferSize=0;
-            
-            return;
+            lock_guard<mutex> l(pimpl->writeQueueMutex);
+            pimpl->writeDone+=pimpl->writeBuffer.size();
+            pimpl->writeBuffer.clear();
+            if(pimpl->writeQueue.empty())
+            {
+                pimpl->writeActive=false;
+            } else {
+                pimpl->takeQueue();
+                async_write(pimpl->port,asio::buffer(pimpl->writeBuffer),
+                        pimpl->strand.wrap(makeAllocHandler(
+                        pimpl->writeHandlerMemory,makeOpHandler(*pimpl,
+                        boost::bind(&AsyncSerial::writeEnd, this,
+                        asio::placeholders::error)))));
+            }
         }
-        pimpl->writeBufferSize=pimpl->writeQueue.size();
-        pimpl->writeBuffer.reset(new char[pimpl->writeQueue.size()]);
-        copy(pimpl->writeQueue.begin(),pimpl->writeQueue.end(),
-                pimpl->writeBuffer.get());
-        pimpl->writeQueue.clear();
-        async_write(pimpl->port,asio::buffer(pimpl->writeBuffer.get(),
-                pimpl->writeBufferSize),
-                boost::bind(&AsyncSerial::writeEnd, this, asio::placeholders::error));
+
+        //Only the background thread updates writeDone, no need to lock
+        if(pimpl->coWriteHandler && pimpl->writeDone>=pimpl->coWriteTarget)
+            completeCoWrite(boost::system::error_code());
     } else {
         setErrorStatus(true);
         doClose();
@@ -259,6 +822,126 @@ void AsyncSerial::doClose()
     if(ec) setErrorStatus(true);
     pimpl->port.close(ec);
     if(ec) setErrorStatus(true);
+
+    //Coroutines waiting for the device would never be resumed otherwise
+    if(pimpl->coReadActive) completeCoRead(asio::error::operation_aborted);
+    if(pimpl->coWriteHandler) completeCoWrite(asio::error::operation_aborted);
+}
+
+void AsyncSerial::spawn(const boost::function<void (Yield)>& coroutine)
+{
+    if(!isOpen()) throw(boost::system::system_error(
+            asio::error::not_connected,"Serial device not open"));
+    asio::spawn(pimpl->io,boost::bind(&runInStrand,&pimpl->strand,coroutine,
+            _1));
+}
+
+size_t AsyncSerial::asyncReadExact(char *data, size_t size,
+        const boost::posix_time::time_duration& timeout, Yield yield)
+{
+    beginCoRead(data,size,timeout);
+    return waitCoRead(yield);
+}
+
+size_t AsyncSerial::asyncWrite(const char *data, size_t size, Yield yield)
+{
+    if(pimpl->coWriteHandler) throw(boost::system::system_error(
+            asio::error::already_started,"Coroutine write in progress"));
+    if(!isOpen()) throw(boost::system::system_error(
+            asio::error::not_connected,"Serial device not open"));
+
+    YieldCompletion completion(yield);
+    bool start;
+    {
+        lock_guard<mutex> l(pimpl->writeQueueMutex);
+        if(!pimpl->enqueue(data,size)) throw(boost::system::system_error(
+                asio::error::no_buffer_space,"Write queue full"));
+        pimpl->coWriteTarget=pimpl->writeQueued;
+        start=!pimpl->writeActive;
+        pimpl->writeActive=true;
+    }
+    pimpl->coWriteSize=size;
+    pimpl->coWriteHandler=completion.handler();
+    if(start) doWrite(); //Already in the strand of the device, no need to post
+    if(pimpl->writeDone>=pimpl->coWriteTarget)
+        completeCoWrite(boost::system::error_code()); //Nothing to wait for
+    return completion.get();
+}
+
+size_t AsyncSerial::asyncTransact(const char *command, size_t commandSize,
+        char *reply, size_t replySize,
+        const boost::posix_time::time_duration& timeout, Yield yield)
+{
+    //The reply buffer must be registered before the command goes out
+    beginCoRead(reply,replySize,timeout);
+
+    boost::system::error_code ec;
+    asyncWrite(command,commandSize,yield[ec]);
+    if(ec && pimpl->coReadActive) completeCoRead(ec);
+    return waitCoRead(yield);
+}
+
+void AsyncSerial::beginCoRead(char *data, size_t size,
+        const boost::posix_time::time_duration& timeout)
+{
+    if(pimpl->coReadActive) throw(boost::system::system_error(
+            asio::error::already_started,"Coroutine read in progress"));
+    if(!isOpen()) throw(boost::system::system_error(
+            asio::error::not_connected,"Serial device not open"));
+
+    pimpl->coReadBuffer=data;
+    pimpl->coReadSize=size;
+    pimpl->coReadReceived=0;
+    pimpl->coReadError=boost::system::error_code();
+    pimpl->coReadActive=size>0;
+    pimpl->coReadGeneration++;
+    if(pimpl->coReadActive && !timeout.is_special())
+    {
+        pimpl->coReadTimer.expires_from_now(timeout);
+        pimpl->coReadTimer.async_wait(pimpl->strand.wrap(makeOpHandler(*pimpl,
+                boost::bind(&AsyncSerial::coReadTimeout,this,
+                asio::placeholders::error,pimpl->coReadGeneration))));
+    }
+}
+
+size_t AsyncSerial::waitCoRead(Yield yield)
+{
+    YieldCompletion completion(yield);
+    if(pimpl->coReadActive) pimpl->coReadHandler=completion.handler();
+    else pimpl->strand.post(boost::bind<void>(completion.handler(),
+            pimpl->coReadError,pimpl->coReadReceived));
+    return completion.get();
+}
+
+void AsyncSerial::coReadTimeout(const boost::system::error_code& error,
+        unsigned int generation)
+{
+    //The timer may have been cancelled, or expired for an older read
+    if(error || generation!=pimpl->coReadGeneration || !pimpl->coReadActive)
+        return;
+    completeCoRead(asio::error::timed_out);
+}
+
+void AsyncSerial::completeCoRead(const boost::system::error_code& error)
+{
+    boost::system::error_code ec;
+    pimpl->coReadActive=false;
+    pimpl->coReadError=error;
+    pimpl->coReadTimer.cancel(ec);
+    if(pimpl->coReadHandler)
+    {
+        //Posted, so that the coroutine does not run inside readEnd()
+        pimpl->strand.post(boost::bind<void>(pimpl->coReadHandler,error,
+                pimpl->coReadReceived));
+        pimpl->coReadHandler.clear();
+    }
+}
+
+void AsyncSerial::completeCoWrite(const boost::system::error_code& error)
+{
+    pimpl->strand.post(boost::bind<void>(pimpl->coWriteHandler,error,
+            pimpl->coWriteSize));
+    pimpl->coWriteHandler.clear();
 }
 
 void AsyncSerial::setErrorStatus(bool e)
@@ -277,6 +960,29 @@ void AsyncSerial::clearReadCallback()
     pimpl->callback.clear();
 }
 
+void AsyncSerial::setThreadInitializer(const
+        boost::function<void ()>& initializer)
+{
+    pimpl->threadInitializer=initializer;
+}
+
+void AsyncSerial::setWriteCallback(const
+        boost::function<void (const char*, size_t)>& callback)
+{
+    lock_guard<mutex> l(pimpl->writeQueueMutex);
+    pimpl->writeCallback=callback;
+}
+
+void AsyncSerial::setLatencyOptions(const LatencyOptions& options)
+{
+    pimpl->latency=options;
+}
+
+bool AsyncSerial::lowLatencyActive() const
+{
+    return pimpl->lowLatency;
+}
+
 #else //__APPLE__
 
 #include <sys/types.h>
@@ -294,6 +1000,7 @@ public:
     bool open; ///< True if port open
     bool error; ///< Error flag
     mutable boost::mutex errorMutex; ///< Mutex for access to error
+    AsyncSerial::LatencyOptions latency; ///< Applied by open()
 
     int fd; ///< File descriptor for serial port
     
@@ -301,6 +1008,12 @@ public:
 
     /// Read complete callback
     boost::function<void (const char*, size_t)> callback;
+
+    /// Called from the background thread before it services the device
+    boost::function<void ()> threadInitializer;
+
+    /// Called with the bytes written to the device
+    boost::function<void (const char*, size_t)> writeCallback;
 };
 
 AsyncSerial::AsyncSerial(): pimpl(new AsyncSerialImpl)
@@ -308,6 +1021,11 @@ AsyncSerial::AsyncSerial(): pimpl(new AsyncSerialImpl)
 
 }
 
+AsyncSerial::AsyncSerial(SerialEventLoop& loop): pimpl(new AsyncSerialImpl)
+{
+    //The read thread is blocking, there is nothing to share
+}
+
 AsyncSerial::AsyncSerial(const std::string& devname, unsigned int baud_rate,
         asio::serial_port_base::parity opt_parity,
         asio::serial_port_base::character_size opt_csize,
@@ -354,8 +1072,8 @@ void AsyncSerial::open(const std::string& devname, unsigned int baud_rate,
     chars (even if VTIME timeout expires); once it has read at least vmin chars, if subsequent
     chars do not arrive before VTIME expires, it returns error; if a char arrives, it resets the
     timeout, so the internal timer will again start from zero (for the nex char,if any)*/
-    new_attributes.c_cc[VMIN]=1;// Minimum number of characters to read before returning error
-    new_attributes.c_cc[VTIME]=1;// Set timeouts in tenths of second
+    new_attributes.c_cc[VMIN]=pimpl->latency.minBytes;// Minimum number of characters to read before returning error
+    new_attributes.c_cc[VTIME]=pimpl->latency.interByteTimeout;// Set timeouts in tenths of second
 
     // Set baud rate
     switch(baud_rate)
@@ -398,8 +1116,21 @@ void AsyncSerial::open(const std::string& devname, unsigned int baud_rate,
                     boost::system::error_code(),"Can't set port attributes"));
     }
 
+    startService();
+}
+
+void AsyncSerial::assign(const asio::serial_port::native_handle_type& handle)
+{
+    if(isOpen()) close();
+
+    pimpl->fd=handle;
+    startService();
+}
+
+void AsyncSerial::startService()
+{
     //These 3 lines clear the O_NONBLOCK flag
-    status=fcntl(pimpl->fd, F_GETFL, 0);
+    int status=fcntl(pimpl->fd, F_GETFL, 0);
     if(status!=-1) fcntl(pimpl->fd, F_SETFL, status & ~O_NONBLOCK);
 
     setErrorStatus(false);//If we get here, no error
@@ -436,9 +1167,15 @@ void AsyncSerial::close()
     }
 }
 
-void AsyncSerial::write(const char *data, size_t size)
+bool AsyncSerial::write(const char *data, size_t size)
 {
-    if(::write(pimpl->fd,data,size)!=size) setErrorStatus(true);
+    if(::write(pimpl->fd,data,size)!=size)
+    {
+        setErrorStatus(true);
+        return false;
+    }
+    if(pimpl->writeCallback) pimpl->writeCallback(data,size);
+    return true;
 }
 
 void AsyncSerial::write(const std::vector<char>& data)
@@ -452,6 +1189,23 @@ void AsyncSerial::writeString(const std::string& s)
     if(::write(pimpl->fd,&s[0],s.size())!=s.size()) setErrorStatus(true);
 }
 
+bool AsyncSerial::writeLatest(const char *data, size_t size)
+{
+    //Writes are synchronous, nothing is ever queued to be replaced
+    return write(data,size);
+}
+
+void AsyncSerial::setWriteQueueLimit(size_t bytes)
+{
+    //Writes are synchronous, there is no queue
+}
+
+AsyncSerial::WriteQueueStats AsyncSerial::writeQueueStats() const
+{
+    WriteQueueStats result={0,0,0,0,0};
+    return result;
+}
+
 AsyncSerial::~AsyncSerial()
 {
     if(isOpen())
@@ -467,6 +1221,8 @@ AsyncSerial::~AsyncSerial()
 
 void AsyncSerial::doRead()
 {
+    if(pimpl->threadInitializer) pimpl->threadInitializer();
+
     //Read loop in spawned thread
     for(;;)
     {
@@ -521,15 +1277,79 @@ void AsyncSerial::clearReadCallback()
     pimpl->callback.clear();
 }
 
+void AsyncSerial::setThreadInitializer(const
+        boost::function<void ()>& initializer)
+{
+    pimpl->threadInitializer=initializer;
+}
+
+void AsyncSerial::setWriteCallback(const
+        boost::function<void (const char*, size_t)>& callback)
+{
+    pimpl->writeCallback=callback;
+}
+
+void AsyncSerial::setLatencyOptions(const LatencyOptions& options)
+{
+    pimpl->latency=options;
+}
+
+bool AsyncSerial::lowLatencyActive() const
+{
+    //ASYNC_LOW_LATENCY is Linux only
+    return false;
+}
+
+void AsyncSerial::spawn(const boost::function<void (Yield)>& coroutine)
+{
+    //Not supported, there is no io_service
+    throw(boost::system::system_error(asio::error::operation_not_supported,
+            "Coroutines not supported on Mac OS X"));
+}
+
+size_t AsyncSerial::asyncReadExact(char *data, size_t size,
+        const boost::posix_time::time_duration& timeout, Yield yield)
+{
+    //Not supported, there is no io_service
+    throw(boost::system::system_error(asio::error::operation_not_supported,
+            "Coroutines not supported on Mac OS X"));
+}
+
+size_t AsyncSerial::asyncWrite(const char *data, size_t size, Yield yield)
+{
+    //Not supported, there is no io_service
+    throw(boost::system::system_error(asio::error::operation_not_supported,
+            "Coroutines not supported on Mac OS X"));
+}
+
+size_t AsyncSerial::asyncTransact(const char *command, size_t commandSize,
+        char *reply, size_t replySize,
+        const boost::posix_time::time_duration& timeout, Yield yield)
+{
+    //Not supported, there is no io_service
+    throw(boost::system::system_error(asio::error::operation_not_supported,
+            "Coroutines not supported on Mac OS X"));
+}
+
 #endif //__APPLE__
 
 //
 //Class CallbackAsyncSerial
 //
 
-CallbackAsyncSerial::CallbackAsyncSerial(): AsyncSerial()
+CallbackAsyncSerial::CallbackAsyncSerial(): AsyncSerial(), pending(0),
+        pendingCount(0), overflows(0), overflowBytes(0)
 {
+    setReadCallback(boost::bind(&CallbackAsyncSerial::readDispatch, this,
+            _1, _2));
+}
 
+CallbackAsyncSerial::CallbackAsyncSerial(SerialEventLoop& loop)
+        : AsyncSerial(loop), pending(0), pendingCount(0), overflows(0),
+        overflowBytes(0)
+{
+    setReadCallback(boost::bind(&CallbackAsyncSerial::readDispatch, this,
+            _1, _2));
 }
 
 CallbackAsyncSerial::CallbackAsyncSerial(const std::string& devname,
@@ -538,20 +1358,142 @@ CallbackAsyncSerial::CallbackAsyncSerial(const std::string& devname,
         asio::serial_port_base::character_size opt_csize,
         asio::serial_port_base::flow_control opt_flow,
         asio::serial_port_base::stop_bits opt_stop)
-        :AsyncSerial(devname,baud_rate,opt_parity,opt_csize,opt_flow,opt_stop)
+        :AsyncSerial(devname,baud_rate,opt_parity,opt_csize,opt_flow,opt_stop),
+        pending(0), pendingCount(0), overflows(0), overflowBytes(0)
 {
-
+    setReadCallback(boost::bind(&CallbackAsyncSerial::readDispatch, this,
+            _1, _2));
 }
 
 void CallbackAsyncSerial::setCallback(const
         boost::function<void (const char*, size_t)>& callback)
 {
-    setReadCallback(callback);
+    userCallback=callback;
 }
 
 void CallbackAsyncSerial::clearCallback()
 {
-    clearReadCallback();
+    userCallback.clear();
+}
+
+void CallbackAsyncSerial::transact(const char *command, size_t commandSize,
+        char *reply, size_t replySize,
+        const boost::posix_time::time_duration& timeout)
+{
+    Transaction t={command,commandSize,reply,replySize,0};
+    transact(&t,1,timeout);
+}
+
+void CallbackAsyncSerial::transact(Transaction *transactions, size_t count,
+        const boost::posix_time::time_duration& timeout)
+{
+    if(count==0) return;
+    if(!isOpen()) throw(boost::system::system_error(
+            asio::error::not_connected,"Serial device not open"));
+
+    lock_guard<mutex> t(transactMutex);
+    system_time deadline=get_system_time()+timeout;
+
+    //Register the reply buffers before sending, so that a fast reply can't
+    //reach the read callback instead
+    for(size_t i=0;i<count;i++) transactions[i].received=0;
+    {
+        lock_guard<mutex> l(pendingMutex);
+        pending=transactions;
+        pendingCount=count;
+        popCompleted(); //Transactions that expect no reply
+    }
+    for(size_t i=0;i<count;i++)
+    {
+        if(write(transactions[i].command,transactions[i].commandSize))
+            continue;
+        //The bounded write queue dropped the command, so its reply will
+        //never arrive: fail now instead of waiting for the timeout
+        lock_guard<mutex> l(pendingMutex);
+        pending=0;
+        pendingCount=0;
+        throw(boost::system::system_error(asio::error::no_buffer_space,
+                "Write queue full"));
+    }
+
+    unique_lock<mutex> l(pendingMutex);
+    while(pendingCount>0)
+    {
+        if(!pendingDone.timed_wait(l,deadline) && pendingCount>0)
+        {
+            //Unregister the buffers, they may go out of scope after the throw
+            pending=0;
+            pendingCount=0;
+            throw(boost::system::system_error(asio::error::timed_out,
+                    "Transaction timed out"));
+        }
+    }
+}
+
+void CallbackAsyncSerial::readDispatch(const char *data, size_t size)
+{
+    {
+        lock_guard<mutex> l(pendingMutex);
+        while(size>0 && pendingCount>0)
+        {
+            Transaction& t=*pending;
+            size_t n=min(size,t.replySize-t.received);
+            copy(data,data+n,t.reply+t.received);
+            t.received+=n;
+            data+=n;
+            size-=n;
+            popCompleted();
+        }
+    }
+    if(size==0) return;
+    if(ring)
+    {
+        //Never wait for the consumer, what does not fit is lost
+        size_t pushed=ring->push(data,size);
+        if(pushed<size)
+        {
+            overflows++;
+            overflowBytes+=size-pushed;
+        }
+    } else if(userCallback) userCallback(data,size);
+}
+
+void CallbackAsyncSerial::popCompleted()
+{
+    while(pendingCount>0 && pending->received==pending->replySize)
+    {
+        pending++;
+        pendingCount--;
+    }
+    if(pendingCount==0)
+    {
+        pending=0;
+        pendingDone.notify_one();
+    }
+}
+
+void CallbackAsyncSerial::setReceiveRing(size_t size)
+{
+    if(isOpen()) throw(boost::system::system_error(
+            asio::error::already_open,"Serial device already open"));
+    if(size>0) ring.reset(new lockfree::spsc_queue<char>(size));
+    else ring.reset();
+}
+
+size_t CallbackAsyncSerial::pull(char *data, size_t size)
+{
+    if(!ring) return 0;
+    return ring->pop(data,size);
+}
+
+unsigned long long CallbackAsyncSerial::receiveOverflows() const
+{
+    return overflows;
+}
+
+unsigned long long CallbackAsyncSerial::receiveOverflowBytes() const
+{
+    return overflowBytes;
 }
 
 CallbackAsyncSerial::~CallbackAsyncSerial()
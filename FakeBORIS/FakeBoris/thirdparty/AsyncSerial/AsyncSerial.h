@@ -10,17 +10,75 @@
 
 #include <vector>
 #include <boost/asio.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
 #include <boost/utility.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_array.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
 
 /**
  * Used internally (pimpl)
  */
 class AsyncSerialImpl;
 
+/**
+ * Event loop shared by many serial devices. Normally every AsyncSerial has
+ * its own io_service and background thread, so a process driving fifty
+ * devices runs fifty threads. Devices constructed with an event loop instead
+ * register their descriptors with its io_service, which on Linux is a single
+ * epoll reactor: reads complete when the descriptor becomes readable, and
+ * queued writes are flushed when it becomes writable again, all serviced by
+ * the few threads of the loop. The handlers of each device are serialized,
+ * so a device never runs its callback on two threads at once.
+ */
+class SerialEventLoop: private boost::noncopyable
+{
+public:
+    /**
+     * Constructor. Starts the threads that service the devices.
+     * \param threads number of threads, at least one
+     * \param initializer function called once from each thread before it
+     * starts servicing the devices, or an empty function for none. Useful to
+     * set up scheduling priority or CPU affinity of the threads.
+     */
+    explicit SerialEventLoop(unsigned int threads=1,
+            const boost::function<void ()>& initializer=
+                boost::function<void ()>());
+
+    /**
+     * \return the io_service the devices register with
+     */
+    boost::asio::io_service& ioService();
+
+    /**
+     * \return number of threads servicing the devices
+     */
+    size_t threadCount() const;
+
+    /**
+     * Destructor. Stops the threads. All the devices using the event loop
+     * must be closed before.
+     */
+    ~SerialEventLoop();
+
+private:
+
+    /**
+     * Body of the threads, runs the initializer then the io_service.
+     */
+    void run();
+
+    boost::asio::io_service io; ///< Io service shared by the devices
+    /// Keeps the threads running while no device is open
+    boost::scoped_ptr<boost::asio::io_service::work> work;
+    boost::function<void ()> initializer; ///< Called first by each thread
+    boost::thread_group threads; ///< Threads that run io
+};
+
 /**
  * Asyncronous serial class.
  * Intended to be a base class.
@@ -30,6 +88,14 @@ class AsyncSerial: private boost::noncopyable
 public:
     AsyncSerial();
 
+    /**
+     * Constructor. The serial device, once opened, is serviced by the threads
+     * of a shared event loop instead of a background thread of its own. On
+     * Mac OS X the loop is ignored, and each device has its own thread.
+     * \param loop event loop, must outlive the object
+     */
+    explicit AsyncSerial(SerialEventLoop& loop);
+
     /**
      * Constructor. Creates and opens a serial device.
      * \param devname serial device name, example "/dev/ttyS0" or "COM1"
@@ -78,6 +144,15 @@ public:
             boost::asio::serial_port_base::stop_bits(
                 boost::asio::serial_port_base::stop_bits::one));
 
+    /**
+     * Use an already open descriptor instead of opening a serial device, for
+     * example the master side of a pseudo terminal or a connected socket.
+     * No serial option is set, and close() closes the descriptor.
+     * \param handle native descriptor, the object takes ownership of it
+     * \throws boost::system::system_error if the descriptor can't be used
+     */
+    void assign(const boost::asio::serial_port::native_handle_type& handle);
+
     /**
      * \return true if serial device is open
      */
@@ -89,7 +164,9 @@ public:
     bool errorStatus() const;
 
     /**
-     * Close the serial device
+     * Close the serial device. When an event loop is used, waits for the
+     * handlers of the device still queued in the loop, so it must not be
+     * called from the read callback or a coroutine of the device.
      * \throws boost::system::system_error if any error
      */
     void close();
@@ -98,8 +175,9 @@ public:
      * Write data asynchronously. Returns immediately.
      * \param data array of char to be sent through the serial device
      * \param size array size
+     * \return false if the data was dropped because of the write queue limit
      */
-    void write(const char *data, size_t size);
+    bool write(const char *data, size_t size);
 
      /**
      * Write data asynchronously. Returns immediately.
@@ -115,6 +193,167 @@ public:
     */
     void writeString(const std::string& s);
 
+    /**
+     * Write a state command asynchronously, when only its newest value
+     * matters. If a previous state command with the same first byte and size
+     * is still waiting in the queue, it is overwritten in place instead of
+     * queuing another one, so a slow device gets the newest state without
+     * falling behind. Returns immediately.
+     * \param data array of char to be sent through the serial device
+     * \param size array size
+     * \return false if the data was dropped because of the write queue limit
+     */
+    bool writeLatest(const char *data, size_t size);
+
+    /**
+     * Limit the number of bytes that can wait in the write queue, not
+     * counting those being written. Writes that would exceed the limit are
+     * dropped, and counted in the statistics.
+     * \param bytes maximum number of queued bytes, 0 for no limit (default)
+     */
+    void setWriteQueueLimit(size_t bytes);
+
+    /**
+     * Statistics of the write queue
+     */
+    struct WriteQueueStats
+    {
+        size_t queued; ///< Bytes waiting in the queue now
+        size_t highWatermark; ///< Most bytes ever waiting in the queue
+        unsigned long long droppedWrites; ///< Writes dropped by the limit
+        unsigned long long droppedBytes; ///< Bytes dropped by the limit
+        unsigned long long coalescedWrites; ///< Writes that replaced another
+    };
+
+    /**
+     * \return statistics of the write queue
+     */
+    WriteQueueStats writeQueueStats() const;
+
+    /**
+     * Set a function that is called once from the background thread, before
+     * it starts servicing the serial device. Useful to set up scheduling
+     * priority or CPU affinity of that thread. Must be called before open().
+     * Not used with an event loop, whose threads have their own initializer.
+     * \param initializer function to call, or an empty function for none
+     */
+    void setThreadInitializer(const boost::function<void ()>& initializer);
+
+    /**
+     * Set a function that is called with the bytes of each write operation
+     * when they are handed to the device, for example to log the traffic.
+     * Bytes dropped by the write queue limit, or overwritten in the queue by
+     * writeLatest(), are never passed. The function is called with the write
+     * queue locked, from the background thread or from the thread that
+     * writes, so it must be short and must not write to the device.
+     * \param callback function to call, or an empty function for none
+     */
+    void setWriteCallback(const
+            boost::function<void (const char*, size_t)>& callback);
+
+    /**
+     * Options of the serial device that affect the latency of short
+     * request/reply exchanges, applied by open(). The defaults suit commands
+     * of a few bytes, each answered at once. Ignored on Windows, where the
+     * latency timer of USB adapters is a setting of the driver.
+     */
+    struct LatencyOptions
+    {
+        LatencyOptions();
+
+        /// VMIN, bytes a blocking read waits for (default 1). Only the Mac
+        /// OS X implementation reads blocking, asio reads return at once
+        unsigned char minBytes;
+        /// VTIME, gap in tenths of a second that ends a blocking read once
+        /// some bytes arrived (default 0, no gap)
+        unsigned char interByteTimeout;
+        /// Set ASYNC_LOW_LATENCY, so that USB adapters pass received bytes
+        /// on at once instead of waiting for their latency timer, 16ms on
+        /// most FTDI chips. Linux only, drivers that don't support the flag
+        /// ignore it (default true)
+        bool lowLatency;
+        /// Accept baud rates without a Bxxx constant, like 250000, setting
+        /// them through termios2 and BOTHER. Linux only (default true)
+        bool customBaudRate;
+    };
+
+    /**
+     * Set the latency options. Must be called before open().
+     * \param options latency options
+     */
+    void setLatencyOptions(const LatencyOptions& options);
+
+    /**
+     * \return true if the last open() could set ASYNC_LOW_LATENCY
+     */
+    bool lowLatencyActive() const;
+
+    /**
+     * Context of a coroutine started with spawn(). Passing it to one of the
+     * async*() member functions suspends the coroutine until the operation
+     * completes. Use yield[ec] to get errors as an error code instead of an
+     * exception.
+     */
+    typedef boost::asio::yield_context Yield;
+
+    /**
+     * Start a coroutine on the io_service that services the serial device,
+     * so that protocol logic can be written sequentially. The coroutine runs
+     * in the background thread, like the read callback, and must not let
+     * exceptions escape. Not available on Mac OS X.
+     * \param coroutine function to run as a coroutine
+     * \throws boost::system::system_error if the device is not open
+     */
+    void spawn(const boost::function<void (Yield)>& coroutine);
+
+    /**
+     * Read exactly size bytes from a coroutine. Bytes read this way do not
+     * reach the read callback, bytes received while no coroutine read is in
+     * progress do. At most one coroutine read can be in progress at a time.
+     * \param data buffer that receives the data
+     * \param size number of bytes to read
+     * \param timeout maximum time to wait, boost::posix_time::pos_infin to
+     * wait forever
+     * \param yield context of the calling coroutine
+     * \return number of bytes read
+     * \throws boost::system::system_error with asio::error::timed_out if the
+     * data does not arrive in time, or asio::error::operation_aborted if the
+     * device is closed meanwhile
+     */
+    size_t asyncReadExact(char *data, size_t size,
+            const boost::posix_time::time_duration& timeout, Yield yield);
+
+    /**
+     * Write data from a coroutine. The data goes through the same queue as
+     * write(), and the coroutine resumes once it has been sent. At most one
+     * coroutine write can be in progress at a time.
+     * \param data array of char to be sent through the serial device
+     * \param size array size
+     * \param yield context of the calling coroutine
+     * \return number of bytes written
+     * \throws boost::system::system_error if the write fails or the device
+     * is closed meanwhile
+     */
+    size_t asyncWrite(const char *data, size_t size, Yield yield);
+
+    /**
+     * Send a command and read a reply of known length from a coroutine. The
+     * reply buffer is registered before the command is sent, so even the
+     * fastest reply can't reach the read callback instead.
+     * \param command command to send
+     * \param commandSize command size
+     * \param reply buffer that receives the reply
+     * \param replySize expected reply length
+     * \param timeout maximum time to wait for the reply
+     * \param yield context of the calling coroutine
+     * \return number of reply bytes read
+     * \throws boost::system::system_error as asyncReadExact() and
+     * asyncWrite()
+     */
+    size_t asyncTransact(const char *command, size_t commandSize, char *reply,
+            size_t replySize, const boost::posix_time::time_duration& timeout,
+            Yield yield);
+
     virtual ~AsyncSerial()=0;
 
     /**
@@ -123,6 +362,41 @@ public:
     static const int readBufferSize=512;
 private:
 
+    /**
+     * Start servicing the device once its descriptor is open and set up.
+     */
+    void startService();
+
+    /**
+     * Register the buffer of a coroutine read, and start its timeout.
+     * This function is called by the io_service in the spawned thread.
+     */
+    void beginCoRead(char *data, size_t size,
+            const boost::posix_time::time_duration& timeout);
+
+    /**
+     * Suspend the calling coroutine until the registered read completes.
+     */
+    size_t waitCoRead(Yield yield);
+
+    /**
+     * Callback called when the timeout of a coroutine read expires.
+     * This callback is called by the io_service in the spawned thread.
+     */
+    void coReadTimeout(const boost::system::error_code& error,
+            unsigned int generation);
+
+    /**
+     * End the coroutine read in progress, and resume the coroutine waiting
+     * for it, if any.
+     */
+    void completeCoRead(const boost::system::error_code& error);
+
+    /**
+     * Resume the coroutine waiting for its write to complete.
+     */
+    void completeCoWrite(const boost::system::error_code& error);
+
     /**
      * Callback called to start an asynchronous read operation.
      * This callback is called by the io_service in the spawned thread.
@@ -190,6 +464,13 @@ class CallbackAsyncSerial: public AsyncSerial
 public:
     CallbackAsyncSerial();
 
+    /**
+     * Constructor. The serial device, once opened, is serviced by the threads
+     * of a shared event loop, and the callback is called from one of them.
+     * \param loop event loop, must outlive the object
+     */
+    explicit CallbackAsyncSerial(SerialEventLoop& loop);
+
     /**
     * Opens a serial device.
     * \param devname serial device name, example "/dev/ttyS0" or "COM1"
@@ -229,7 +510,114 @@ public:
      */
     void clearCallback();
 
+    /**
+     * A command and the buffer for its reply, used by the batched transact().
+     * All memory is owned by the caller, so a transaction does not allocate.
+     */
+    struct Transaction
+    {
+        const char *command; ///< Command to send
+        size_t commandSize; ///< Command size
+        char *reply; ///< Buffer that receives the reply
+        size_t replySize; ///< Expected reply length
+        size_t received; ///< Reply bytes received, filled in by transact()
+    };
+
+    /**
+     * Send a command and wait for a reply of known length. The reply bytes
+     * are copied directly into the caller's buffer from the thread that reads
+     * the serial port, and do not reach the read callback. Bytes received
+     * while no transaction is pending are passed to the callback as usual.
+     * Only one transaction can be in progress at a time, concurrent callers
+     * are serialized.
+     * \param command command to send
+     * \param commandSize command size
+     * \param reply buffer that receives the reply
+     * \param replySize expected reply length
+     * \param timeout maximum time to wait for the whole reply
+     * \throws boost::system::system_error with boost::asio::error::timed_out
+     * if the reply does not arrive in time, boost::asio::error::not_connected
+     * if the serial device is not open, or boost::asio::error::no_buffer_space
+     * if the write queue limit dropped the command
+     */
+    void transact(const char *command, size_t commandSize, char *reply,
+            size_t replySize, const boost::posix_time::time_duration& timeout);
+
+    /**
+     * Send a batch of commands at once and collect their replies in order.
+     * All commands are queued before waiting, so they go out back to back.
+     * \param transactions array of transactions, the received field is
+     * updated also when the timeout expires, to tell which replies arrived
+     * \param count number of transactions
+     * \param timeout maximum time to wait for all the replies
+     * \throws boost::system::system_error with boost::asio::error::timed_out
+     * if not all the replies arrive in time,
+     * boost::asio::error::not_connected if the serial device is not open, or
+     * boost::asio::error::no_buffer_space if the write queue limit dropped a
+     * command
+     */
+    void transact(Transaction *transactions, size_t count,
+            const boost::posix_time::time_duration& timeout);
+
+    /**
+     * Make the thread that reads the serial device store the received data
+     * in a lock-free single producer, single consumer ring instead of calling
+     * the callback, so that reception never waits for the processing of the
+     * data. The data is then retrieved with pull(). Transactions still get
+     * their replies directly. Must be called while the device is closed.
+     * \param size ring size in bytes, 0 to use the callback again
+     */
+    void setReceiveRing(size_t size);
+
+    /**
+     * Take received data out of the ring, without waiting. Only one thread
+     * at a time may call this function.
+     * \param data buffer that receives the data
+     * \param size buffer size
+     * \return number of bytes copied into data, 0 if the ring is empty or
+     * not enabled
+     */
+    size_t pull(char *data, size_t size);
+
+    /**
+     * \return number of reads that did not fit entirely in the ring
+     */
+    unsigned long long receiveOverflows() const;
+
+    /**
+     * \return number of received bytes lost because the ring was full
+     */
+    unsigned long long receiveOverflowBytes() const;
+
     virtual ~CallbackAsyncSerial();
+
+private:
+
+    /**
+     * Read callback registered in AsyncSerial. Fills the pending transactions
+     * first, then passes the remaining data to the user callback.
+     * This callback is called by the io_service in the spawned thread.
+     */
+    void readDispatch(const char *data, size_t size);
+
+    /**
+     * Removes the transactions whose reply is complete from the pending ones,
+     * and wakes up transact() when none is left. Call with pendingMutex locked.
+     */
+    void popCompleted();
+
+    /// Read callback set by the user
+    boost::function<void (const char*, size_t)> userCallback;
+    boost::mutex transactMutex; ///< Serializes callers of transact()
+    boost::mutex pendingMutex; ///< Mutex for access to pending transactions
+    boost::condition_variable pendingDone; ///< Signaled when all replies arrived
+    Transaction *pending; ///< First transaction still waiting for its reply
+    size_t pendingCount; ///< Number of transactions waiting for their reply
+
+    /// Ring for the received data, if enabled
+    boost::scoped_ptr<boost::lockfree::spsc_queue<char> > ring;
+    boost::atomic<unsigned long long> overflows; ///< Reads not fitting the ring
+    boost::atomic<unsigned long long> overflowBytes; ///< Bytes lost
 };
 
 #endif //ASYNCSERIAL_H